@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <QTest>
+
+#include "KisSlidingHistogramBenchmark.h"
+#include "kis_benchmark_values.h"
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_sequential_iterator.h>
+#include <KisSlidingHistogram.h>
+
+
+void KisSlidingHistogramBenchmark::initTestCase()
+{
+    m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    m_device = new KisPaintDevice(m_colorSpace);
+
+    KoColor color(m_colorSpace);
+    srand(31524744);
+
+    KisSequentialIterator it(m_device, QRect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT));
+    while (it.nextPixel()) {
+        color.fromQColor(QColor(rand() % 255, rand() % 255, rand() % 255));
+        memcpy(it.rawData(), color.data(), m_colorSpace->pixelSize());
+    }
+}
+
+void KisSlidingHistogramBenchmark::benchmarkMedian_data()
+{
+    QTest::addColumn<int>("radius");
+
+    QTest::newRow("r5") << 5;
+    QTest::newRow("r10") << 10;
+    QTest::newRow("r20") << 20;
+    QTest::newRow("r50") << 50;
+}
+
+void KisSlidingHistogramBenchmark::benchmarkMedian()
+{
+    QFETCH(int, radius);
+
+    const QRect rect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+    const KoColorSpace *cs = m_colorSpace;
+    KisPaintDeviceSP dst = new KisPaintDevice(cs);
+
+    QBENCHMARK {
+        KisSlidingHistogram::apply(m_device, dst, rect, rect, radius, 256, false,
+            [cs] (const quint8 *pixel) {
+                return cs->intensity8(pixel);
+            },
+            [cs] (const KisSlidingHistogram::Window &window, const quint8 *srcPixel, quint8 *dstPixel) {
+                memcpy(dstPixel, srcPixel, cs->pixelSize());
+                cs->setOpacity(dstPixel, quint8(window.percentileBin(0.5)), 1);
+            });
+    }
+}
+
+void KisSlidingHistogramBenchmark::benchmarkMostFrequentColor_data()
+{
+    benchmarkMedian_data();
+}
+
+void KisSlidingHistogramBenchmark::benchmarkMostFrequentColor()
+{
+    QFETCH(int, radius);
+
+    const QRect rect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+    const KoColorSpace *cs = m_colorSpace;
+    KisPaintDeviceSP dst = new KisPaintDevice(cs);
+
+    // the same settings as the default ones of the oil paint filter
+    const int numBins = 31;
+    const double scale = 30 / 255.0;
+
+    QBENCHMARK {
+        KisSlidingHistogram::apply(m_device, dst, rect, rect, radius, numBins, true,
+            [cs, scale] (const quint8 *pixel) {
+                return int(cs->intensity8(pixel) * scale);
+            },
+            [cs] (const KisSlidingHistogram::Window &window, const quint8 *, quint8 *dstPixel) {
+                const int bin = window.modeBin();
+                const double *sums = window.channelSums(bin);
+
+                QVector<float> channels(cs->channelCount());
+                for (int i = 0; i < channels.size(); i++) {
+                    channels[i] = sums[i] / window.count(bin);
+                }
+                cs->fromNormalisedChannelsValue(dstPixel, channels);
+            });
+    }
+}
+
+QTEST_MAIN(KisSlidingHistogramBenchmark)
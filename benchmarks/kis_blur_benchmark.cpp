@@ -37,6 +37,18 @@
 #include "kis_selection.h"
 #include <kis_iterator_ng.h>
 
+#include <kis_convolution_painter.h>
+#include <kis_convolution_kernel.h>
+#include <kis_gaussian_kernel.h>
+#include <KisRecursiveGaussianBlur.h>
+
+/**
+ * The radius of the blur used for comparing the engines. It is large
+ * enough for KisGaussianKernel::applyGaussian() to choose the
+ * recursive engine.
+ */
+const qreal GAUSSIAN_RADIUS = 30.0;
+
 void KisBlurBenchmark::initTestCase()
 {
     m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();    
@@ -88,5 +100,56 @@ void KisBlurBenchmark::benchmarkFilter()
 }
 
 
+void KisBlurBenchmark::benchmarkGaussianConvolution(bool useFftw)
+{
+    const QRect rect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+    const QBitArray channelFlags = m_colorSpace->channelFlags(true, true);
+
+    KisConvolutionKernelSP kernelHoriz = KisGaussianKernel::createHorizontalKernel(GAUSSIAN_RADIUS);
+    KisConvolutionKernelSP kernelVertical = KisGaussianKernel::createVerticalKernel(GAUSSIAN_RADIUS);
+    const int verticalMargin = kernelVertical->height() / 2;
+
+    KisConvolutionPainter::TestingEnginePreference enginePreference =
+        useFftw ?
+        KisConvolutionPainter::FFTW :
+        KisConvolutionPainter::SPATIAL;
+
+    QBENCHMARK{
+        KisPaintDeviceSP interm = new KisPaintDevice(m_colorSpace);
+
+        KisConvolutionPainter horizPainter(interm, enginePreference);
+        horizPainter.setChannelFlags(channelFlags);
+        horizPainter.applyMatrix(kernelHoriz, m_device,
+                                 rect.topLeft() - QPoint(0, verticalMargin),
+                                 rect.topLeft() - QPoint(0, verticalMargin),
+                                 rect.size() + QSize(0, 2 * verticalMargin), BORDER_REPEAT);
+
+        KisConvolutionPainter verticalPainter(m_device, enginePreference);
+        verticalPainter.setChannelFlags(channelFlags);
+        verticalPainter.applyMatrix(kernelVertical, interm, rect.topLeft(), rect.topLeft(), rect.size(), BORDER_REPEAT);
+    }
+}
+
+void KisBlurBenchmark::benchmarkGaussianSpatial()
+{
+    benchmarkGaussianConvolution(false);
+}
+
+void KisBlurBenchmark::benchmarkGaussianFFTW()
+{
+    benchmarkGaussianConvolution(true);
+}
+
+void KisBlurBenchmark::benchmarkGaussianRecursive()
+{
+    const QRect rect(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+    const QBitArray channelFlags = m_colorSpace->channelFlags(true, true);
+
+    QBENCHMARK{
+        KisRecursiveGaussianBlur::applyGaussian(m_device, rect,
+                                                GAUSSIAN_RADIUS, GAUSSIAN_RADIUS,
+                                                channelFlags, 0);
+    }
+}
 
 QTEST_MAIN(KisBlurBenchmark)
@@ -39,7 +39,13 @@ private Q_SLOTS:
     void cleanupTestCase();
     
     void benchmarkFilter();
-    
+
+    void benchmarkGaussianSpatial();
+    void benchmarkGaussianFFTW();
+    void benchmarkGaussianRecursive();
+
+private:
+    void benchmarkGaussianConvolution(bool useFftw);
 };
 
 #endif
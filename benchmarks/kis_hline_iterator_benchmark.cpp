@@ -27,7 +27,51 @@
 
 #include <QTest>
 
+#include <KoInvertColorTransformation.h>
+#include <KoDesaturateKernel.h>
+
 #include "kis_iterator_ng.h"
+#include "kis_sequential_iterator.h"
+#include "KisTileKernel.h"
+
+namespace {
+
+void transformSpans(KisPaintDeviceSP dev, const QRect &rc, const KoColorTransformation *transformation)
+{
+    KisSequentialIterator it(dev, rc);
+
+    int conseq = it.nConseqPixels();
+    while (it.nextPixels(conseq)) {
+        conseq = it.nConseqPixels();
+        transformation->transform(it.oldRawData(), it.rawData(), conseq);
+    }
+}
+
+template <class Traits>
+struct InvertSpan
+{
+    typedef typename Traits::channels_type channels_type;
+
+    void operator() (const channels_type *src, channels_type *dst, int numPixels) const {
+        KoInvertColorTransformationTraits<Traits>::invertPixels(src, dst, numPixels);
+    }
+};
+
+template <class Traits>
+struct DesaturateSpan
+{
+    typedef typename Traits::channels_type channels_type;
+
+    DesaturateSpan(int type) : m_type(type) {}
+
+    void operator() (const channels_type *src, channels_type *dst, int numPixels) const {
+        KoDesaturateKernel<Traits>::desaturatePixels(m_type, src, dst, numPixels);
+    }
+
+    int m_type;
+};
+
+}
 
 void KisHLineIteratorBenchmark::initTestCase()
 {
@@ -190,5 +234,111 @@ void KisHLineIteratorBenchmark::benchmarkTwoIteratorsNoMemCpy(){
 }
 
 
+void KisHLineIteratorBenchmark::benchmarkInvertPerPixel()
+{
+    const QRect rc(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+    const int pixelSize = m_colorSpace->pixelSize();
+
+    KisPaintDeviceSP dev = new KisPaintDevice(m_colorSpace);
+    dev->fill(rc, *m_color);
+
+    QBENCHMARK{
+        KisSequentialIterator it(dev, rc);
+        while (it.nextPixel()) {
+            quint8 *data = it.rawData();
+            for (int i = 0; i < pixelSize; i++) {
+                data[i] = 255 - data[i];
+            }
+        }
+    }
+}
+
+void KisHLineIteratorBenchmark::benchmarkInvertTileKernel()
+{
+    const QRect rc(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(m_colorSpace);
+    dev->fill(rc, *m_color);
+
+    QBENCHMARK{
+        KisTileKernel::processSpans<KoBgrU8Traits>(dev, rc,
+            [] (const quint8 *, quint8 *dst, int numPixels) {
+                for (int i = 0; i < numPixels * 4; i++) {
+                    dst[i] = 255 - dst[i];
+                }
+            });
+    }
+}
+void KisHLineIteratorBenchmark::benchmarkInvertGenericTransformation()
+{
+    const QRect rc(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(m_colorSpace);
+    dev->fill(rc, *m_color);
+
+    QScopedPointer<KoColorTransformation> transformation(KoInvertColorTransformation::getTransformator(m_colorSpace));
+
+    QBENCHMARK{
+        transformSpans(dev, rc, transformation.data());
+    }
+}
+
+void KisHLineIteratorBenchmark::benchmarkInvertTransformation()
+{
+    const QRect rc(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(m_colorSpace);
+    dev->fill(rc, *m_color);
+
+    QScopedPointer<KoColorTransformation> transformation(m_colorSpace->createInvertTransformation());
+
+    QBENCHMARK{
+        transformSpans(dev, rc, transformation.data());
+    }
+}
+
+void KisHLineIteratorBenchmark::benchmarkInvertRgbaSpans()
+{
+    const QRect rc(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(m_colorSpace);
+    dev->fill(rc, *m_color);
+
+    QBENCHMARK{
+        KisTileKernel::processRgbaSpans<InvertSpan>(dev, rc, 0);
+    }
+}
+
+void KisHLineIteratorBenchmark::benchmarkDesaturateTransformation()
+{
+    const QRect rc(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(m_colorSpace);
+    dev->fill(rc, *m_color);
+
+    QHash<QString, QVariant> params;
+    params["type"] = 1;
+
+    QScopedPointer<KoColorTransformation> transformation(m_colorSpace->createColorTransformation("desaturate_adjustment", params));
+    if (!transformation) {
+        QSKIP("the desaturate adjustment is not available");
+    }
+
+    QBENCHMARK{
+        transformSpans(dev, rc, transformation.data());
+    }
+}
+
+void KisHLineIteratorBenchmark::benchmarkDesaturateRgbaSpans()
+{
+    const QRect rc(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(m_colorSpace);
+    dev->fill(rc, *m_color);
+
+    QBENCHMARK{
+        KisTileKernel::processRgbaSpans<DesaturateSpan>(dev, rc, 0, 1);
+    }
+}
 
 QTEST_MAIN(KisHLineIteratorBenchmark)
@@ -56,6 +56,19 @@ private Q_SLOTS:
     void benchmarkConstNoMemCpy();
     // copy from one device to another
     void benchmarkTwoIteratorsNoMemCpy();
+
+    // invert the device pixel by pixel and span by span
+    void benchmarkInvertPerPixel();
+    void benchmarkInvertTileKernel();
+
+    // the invert and desaturate filters: through their color
+    // transformations, as KisColorTransformationFilter does it, and
+    // through the RGBA span kernels they use now
+    void benchmarkInvertGenericTransformation();
+    void benchmarkInvertTransformation();
+    void benchmarkInvertRgbaSpans();
+    void benchmarkDesaturateTransformation();
+    void benchmarkDesaturateRgbaSpans();
     
 
     
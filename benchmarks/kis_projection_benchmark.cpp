@@ -21,12 +21,16 @@
 #include "kis_benchmark_values.h"
 
 #include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
 
 #include <kis_group_layer.h>
 #include <kis_paint_device.h>
 #include <KisDocument.h>
 #include <kis_image.h>
+#include <kis_paint_layer.h>
 #include <KisPart.h>
+#include <kis_undo_stores.h>
 
 void KisProjectionBenchmark::initTestCase()
 {
@@ -58,5 +62,58 @@ void KisProjectionBenchmark::benchmarkLoading()
     }
 }
 
+/**
+ * Builds a float32 image whose layers are stored in \p layerDepth and
+ * reports the memory taken by the layers together with the time needed
+ * to recomposite the whole projection.
+ */
+static void benchmarkLayerStorage(const KoID &layerDepth)
+{
+    const int numLayers = 8;
+    const QRect rc(0, 0, 4000, 3000);
+
+    const KoColorSpace *imageCs =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Float32BitsColorDepthID.id(), 0);
+    const KoColorSpace *layerCs =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), layerDepth.id(), 0);
+
+    if (!layerCs) {
+        QSKIP("The requested layer color space is not available");
+    }
+
+    KisImageSP image = new KisImage(new KisSurrogateUndoStore(), rc.width(), rc.height(), imageCs, "benchmark");
+
+    qint64 layerBytes = 0;
+
+    for (int i = 0; i < numLayers; i++) {
+        KisPaintLayerSP layer = new KisPaintLayer(image, image->nextLayerName(), OPACITY_OPAQUE_U8, layerCs);
+
+        QColor color;
+        color.setHsv(i * 360 / numLayers, 200, 220, 160);
+        layer->paintDevice()->fill(rc.adjusted(i * 50, i * 50, 0, 0), KoColor(color, layerCs));
+
+        const QRect extent = layer->paintDevice()->extent();
+        layerBytes += qint64(extent.width()) * extent.height() * layerCs->pixelSize();
+
+        image->addNode(layer, image->root());
+    }
+
+    qDebug() << "Layers:" << numLayers << layerCs->id()
+             << "layer memory (MiB):" << layerBytes / (1024 * 1024);
+
+    QBENCHMARK {
+        image->refreshGraph();
+    }
+}
+
+void KisProjectionBenchmark::benchmarkFloat32LayerProjection()
+{
+    benchmarkLayerStorage(Float32BitsColorDepthID);
+}
+
+void KisProjectionBenchmark::benchmarkHalfFloatLayerProjection()
+{
+    benchmarkLayerStorage(Float16BitsColorDepthID);
+}
 
 QTEST_MAIN(KisProjectionBenchmark)
@@ -32,6 +32,9 @@ private Q_SLOTS:
 
     void benchmarkProjection();
     void benchmarkLoading();
+
+    void benchmarkFloat32LayerProjection();
+    void benchmarkHalfFloatLayerProjection();
 };
 
 #endif
@@ -43,11 +43,17 @@ inline double drand48()
 
 #include <brushengine/kis_paint_information.h>
 #include <brushengine/kis_paintop_preset.h>
+#include <brushengine/kis_paintop_settings.h>
 
 #define GMP_IMAGE_WIDTH 3274
 #define GMP_IMAGE_HEIGHT 2067
 #include <kis_painter.h>
+#include <brushengine/kis_paintop.h>
 #include <brushengine/kis_paintop_registry.h>
+#include <KisRunnableStrokeJobData.h>
+#include <KisFakeRunnableStrokeJobsExecutor.h>
+
+#include <tuple>
 
 //#define SAVE_OUTPUT
 
@@ -327,6 +333,58 @@ void KisStrokeBenchmark::colorsmudgeRL()
     benchmarkStroke(presetFileName);
 }
 
+void KisStrokeBenchmark::colorsmudge500px()
+{
+    QString presetFileName = "colorsmudge.kpp";
+    benchmarkStroke(presetFileName, 500.0);
+}
+
+void KisStrokeBenchmark::sketch10kPoints()
+{
+    QString presetFileName = "sketchbrush.kpp";
+    KisPaintOpPresetSP preset = new KisPaintOpPreset(m_dataPath + presetFileName);
+    bool loadedOk = preset->load();
+    KIS_ASSERT_RECOVER_RETURN(loadedOk);
+
+    const int numPoints = 10000;
+
+    // a long scribble going back and forth over the same area
+    QVector<QPointF> points;
+    for (int i = 0; i < numPoints; i++) {
+        const qreal t = qreal(i) / numPoints;
+        points.append(QPointF((0.5 + 0.4 * sin(t * 2 * M_PI * 7)) * TEST_IMAGE_WIDTH,
+                              (0.1 + 0.8 * t + 0.05 * cos(t * 2 * M_PI * 53)) * TEST_IMAGE_HEIGHT));
+    }
+
+    QBENCHMARK{
+        // recreate the paintop to drop the point history of the previous run
+        m_painter->setPaintOpPreset(preset, m_layer, m_image);
+
+        KisDistanceInformation currentDistance;
+        for (int i = 1; i < numPoints; i++) {
+            KisPaintInformation pi1(points[i - 1], 1.0);
+            KisPaintInformation pi2(points[i], 1.0);
+            m_painter->paintLine(pi1, pi2, &currentDistance);
+        }
+    }
+
+#ifdef SAVE_OUTPUT
+    m_layer->paintDevice()->convertToQImage(0).save(m_outputPath + presetFileName + "_10k" + OUTPUT_FORMAT);
+#endif
+}
+
+void KisStrokeBenchmark::tangentNormal()
+{
+    QString presetFileName = "tangentnormal.kpp";
+    benchmarkStroke(presetFileName);
+}
+
+void KisStrokeBenchmark::tangentNormalRL()
+{
+    QString presetFileName = "tangentnormal.kpp";
+    benchmarkRandomLines(presetFileName);
+}
+
 /*
 void KisStrokeBenchmark::predefinedBrush()
 {
@@ -455,6 +513,7 @@ void KisStrokeBenchmark::benchmarkRandomLines(QString presetFileName)
             KisPaintInformation pi2(m_endPoints[i], 1.0);
             m_painter->paintLine(pi1, pi2, &currentDistance);
         }
+        flushAsyncronousUpdates();
     }
 
 #ifdef SAVE_OUTPUT
@@ -462,7 +521,7 @@ void KisStrokeBenchmark::benchmarkRandomLines(QString presetFileName)
 #endif
 }
 
-void KisStrokeBenchmark::benchmarkStroke(QString presetFileName)
+void KisStrokeBenchmark::benchmarkStroke(QString presetFileName, qreal paintOpSize)
 {
     KisPaintOpPresetSP preset = new KisPaintOpPreset(m_dataPath + presetFileName);
     bool loadedOk = preset->load();
@@ -473,12 +532,17 @@ void KisStrokeBenchmark::benchmarkStroke(QString presetFileName)
         dbgKrita << "preset : " << presetFileName;
     }
 
+    if (paintOpSize > 0) {
+        preset->settings()->setPaintOpSize(paintOpSize);
+    }
+
     m_painter->setPaintOpPreset(preset, m_layer, m_image);
 
     QBENCHMARK{
         KisDistanceInformation currentDistance;
         m_painter->paintBezierCurve(m_pi1, m_c1, m_c1, m_pi2, &currentDistance);
         m_painter->paintBezierCurve(m_pi2, m_c2, m_c2, m_pi3, &currentDistance);
+        flushAsyncronousUpdates();
     }
 
 #ifdef SAVE_OUTPUT
@@ -487,6 +551,24 @@ void KisStrokeBenchmark::benchmarkStroke(QString presetFileName)
 #endif
 }
 
+/**
+ * The paintops using KisDabRenderingExecutor only queue their dabs in
+ * paintAt(), blit them onto the device synchronously to make their
+ * timings comparable with the other paintops
+ */
+inline void KisStrokeBenchmark::flushAsyncronousUpdates()
+{
+    KisFakeRunnableStrokeJobsExecutor executor;
+    bool needsMoreUpdates = true;
+
+    while (needsMoreUpdates) {
+        QVector<KisRunnableStrokeJobData*> jobs;
+        std::tie(std::ignore, needsMoreUpdates) =
+            m_painter->paintOp()->doAsyncronousUpdate(jobs);
+        executor.addRunnableJobs(jobs);
+    }
+}
+
 static const int COUNT = 1000000;
 void KisStrokeBenchmark::benchmarkRand48()
 {
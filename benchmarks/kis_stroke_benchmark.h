@@ -59,9 +59,10 @@ private:
 
     private:
         inline void benchmarkRandomLines(QString presetFileName);
-        inline void benchmarkStroke(QString presetFileName);
+        inline void benchmarkStroke(QString presetFileName, qreal paintOpSize = -1.0);
         inline void benchmarkLine(QString presetFileName);
         inline void benchmarkCircle(QString presetFileName);
+        inline void flushAsyncronousUpdates();
 
 private Q_SLOTS:
     void initTestCase();
@@ -120,6 +121,12 @@ private Q_SLOTS:
 
     void colorsmudge();
     void colorsmudgeRL();
+    void colorsmudge500px();
+
+    void sketch10kPoints();
+
+    void tangentNormal();
+    void tangentNormalRL();
 /*
     void predefinedBrush();
     void predefinedBrushRL();
@@ -0,0 +1,263 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisQImagePyramidCache.h"
+
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QCryptographicHash>
+#include <QtConcurrent>
+#include <QFuture>
+
+#include "kis_qimage_pyramid.h"
+
+Q_GLOBAL_STATIC(KisQImagePyramidCache, s_instance)
+
+namespace {
+const qint64 defaultMemoryLimit = 256 * 1024 * 1024;
+
+/**
+ * The tip image of the same resource depends on the coloring mode of the
+ * brush (e.g. "Use color as mask" for gbr brushes), and the md5 of the
+ * resource is not unique for the brushes loaded from abr collections, so
+ * the key is the md5 of the tip image itself. Hashing is much cheaper
+ * than the smooth scaling done for the pyramid levels.
+ */
+QByteArray cacheKey(const QImage &tip)
+{
+    if (tip.isNull()) return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+
+    // don't hash the padding at the end of the scanlines
+    const int lineSize = (tip.width() * tip.depth() + 7) / 8;
+
+    for (int y = 0; y < tip.height(); y++) {
+        hash.addData(reinterpret_cast<const char*>(tip.constScanLine(y)), lineSize);
+    }
+
+    Q_FOREACH (QRgb rgb, tip.colorTable()) {
+        hash.addData(reinterpret_cast<const char*>(&rgb), sizeof(rgb));
+    }
+
+    return hash.result().toHex() + ':' +
+        QByteArray::number(int(tip.format())) + ':' +
+        QByteArray::number(tip.width()) + 'x' + QByteArray::number(tip.height());
+}
+}
+
+struct KisQImagePyramidCache::Private
+{
+    struct Entry {
+        QSharedPointer<const KisQImagePyramid> pyramid;
+        qint64 memoryUsage = 0;
+        quint64 lastUsed = 0;
+    };
+
+    QMutex mutex;
+    QWaitCondition buildFinished;
+
+    QHash<QByteArray, Entry> entries;
+    QSet<QByteArray> pendingKeys;
+
+    /**
+     * QImage::cacheKey() of the already hashed tips. The brushes cloned
+     * from the same resource share their tip image, so the tip doesn't
+     * need to be hashed again every time the brush is loaded.
+     */
+    QHash<qint64, QByteArray> imageKeys;
+
+    QList<QFuture<void>> prebuildJobs;
+
+    qint64 memoryLimit = defaultMemoryLimit;
+    qint64 totalMemoryUsage = 0;
+    quint64 usageCounter = 0;
+
+    QSharedPointer<const KisQImagePyramid> fetchOrBuild(const QByteArray &key, const QImage &tip);
+    QByteArray knownKey(const QImage &tip);
+    void evictUnusedEntries();
+};
+
+QByteArray KisQImagePyramidCache::Private::knownKey(const QImage &tip)
+{
+    QMutexLocker l(&mutex);
+    return imageKeys.value(tip.cacheKey());
+}
+
+QSharedPointer<const KisQImagePyramid>
+KisQImagePyramidCache::Private::fetchOrBuild(const QByteArray &key, const QImage &tip)
+{
+    QMutexLocker l(&mutex);
+
+    // wait if some other thread is already building the same pyramid
+    while (pendingKeys.contains(key)) {
+        buildFinished.wait(&mutex);
+    }
+
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->lastUsed = ++usageCounter;
+        imageKeys.insert(tip.cacheKey(), key);
+        return it->pyramid;
+    }
+
+    pendingKeys.insert(key);
+    imageKeys.insert(tip.cacheKey(), key);
+    l.unlock();
+
+    QSharedPointer<const KisQImagePyramid> pyramid(new KisQImagePyramid(tip));
+
+    l.relock();
+
+    Entry entry;
+    entry.pyramid = pyramid;
+    entry.memoryUsage = pyramid->memoryUsage();
+    entry.lastUsed = ++usageCounter;
+
+    entries.insert(key, entry);
+    totalMemoryUsage += entry.memoryUsage;
+    pendingKeys.remove(key);
+
+    evictUnusedEntries();
+    buildFinished.wakeAll();
+
+    return pyramid;
+}
+
+void KisQImagePyramidCache::Private::evictUnusedEntries()
+{
+    // the pyramids are still owned by the brushes using them, so
+    // dropping them from the cache doesn't break anything
+    while (totalMemoryUsage > memoryLimit && entries.size() > 1) {
+        auto oldest = entries.begin();
+
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->lastUsed < oldest->lastUsed) {
+                oldest = it;
+            }
+        }
+
+        const QByteArray key = oldest.key();
+        totalMemoryUsage -= oldest->memoryUsage;
+        entries.erase(oldest);
+
+        for (auto it = imageKeys.begin(); it != imageKeys.end();) {
+            it = it.value() == key ? imageKeys.erase(it) : std::next(it);
+        }
+    }
+}
+
+
+KisQImagePyramidCache::KisQImagePyramidCache()
+    : m_d(new Private)
+{
+}
+
+KisQImagePyramidCache::~KisQImagePyramidCache()
+{
+    // the background jobs access the private data
+    QList<QFuture<void>> jobs;
+
+    {
+        QMutexLocker l(&m_d->mutex);
+        jobs = m_d->prebuildJobs;
+    }
+
+    Q_FOREACH (QFuture<void> job, jobs) {
+        job.waitForFinished();
+    }
+}
+
+KisQImagePyramidCache *KisQImagePyramidCache::instance()
+{
+    return s_instance;
+}
+
+QSharedPointer<const KisQImagePyramid> KisQImagePyramidCache::pyramid(const KisBrush *brush)
+{
+    const QImage tip = brush->brushTipImage();
+
+    QByteArray key = m_d->knownKey(tip);
+    if (key.isEmpty()) {
+        key = cacheKey(tip);
+    }
+
+    if (key.isEmpty()) {
+        return QSharedPointer<const KisQImagePyramid>(new KisQImagePyramid(tip));
+    }
+
+    return m_d->fetchOrBuild(key, tip);
+}
+
+void KisQImagePyramidCache::prebuildPyramid(KisBrushSP brush)
+{
+    if (!brush) return;
+
+    /**
+     * Fetch the image in the calling thread, the brush itself might be
+     * changed by the GUI while the pyramid is being built
+     */
+    const QImage tip = brush->brushTipImage();
+    if (tip.isNull()) return;
+
+    QMutexLocker l(&m_d->mutex);
+
+    const QByteArray key = m_d->imageKeys.value(tip.cacheKey());
+    if (!key.isEmpty() &&
+        (m_d->entries.contains(key) || m_d->pendingKeys.contains(key))) {
+
+        return;
+    }
+
+    for (auto it = m_d->prebuildJobs.begin(); it != m_d->prebuildJobs.end();) {
+        it = it->isFinished() ? m_d->prebuildJobs.erase(it) : std::next(it);
+    }
+
+    /**
+     * The cache waits for the job in its destructor, so the private
+     * data outlives the job
+     */
+    Private *d = m_d.data();
+    m_d->prebuildJobs << QtConcurrent::run([d, tip] () {
+        d->fetchOrBuild(cacheKey(tip), tip);
+    });
+}
+
+void KisQImagePyramidCache::setMemoryLimit(qint64 bytes)
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->memoryLimit = bytes;
+    m_d->evictUnusedEntries();
+}
+
+qint64 KisQImagePyramidCache::memoryLimit() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->memoryLimit;
+}
+
+void KisQImagePyramidCache::clear()
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->entries.clear();
+    m_d->imageKeys.clear();
+    m_d->totalMemoryUsage = 0;
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KISQIMAGEPYRAMIDCACHE_H
+#define KISQIMAGEPYRAMIDCACHE_H
+
+#include "kritabrush_export.h"
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "kis_brush.h"
+
+class KisQImagePyramid;
+
+/**
+ * A global cache of the brush pyramids, shared among all the brush
+ * instances, presets and strokes. Switching between the presets using
+ * the same predefined brush tip doesn't rebuild the pyramid anymore.
+ *
+ * The pyramids are keyed by the md5 of the brush tip image, which
+ * depends on both the brush resource and its coloring mode. The least
+ * recently used pyramids are dropped when the total size exceeds the
+ * memory limit.
+ *
+ * All the methods are thread-safe.
+ */
+class BRUSH_EXPORT KisQImagePyramidCache
+{
+public:
+    KisQImagePyramidCache();
+    ~KisQImagePyramidCache();
+
+    static KisQImagePyramidCache* instance();
+
+    /**
+     * Returns a pyramid for the tip of \p brush. The pyramid is created
+     * if it is not present in the cache yet.
+     */
+    QSharedPointer<const KisQImagePyramid> pyramid(const KisBrush *brush);
+
+    /**
+     * Starts building the pyramid for \p brush in a background thread,
+     * so that the first stroke with the brush doesn't have to wait for it
+     */
+    void prebuildPyramid(KisBrushSP brush);
+
+    void setMemoryLimit(qint64 bytes);
+    qint64 memoryLimit() const;
+
+    void clear();
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISQIMAGEPYRAMIDCACHE_H
@@ -21,6 +21,7 @@
 #include <QMutexLocker>
 
 #include "kis_qimage_pyramid.h"
+#include "KisQImagePyramidCache.h"
 #include "kis_brush.h"
 
 
@@ -42,7 +43,7 @@ const KisQImagePyramid *KisSharedQImagePyramid::pyramid(const KisBrush *brush) c
         QMutexLocker l(&m_mutex);
 
         if (!m_pyramid) {
-            m_pyramid.reset(new KisQImagePyramid(brush->brushTipImage()));
+            m_pyramid = KisQImagePyramidCache::instance()->pyramid(brush);
         }
 
         m_cachedPyramidPointer = m_pyramid.data();
@@ -318,6 +318,17 @@ QImage KisQImagePyramid::createImage(KisDabShape const& shape,
     return dstImage;
 }
 
+qint64 KisQImagePyramid::memoryUsage() const
+{
+    qint64 result = 0;
+
+    Q_FOREACH (const PyramidLevel &level, m_levels) {
+        result += level.image.byteCount();
+    }
+
+    return result;
+}
+
 QImage KisQImagePyramid::getClosest(QTransform transform, qreal *scale) const
 {
     if (m_levels.isEmpty()) return QImage();
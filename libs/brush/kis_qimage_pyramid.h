@@ -43,6 +43,9 @@ public:
 
     QImage getClosest(QTransform transform, qreal *scale) const;
 
+    /// the total size of all the levels in bytes
+    qint64 memoryUsage() const;
+
 private:
     friend class KisGbrBrushTest;
     int findNearestLevel(qreal scale, qreal *baseScale) const;
@@ -128,6 +128,7 @@ void KisGbrBrushTest::testImageGeneration()
 }
 
 #include "KisSharedQImagePyramid.h"
+#include "KisQImagePyramidCache.h"
 
 void KisGbrBrushTest::benchmarkPyramidCreation()
 {
@@ -136,11 +137,70 @@ void KisGbrBrushTest::benchmarkPyramidCreation()
     QVERIFY(!brush->brushTipImage().isNull());
 
     QBENCHMARK {
+        // measure the creation, not the lookup in the global cache
+        KisQImagePyramidCache::instance()->clear();
+
         KisSharedQImagePyramid sharedPyramid;
         QVERIFY(sharedPyramid.pyramid(brush.data())); // avoid compiler elimination of unused code!
     }
 }
 
+void KisGbrBrushTest::testPyramidCache()
+{
+    KisQImagePyramidCache cache;
+
+    QScopedPointer<KisGbrBrush> brush1(new KisGbrBrush(QString(FILES_DATA_DIR) + QDir::separator() + "testing_brush_512_bars.gbr"));
+    QVERIFY(brush1->load());
+
+    QScopedPointer<KisGbrBrush> brush2(new KisGbrBrush(QString(FILES_DATA_DIR) + QDir::separator() + "testing_brush_512_bars.gbr"));
+    QVERIFY(brush2->load());
+
+    QScopedPointer<KisGbrBrush> brush3(new KisGbrBrush(QString(FILES_DATA_DIR) + QDir::separator() + "brush.gbr"));
+    QVERIFY(brush3->load());
+
+    // the same tip loaded twice shares the pyramid
+    QSharedPointer<const KisQImagePyramid> pyramid1 = cache.pyramid(brush1.data());
+    QSharedPointer<const KisQImagePyramid> pyramid2 = cache.pyramid(brush2.data());
+    QVERIFY(pyramid1);
+    QCOMPARE(pyramid1.data(), pyramid2.data());
+
+    // a different tip gets its own pyramid
+    QSharedPointer<const KisQImagePyramid> pyramid3 = cache.pyramid(brush3.data());
+    QVERIFY(pyramid3);
+    QVERIFY(pyramid3.data() != pyramid1.data());
+
+    // with the zero limit only the last used pyramid is kept
+    cache.setMemoryLimit(0);
+    QVERIFY(cache.pyramid(brush3.data()).data() == pyramid3.data());
+    QVERIFY(cache.pyramid(brush1.data()).data() != pyramid1.data());
+}
+
+void KisGbrBrushTest::testPyramidCachePrebuild()
+{
+    KisBrushSP brush(new KisGbrBrush(QString(FILES_DATA_DIR) + QDir::separator() + "testing_brush_512_bars.gbr"));
+    QVERIFY(brush->load());
+
+    {
+        // the cache should wait for the background job before dying
+        KisQImagePyramidCache cache;
+        cache.prebuildPyramid(brush);
+    }
+
+    KisQImagePyramidCache cache;
+    cache.prebuildPyramid(brush);
+
+    QSharedPointer<const KisQImagePyramid> pyramid = cache.pyramid(brush.data());
+    QVERIFY(pyramid);
+
+    // the tip is already cached, so no new pyramid is built
+    cache.prebuildPyramid(brush);
+    QCOMPARE(cache.pyramid(brush.data()).data(), pyramid.data());
+
+    // the clone shares the tip image with the original
+    KisBrushSP clone(brush->clone());
+    QCOMPARE(cache.pyramid(clone.data()).data(), pyramid.data());
+}
+
 void KisGbrBrushTest::benchmarkScaling()
 {
     QScopedPointer<KisGbrBrush> brush(new KisGbrBrush(QString(FILES_DATA_DIR) + QDir::separator() + "testing_brush_512_bars.gbr"));
@@ -34,6 +34,8 @@ private Q_SLOTS:
     void testImageGeneration();
 
     void benchmarkPyramidCreation();
+    void testPyramidCache();
+    void testPyramidCachePrebuild();
     void benchmarkScaling();
     void benchmarkRotation();
     void benchmarkMaskScaling();
@@ -0,0 +1,335 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisAtrousWavelet.h"
+
+#include <algorithm>
+
+#include <QRect>
+#include <QBitArray>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <KoColorSpace.h>
+#include <KoUpdater.h>
+
+#include "kis_global.h"
+#include "kis_paint_device.h"
+#include "kis_default_bounds_base.h"
+#include "KisParallelFilterUtils.h"
+
+
+namespace {
+
+using KisParallelFilterUtils::ChannelsContext;
+
+/**
+ * The thresholds of the levels relative to the threshold of the
+ * filter. Every value is the ratio of the deviation of white noise in
+ * the detail band of the level to the one in the bands of the same
+ * level of the Haar transform of KisMathToolbox, so that the threshold
+ * cuts off the same amount of noise.
+ */
+const qreal levelThresholds[KisAtrousWavelet::noiseReductionLevels] = {
+    0.5660, 0.1364, 0.04235, 0.01444, 0.005059
+};
+
+const int blockSize = 256;
+
+/**
+ * Maps the positions [start, end] into the range [min, max],
+ * repeating the border values
+ */
+QVector<int> clampedIndexes(int start, int end, int min, int max)
+{
+    QVector<int> indexes(end - start + 1);
+    for (int i = start; i <= end; i++) {
+        indexes[i - start] = qBound(min, i, max) - min;
+    }
+    return indexes;
+}
+
+/**
+ * Loads the pixels of \p rect into a premultiplied buffer of doubles.
+ * The pixels outside \p dataRect (if it is valid) repeat the border.
+ */
+QVector<qreal> loadRect(KisPaintDeviceSP src, const QRect &rect, const QRect &dataRect, const ChannelsContext &ctx)
+{
+    const int numChannels = ctx.numChannels;
+
+    QVector<qreal> result(rect.width() * rect.height() * numChannels);
+
+    if (!dataRect.isValid() || dataRect.contains(rect)) {
+        QVector<quint8> bytes(rect.width() * rect.height() * ctx.pixelSize);
+        src->readBytes(bytes.data(), rect);
+        ctx.loadPixels(bytes.constData(), result.data(), rect.width() * rect.height());
+
+        return result;
+    }
+
+    const QVector<int> columns = clampedIndexes(rect.left(), rect.right(), dataRect.left(), dataRect.right());
+    const QVector<int> rows = clampedIndexes(rect.top(), rect.bottom(), dataRect.top(), dataRect.bottom());
+
+    const QRect clampedRect(dataRect.left() + columns.first(),
+                            dataRect.top() + rows.first(),
+                            columns.last() - columns.first() + 1,
+                            rows.last() - rows.first() + 1);
+
+    QVector<qreal> clamped(clampedRect.width() * clampedRect.height() * numChannels);
+
+    {
+        QVector<quint8> bytes(clampedRect.width() * clampedRect.height() * ctx.pixelSize);
+        src->readBytes(bytes.data(), clampedRect);
+        ctx.loadPixels(bytes.constData(), clamped.data(), clampedRect.width() * clampedRect.height());
+    }
+
+    qreal *dstPtr = result.data();
+
+    for (int y = 0; y < rect.height(); y++) {
+        const qreal *srcRow = clamped.constData() + (rows[y] - rows.first()) * clampedRect.width() * numChannels;
+
+        for (int x = 0; x < rect.width(); x++) {
+            const qreal *srcPtr = srcRow + (columns[x] - columns.first()) * numChannels;
+
+            for (int ch = 0; ch < numChannels; ch++) {
+                *dstPtr++ = srcPtr[ch];
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Smoothes the \p width x \p height buffer with the separable [1 2 1] / 4
+ * kernel with the taps \p step pixels apart. The pixels outside the
+ * buffer repeat its border.
+ */
+void smooth(const QVector<qreal> &src, QVector<qreal> &tmp, QVector<qreal> &dst,
+            int width, int height, int numChannels, int step)
+{
+    const int rowValues = width * numChannels;
+
+    for (int y = 0; y < height; y++) {
+        const qreal *srcRow = src.constData() + y * rowValues;
+        qreal *dstRow = tmp.data() + y * rowValues;
+
+        for (int x = 0; x < width; x++) {
+            const qreal *left = srcRow + qMax(x - step, 0) * numChannels;
+            const qreal *center = srcRow + x * numChannels;
+            const qreal *right = srcRow + qMin(x + step, width - 1) * numChannels;
+
+            for (int ch = 0; ch < numChannels; ch++) {
+                dstRow[x * numChannels + ch] = 0.25 * (left[ch] + 2.0 * center[ch] + right[ch]);
+            }
+        }
+    }
+
+    for (int y = 0; y < height; y++) {
+        const qreal *top = tmp.constData() + qMax(y - step, 0) * rowValues;
+        const qreal *center = tmp.constData() + y * rowValues;
+        const qreal *bottom = tmp.constData() + qMin(y + step, height - 1) * rowValues;
+        qreal *dstRow = dst.data() + y * rowValues;
+
+        for (int i = 0; i < rowValues; i++) {
+            dstRow[i] = 0.25 * (top[i] + 2.0 * center[i] + bottom[i]);
+        }
+    }
+}
+
+inline qreal softThreshold(qreal value, qreal threshold)
+{
+    return value > threshold ? value - threshold :
+           value < -threshold ? value + threshold : 0.0;
+}
+
+/**
+ * Calculates the levels of the decomposition of the block with the
+ * guard border around it, sums up the thresholded detail bands of the
+ * block and adds the residual
+ */
+void reduceNoiseInBlock(KisPaintDeviceSP src, const QRect &block, const QRect &dataRect,
+                        qreal threshold, const ChannelsContext &ctx, QVector<qreal> &result)
+{
+    const int numChannels = ctx.numChannels;
+    const int margin = KisAtrousWavelet::noiseReductionMargin();
+
+    const QRect paddedRect = kisGrowRect(block, margin);
+    const int width = paddedRect.width();
+    const int height = paddedRect.height();
+
+    QVector<qreal> current = loadRect(src, paddedRect, dataRect, ctx);
+    QVector<qreal> tmp(current.size());
+    QVector<qreal> next(current.size());
+
+    result.fill(0.0);
+
+    for (int level = 0; level < KisAtrousWavelet::noiseReductionLevels; level++) {
+        smooth(current, tmp, next, width, height, numChannels, 1 << level);
+
+        const qreal levelThreshold = threshold * levelThresholds[level];
+
+        for (int y = 0; y < block.height(); y++) {
+            const int offset = ((y + margin) * width + margin) * numChannels;
+            const qreal *currentPtr = current.constData() + offset;
+            const qreal *nextPtr = next.constData() + offset;
+            qreal *dstPtr = result.data() + y * block.width() * numChannels;
+
+            for (int i = 0; i < block.width() * numChannels; i++) {
+                dstPtr[i] += softThreshold(currentPtr[i] - nextPtr[i], levelThreshold);
+            }
+        }
+
+        std::swap(current, next);
+    }
+
+    for (int y = 0; y < block.height(); y++) {
+        const qreal *residualPtr = current.constData() + ((y + margin) * width + margin) * numChannels;
+        qreal *dstPtr = result.data() + y * block.width() * numChannels;
+
+        for (int i = 0; i < block.width() * numChannels; i++) {
+            dstPtr[i] += residualPtr[i];
+        }
+    }
+}
+
+/**
+ * The kernel of the level is the sum of nine shifted copies of the
+ * block, so only they are loaded instead of the whole neighbourhood,
+ * which may be much bigger than the block itself on the coarse levels
+ */
+void smoothBlock(KisPaintDeviceSP src, const QRect &block, const QRect &dataRect,
+                 int level, const ChannelsContext &ctx, QVector<qreal> &result)
+{
+    const int step = 1 << level;
+    const qreal weights[3] = {0.25, 0.5, 0.25};
+
+    result.fill(0.0);
+
+    for (int j = 0; j < 3; j++) {
+        for (int i = 0; i < 3; i++) {
+            const QVector<qreal> shifted =
+                loadRect(src, block.translated((i - 1) * step, (j - 1) * step), dataRect, ctx);
+
+            const qreal weight = weights[i] * weights[j];
+
+            for (int k = 0; k < result.size(); k++) {
+                result[k] += weight * shifted[k];
+            }
+        }
+    }
+}
+
+template <typename BlockFunc>
+bool processInBlocks(KisPaintDeviceSP device, const QRect &rect,
+                     const QBitArray &channelFlags, KoUpdater *progressUpdater,
+                     BlockFunc blockFunc)
+{
+    ChannelsContext ctx;
+    if (!ctx.init(device->colorSpace(), channelFlags)) return false;
+
+    if (!ctx.numChannels || rect.isEmpty()) return true;
+
+    /**
+     * In wraparound mode the device returns the wrapped pixels itself,
+     * so the source is never clipped.
+     */
+    const bool wrapAround = device->defaultBounds()->wrapAroundMode();
+    const QRect dataRect = wrapAround ? QRect() : rect | device->exactBounds();
+
+    const QVector<QRect> blocks = KisParallelFilterUtils::splitIntoBlocks(rect, blockSize);
+
+    // the blocks read the areas written by their neighbours
+    KisPaintDeviceSP src = new KisPaintDevice(*device);
+
+    const int batchSize = qMax(1, QThread::idealThreadCount());
+
+    if (progressUpdater) {
+        progressUpdater->setRange(0, blocks.size());
+        progressUpdater->setValue(0);
+    }
+
+    for (int i = 0; i < blocks.size(); i += batchSize) {
+        QVector<QRect> batch = blocks.mid(i, batchSize);
+
+        QtConcurrent::blockingMap(batch, [&] (const QRect &block) {
+            QVector<qreal> result(block.width() * block.height() * ctx.numChannels);
+            blockFunc(src, block, dataRect, ctx, result);
+
+            /**
+             * The channels excluded by the channel flags are taken
+             * from the source pixels
+             */
+            QVector<quint8> dstBytes(block.width() * block.height() * ctx.pixelSize);
+            src->readBytes(dstBytes.data(), block);
+            ctx.storePixels(result.constData(), dstBytes.data(), block.width() * block.height());
+
+            device->writeBytes(dstBytes.constData(), block);
+        });
+
+        if (progressUpdater) {
+            progressUpdater->setValue(i + batch.size());
+            if (progressUpdater->interrupted()) break;
+        }
+    }
+
+    return true;
+}
+
+}
+
+int KisAtrousWavelet::smoothingMargin(int level)
+{
+    return 1 << level;
+}
+
+int KisAtrousWavelet::noiseReductionMargin()
+{
+    return (1 << noiseReductionLevels) - 1;
+}
+
+bool KisAtrousWavelet::applySmoothing(KisPaintDeviceSP device,
+                                      const QRect& rect,
+                                      int level,
+                                      const QBitArray &channelFlags,
+                                      KoUpdater *progressUpdater)
+{
+    KIS_SAFE_ASSERT_RECOVER(level >= 0) { level = 0; }
+
+    return processInBlocks(device, rect, channelFlags, progressUpdater,
+        [level] (KisPaintDeviceSP src, const QRect &block, const QRect &dataRect,
+                 const ChannelsContext &ctx, QVector<qreal> &result) {
+
+            smoothBlock(src, block, dataRect, level, ctx, result);
+        });
+}
+
+bool KisAtrousWavelet::applyNoiseReduction(KisPaintDeviceSP device,
+                                           const QRect& rect,
+                                           qreal threshold,
+                                           const QBitArray &channelFlags,
+                                           KoUpdater *progressUpdater)
+{
+    return processInBlocks(device, rect, channelFlags, progressUpdater,
+        [threshold] (KisPaintDeviceSP src, const QRect &block, const QRect &dataRect,
+                     const ChannelsContext &ctx, QVector<qreal> &result) {
+
+            reduceNoiseInBlock(src, block, dataRect, threshold, ctx, result);
+        });
+}
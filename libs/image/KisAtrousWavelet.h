@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KIS_ATROUS_WAVELET_H
+#define __KIS_ATROUS_WAVELET_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class QRect;
+class QBitArray;
+class KoUpdater;
+
+/**
+ * An undecimated ("a trous") wavelet engine. Every level of the
+ * decomposition smoothes the image with the separable [1 2 1] / 4
+ * kernel, whose taps are 2^level pixels apart, and the detail band of
+ * the level is the difference between the image before and after the
+ * smoothing.
+ *
+ * Unlike the Haar transform of KisMathToolbox, the decomposition has a
+ * bounded reach: the result of N levels depends only on the pixels
+ * closer than 2^N pixels. So the rect is processed in tile-aligned
+ * blocks in parallel, every block loads a guard border around itself
+ * and keeps only the bands of the block in memory.
+ *
+ * The border handling follows BORDER_REPEAT of the convolution
+ * painter, the same way KisRecursiveGaussianBlur does.
+ */
+class KRITAIMAGE_EXPORT KisAtrousWavelet
+{
+public:
+    /**
+     * The number of levels used by applyNoiseReduction(). The
+     * thresholds of the coarser levels are negligible.
+     */
+    static const int noiseReductionLevels = 5;
+
+    /**
+     * \return the distance the smoothing of \p level spreads the
+     *         pixels to
+     */
+    static int smoothingMargin(int level);
+
+    /**
+     * \return the distance the noise reduction spreads the pixels to
+     */
+    static int noiseReductionMargin();
+
+    /**
+     * Smoothes \p rect of \p device in-place with the kernel of
+     * \p level, i.e. calculates the residual of the level from the
+     * residual of the previous one.
+     *
+     * \return false if the color space of the device cannot be
+     *         processed by the engine. The device is not touched then.
+     */
+    static bool applySmoothing(KisPaintDeviceSP device,
+                               const QRect& rect,
+                               int level,
+                               const QBitArray &channelFlags,
+                               KoUpdater *progressUpdater);
+
+    /**
+     * Removes the noise from \p rect of \p device in-place: the detail
+     * bands are soft-thresholded and the image is reconstructed from
+     * them. The \p threshold has the same meaning as in the Haar
+     * transform based noise reducer: the threshold of every level is
+     * scaled by the ratio of the noise levels of the two transforms.
+     *
+     * \return false if the color space of the device cannot be
+     *         processed by the engine. The device is not touched then.
+     */
+    static bool applyNoiseReduction(KisPaintDeviceSP device,
+                                    const QRect& rect,
+                                    qreal threshold,
+                                    const QBitArray &channelFlags,
+                                    KoUpdater *progressUpdater);
+};
+
+#endif /* __KIS_ATROUS_WAVELET_H */
@@ -0,0 +1,331 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisBokehBlur.h"
+
+#include <cmath>
+#include <complex>
+
+#include <QRect>
+#include <QBitArray>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent>
+#include <QtMath>
+
+#include <KoColorSpace.h>
+#include <KoUpdater.h>
+
+#include "kis_global.h"
+#include "kis_paint_device.h"
+#include "kis_default_bounds_base.h"
+#include "KisParallelFilterUtils.h"
+
+
+namespace {
+
+using KisParallelFilterUtils::ChannelsContext;
+
+struct ComplexComponent {
+    qreal a; // decay of the gaussian
+    qreal b; // frequency of the phase
+    qreal A; // weight of the real part of the 2D kernel
+    qreal B; // weight of the imaginary part of the 2D kernel
+};
+
+/**
+ * The three-component fit of the unit disk by Olli Niemitalo
+ */
+const int numComponents = 3;
+const ComplexComponent components[numComponents] = {
+    {2.17649, 5.043495, 1.621035, -2.105439},
+    {1.019306, 9.027613, -0.28086, -0.162882},
+    {2.81511, 1.597273, -0.366471, 10.300301}
+};
+
+/**
+ * The radius where the fitted kernel falls to the half of its height,
+ * in the coordinates of the kernel
+ */
+const qreal diskRadius = 1.1034;
+
+/**
+ * The extent of the kernel relative to the radius of the disk. The
+ * ripples of the fit outside of it are negligible.
+ */
+const qreal supportRadius = 1.2;
+
+struct Kernel
+{
+    Kernel(qreal radius)
+        : margin(KisBokehBlur::kernelMargin(radius)),
+          size(2 * margin + 1)
+    {
+        const qreal scale = diskRadius / radius;
+        std::complex<qreal> sums[numComponents];
+
+        for (int c = 0; c < numComponents; c++) {
+            real[c].resize(size);
+            imag[c].resize(size);
+
+            for (int k = 0; k < size; k++) {
+                const qreal u2 = pow2((k - margin) * scale);
+                const std::complex<qreal> value =
+                    std::exp(-components[c].a * u2) *
+                    std::complex<qreal>(std::cos(components[c].b * u2), std::sin(components[c].b * u2));
+
+                real[c][k] = value.real();
+                imag[c][k] = value.imag();
+                sums[c] += value;
+            }
+        }
+
+        /**
+         * The sum of the separable 2D kernel is the square of the sum
+         * of its 1D factor
+         */
+        qreal totalSum = 0.0;
+
+        for (int c = 0; c < numComponents; c++) {
+            const std::complex<qreal> sum2D = sums[c] * sums[c];
+            totalSum += components[c].A * sum2D.real() + components[c].B * sum2D.imag();
+        }
+
+        for (int c = 0; c < numComponents; c++) {
+            realWeight[c] = components[c].A / totalSum;
+            imagWeight[c] = components[c].B / totalSum;
+        }
+    }
+
+    const int margin;
+    const int size;
+
+    QVector<qreal> real[numComponents];
+    QVector<qreal> imag[numComponents];
+    qreal realWeight[numComponents];
+    qreal imagWeight[numComponents];
+};
+
+/**
+ * Splits \p rc into the tile-aligned blocks of at most \p blockHeight
+ * rows (which should be a multiple of the tile size)
+ */
+QVector<QRect> splitIntoBlocks(const QRect &rc, int blockHeight)
+{
+    QVector<QRect> blocks;
+
+    Q_FOREACH (const QRect &strip, KisParallelFilterUtils::splitIntoStrips(rc, Qt::Vertical)) {
+        int pos = strip.top();
+        while (pos <= strip.bottom()) {
+            const int blockStart = pos >= 0 ? pos / blockHeight * blockHeight : -((-pos + blockHeight - 1) / blockHeight * blockHeight);
+            const int next = qMin(blockStart + blockHeight, strip.bottom() + 1);
+
+            blocks << QRect(strip.left(), pos, strip.width(), next - pos);
+            pos = next;
+        }
+    }
+
+    return blocks;
+}
+
+/**
+ * Maps the positions [start, end] to the indexes in the loaded range
+ * [loadStart, loadEnd], repeating the border values
+ */
+QVector<int> clampedIndexes(int start, int end, int loadStart, int loadEnd)
+{
+    QVector<int> indexes(end - start + 1);
+    for (int i = start; i <= end; i++) {
+        indexes[i - start] = qBound(loadStart, i, loadEnd) - loadStart;
+    }
+    return indexes;
+}
+
+void processBlock(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                  const QRect &block, const QRect &dataRect,
+                  const Kernel &kernel, const ChannelsContext &ctx)
+{
+    const int margin = kernel.margin;
+    const int numChannels = ctx.numChannels;
+    const int pixelSize = ctx.pixelSize;
+
+    QRect loadRect = kisGrowRect(block, margin);
+    if (dataRect.isValid()) {
+        loadRect &= dataRect;
+    }
+
+    const QVector<int> columnIndexes =
+        clampedIndexes(block.left() - margin, block.right() + margin, loadRect.left(), loadRect.right());
+    const QVector<int> rowIndexes =
+        clampedIndexes(block.top() - margin, block.bottom() + margin, loadRect.top(), loadRect.bottom());
+
+    QVector<qreal> input(loadRect.width() * loadRect.height() * numChannels);
+
+    {
+        QVector<quint8> bytes(loadRect.width() * loadRect.height() * pixelSize);
+        src->readBytes(bytes.data(), loadRect);
+        ctx.loadPixels(bytes.constData(), input.data(), loadRect.width() * loadRect.height());
+    }
+
+    const int blockWidth = block.width();
+    const int rowValues = blockWidth * numChannels;
+    const int componentValues = loadRect.height() * rowValues;
+
+    /**
+     * The horizontal pass: the rows of the loaded rect are convolved
+     * with the complex kernels for the columns of the block
+     */
+    QVector<qreal> passReal(numComponents * componentValues, 0.0);
+    QVector<qreal> passImag(numComponents * componentValues, 0.0);
+
+    for (int c = 0; c < numComponents; c++) {
+        const qreal *kernelReal = kernel.real[c].constData();
+        const qreal *kernelImag = kernel.imag[c].constData();
+
+        for (int row = 0; row < loadRect.height(); row++) {
+            const qreal *srcRow = input.constData() + row * loadRect.width() * numChannels;
+            qreal *dstReal = passReal.data() + c * componentValues + row * rowValues;
+            qreal *dstImag = passImag.data() + c * componentValues + row * rowValues;
+
+            for (int x = 0; x < blockWidth; x++) {
+                qreal *realPtr = dstReal + x * numChannels;
+                qreal *imagPtr = dstImag + x * numChannels;
+
+                for (int k = 0; k < kernel.size; k++) {
+                    const qreal *srcPtr = srcRow + columnIndexes[x + k] * numChannels;
+
+                    for (int ch = 0; ch < numChannels; ch++) {
+                        realPtr[ch] += kernelReal[k] * srcPtr[ch];
+                        imagPtr[ch] += kernelImag[k] * srcPtr[ch];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * The vertical pass: the complex rows are convolved with the
+     * complex kernels and the components are summed up into the result
+     */
+    QVector<qreal> result(block.height() * rowValues, 0.0);
+    QVector<qreal> sumReal(rowValues);
+    QVector<qreal> sumImag(rowValues);
+
+    for (int c = 0; c < numComponents; c++) {
+        const qreal *kernelReal = kernel.real[c].constData();
+        const qreal *kernelImag = kernel.imag[c].constData();
+
+        for (int y = 0; y < block.height(); y++) {
+            sumReal.fill(0.0);
+            sumImag.fill(0.0);
+
+            for (int k = 0; k < kernel.size; k++) {
+                const int offset = c * componentValues + rowIndexes[y + k] * rowValues;
+                const qreal *srcReal = passReal.constData() + offset;
+                const qreal *srcImag = passImag.constData() + offset;
+
+                const qreal wr = kernelReal[k];
+                const qreal wi = kernelImag[k];
+
+                for (int i = 0; i < rowValues; i++) {
+                    sumReal[i] += wr * srcReal[i] - wi * srcImag[i];
+                    sumImag[i] += wr * srcImag[i] + wi * srcReal[i];
+                }
+            }
+
+            qreal *dstPtr = result.data() + y * rowValues;
+            for (int i = 0; i < rowValues; i++) {
+                dstPtr[i] += kernel.realWeight[c] * sumReal[i] + kernel.imagWeight[c] * sumImag[i];
+            }
+        }
+    }
+
+    /**
+     * The channels excluded by the channel flags are taken from the
+     * source pixels
+     */
+    QVector<quint8> dstBytes(block.width() * block.height() * pixelSize);
+    src->readBytes(dstBytes.data(), block);
+    ctx.storePixels(result.constData(), dstBytes.data(), block.width() * block.height());
+
+    dst->writeBytes(dstBytes.constData(), block);
+}
+
+}
+
+int KisBokehBlur::kernelMargin(qreal radius)
+{
+    return qCeil(supportRadius * radius);
+}
+
+bool KisBokehBlur::applyCircularBlur(KisPaintDeviceSP device,
+                                     const QRect& rect,
+                                     qreal radius,
+                                     const QBitArray &channelFlags,
+                                     KoUpdater *progressUpdater)
+{
+    ChannelsContext ctx;
+    if (!ctx.init(device->colorSpace(), channelFlags)) return false;
+
+    if (!ctx.numChannels || rect.isEmpty() || radius <= 0.0) return true;
+
+    /**
+     * In wraparound mode the device returns the wrapped pixels itself,
+     * so the source is never clipped.
+     */
+    const bool wrapAround = device->defaultBounds()->wrapAroundMode();
+    const QRect dataRect = wrapAround ? QRect() : rect | device->exactBounds();
+
+    const Kernel kernel(radius);
+
+    /**
+     * Every block recalculates the horizontal pass for the margins
+     * around it, so the blocks are made taller for large kernels,
+     * while still limiting the memory used by a block.
+     */
+    const int tileSize = 64;
+    const int maxBlockHeight = 1024;
+    const int blockHeight = qBound(tileSize, (4 * kernel.margin + tileSize - 1) / tileSize * tileSize, maxBlockHeight);
+
+    const QVector<QRect> blocks = splitIntoBlocks(rect, blockHeight);
+
+    // the blocks read the areas written by their neighbours
+    KisPaintDeviceSP src = new KisPaintDevice(*device);
+
+    const int batchSize = qMax(1, QThread::idealThreadCount());
+
+    if (progressUpdater) {
+        progressUpdater->setRange(0, blocks.size());
+        progressUpdater->setValue(0);
+    }
+
+    for (int i = 0; i < blocks.size(); i += batchSize) {
+        QVector<QRect> batch = blocks.mid(i, batchSize);
+
+        QtConcurrent::blockingMap(batch, [&] (const QRect &block) {
+            processBlock(src, device, block, dataRect, kernel, ctx);
+        });
+
+        if (progressUpdater) {
+            progressUpdater->setValue(i + batch.size());
+            if (progressUpdater->interrupted()) break;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KIS_BOKEH_BLUR_H
+#define __KIS_BOKEH_BLUR_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class QRect;
+class QBitArray;
+class KoUpdater;
+
+/**
+ * A lens blur engine for round apertures. The disk-shaped kernel is
+ * approximated by a weighted sum of three separable complex Gaussian
+ * kernels exp(-a x^2) * exp(i b x^2), as proposed by Olli Niemitalo:
+ * every component is a horizontal and a vertical complex pass, so the
+ * cost grows linearly with the radius instead of quadratically. The
+ * difference from the exact disk convolution stays within a couple of
+ * levels of an 8-bit channel.
+ *
+ * The rect is processed in tile-aligned blocks in parallel. The border
+ * handling follows BORDER_REPEAT of the convolution painter, the same
+ * way KisRecursiveGaussianBlur does.
+ */
+class KRITAIMAGE_EXPORT KisBokehBlur
+{
+public:
+    /**
+     * For smaller radii the approximation is worse and the exact
+     * convolution is cheap, so the callers should use the latter
+     */
+    static const int minimalRadius = 8;
+
+    /**
+     * \return the distance the blur can spread the pixels to, i.e.
+     *         the half-size of the kernel
+     */
+    static int kernelMargin(qreal radius);
+
+    /**
+     * Blurs \p rect of \p device in-place with the disk of \p radius
+     *
+     * \return false if the color space of the device cannot be
+     *         processed by the engine. The device is not touched then.
+     */
+    static bool applyCircularBlur(KisPaintDeviceSP device,
+                                  const QRect& rect,
+                                  qreal radius,
+                                  const QBitArray &channelFlags,
+                                  KoUpdater *progressUpdater);
+};
+
+#endif /* __KIS_BOKEH_BLUR_H */
@@ -0,0 +1,495 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisDistanceTransform.h"
+
+#include <cfloat>
+#include <cmath>
+
+#include <QRect>
+#include <QVector>
+#include <QPair>
+#include <QtConcurrent>
+#include <QtMath>
+
+#include "kis_global.h"
+#include "kis_paint_device.h"
+
+
+namespace {
+
+const double infinity = 1e20;
+
+/**
+ * Calculates the lower envelope of the parabolas rooted at the finite
+ * samples of \p f: d[p] = min_q(scale2 * (p - q)^2 + f[q]). If \p nearest
+ * is not null, the minimizing q is stored in it (or -1 if all the
+ * samples are infinite). \p vertices and \p boundaries should have
+ * space for n and n + 1 elements.
+ */
+void transformLine(const double *f, double *d, int *nearest, int n, double scale2,
+                   int *vertices, double *boundaries)
+{
+    int k = -1;
+
+    for (int q = 0; q < n; q++) {
+        if (f[q] >= infinity) continue;
+
+        double s = -infinity;
+
+        while (k >= 0) {
+            const int p = vertices[k];
+            s = ((f[q] + scale2 * q * q) - (f[p] + scale2 * p * p)) / (2.0 * scale2 * (q - p));
+
+            if (s > boundaries[k]) break;
+            k--;
+        }
+
+        k++;
+        vertices[k] = q;
+        boundaries[k] = k > 0 ? s : -infinity;
+    }
+
+    if (k < 0) {
+        std::fill(d, d + n, infinity);
+        if (nearest) {
+            std::fill(nearest, nearest + n, -1);
+        }
+        return;
+    }
+
+    boundaries[k + 1] = infinity;
+
+    int j = 0;
+    for (int p = 0; p < n; p++) {
+        while (boundaries[j + 1] < p) j++;
+        d[p] = scale2 * pow2(p - vertices[j]) + f[vertices[j]];
+        if (nearest) {
+            nearest[p] = vertices[j];
+        }
+    }
+}
+
+template <class Func>
+void processLinesInParallel(int numLines, Func func)
+{
+    const int linesPerJob = 64;
+
+    QVector<QPair<int, int>> jobs;
+    for (int i = 0; i < numLines; i += linesPerJob) {
+        jobs << qMakePair(i, qMin(i + linesPerJob, numLines));
+    }
+
+    QtConcurrent::blockingMap(jobs, func);
+}
+
+/**
+ * Calls \p func(srcIndex, dstIndex) for every pixel of \p tile
+ */
+template <class Func>
+void forEachTilePixel(const QRect &srcRect, const QRect &tile, Func func)
+{
+    const QPoint offset = tile.topLeft() - srcRect.topLeft();
+
+    for (int y = 0; y < tile.height(); y++) {
+        const int srcRow = (y + offset.y()) * srcRect.width() + offset.x();
+        const int dstRow = y * tile.width();
+
+        for (int x = 0; x < tile.width(); x++) {
+            func(srcRow + x, dstRow + x);
+        }
+    }
+}
+
+/**
+ * Calculates the squared distance from every pixel of the buffer to the
+ * nearest feature, that is, the nearest pixel with the value not less
+ * than \p level (or less than it if \p inverted is true). If \p nearest
+ * is not null, the index of that feature is stored in it, or -1 if the
+ * buffer has no features at all. The distance of such pixels is FLT_MAX.
+ */
+void featureTransform(const quint8 *data, int width, int height,
+                      quint8 level, bool inverted,
+                      qreal xScale, qreal yScale,
+                      float *result, int *nearest)
+{
+    QVector<double> columnDistance(width * height);
+    QVector<int> columnNearest(nearest ? width * height : 0);
+
+    processLinesInParallel(width, [&] (const QPair<int, int> &job) {
+        QVector<double> f(height);
+        QVector<double> d(height);
+        QVector<int> n(nearest ? height : 0);
+        QVector<int> vertices(height);
+        QVector<double> boundaries(height + 1);
+
+        for (int x = job.first; x < job.second; x++) {
+            for (int y = 0; y < height; y++) {
+                f[y] = (data[y * width + x] >= level) != inverted ? 0.0 : infinity;
+            }
+
+            transformLine(f.constData(), d.data(), nearest ? n.data() : 0, height, pow2(yScale),
+                          vertices.data(), boundaries.data());
+
+            for (int y = 0; y < height; y++) {
+                columnDistance[y * width + x] = d[y];
+            }
+
+            if (nearest) {
+                for (int y = 0; y < height; y++) {
+                    columnNearest[y * width + x] = n[y];
+                }
+            }
+        }
+    });
+
+    processLinesInParallel(height, [&] (const QPair<int, int> &job) {
+        QVector<double> d(width);
+        QVector<int> n(nearest ? width : 0);
+        QVector<int> vertices(width);
+        QVector<double> boundaries(width + 1);
+
+        for (int y = job.first; y < job.second; y++) {
+            transformLine(columnDistance.constData() + y * width, d.data(), nearest ? n.data() : 0,
+                          width, pow2(xScale),
+                          vertices.data(), boundaries.data());
+
+            float *dstPtr = result + y * width;
+            for (int x = 0; x < width; x++) {
+                dstPtr[x] = d[x] < infinity ? float(d[x]) : FLT_MAX;
+            }
+
+            if (nearest) {
+                int *nearestPtr = nearest + y * width;
+                for (int x = 0; x < width; x++) {
+                    nearestPtr[x] = n[x] >= 0 ? columnNearest[y * width + n[x]] * width + n[x] : -1;
+                }
+            }
+        }
+    });
+}
+
+/**
+ * The maximum number of the levels the grayscale masks are decomposed
+ * into, see decompositionLevels()
+ */
+const int maxDecompositionLevels = 32;
+
+/**
+ * Returns the ascending nonzero levels for the threshold decomposition
+ * of the values in \p rect of \p device (complemented if \p complement
+ * is true) and \p extraValue. The decomposition is exact when the mask
+ * has at most maxDecompositionLevels distinct values, which is the case
+ * for most of the selections. Otherwise the levels are spread evenly,
+ * and the values between two levels are handled as the lower one.
+ *
+ * The levels depend on the whole rect, not on a tile of it, so that
+ * the tiles join seamlessly.
+ */
+QVector<quint8> decompositionLevels(KisPaintDeviceSP device, const QRect &rect,
+                                    bool complement, quint8 extraValue)
+{
+    QVector<bool> present(256, false);
+    present[extraValue] = true;
+
+    const int stripeHeight = 64;
+    QVector<quint8> stripe;
+
+    for (int y = rect.y(); y <= rect.bottom(); y += stripeHeight) {
+        const QRect stripeRect = QRect(rect.x(), y, rect.width(), stripeHeight) & rect;
+
+        stripe.resize(stripeRect.width() * stripeRect.height());
+        device->readBytes(stripe.data(), stripeRect);
+
+        Q_FOREACH (quint8 value, stripe) {
+            present[complement ? MAX_SELECTED - value : value] = true;
+        }
+    }
+
+    QVector<quint8> levels;
+    for (int i = 1; i < 256; i++) {
+        if (present[i]) {
+            levels << quint8(i);
+        }
+    }
+
+    if (levels.size() > maxDecompositionLevels) {
+        levels.clear();
+        for (int i = 1; i <= maxDecompositionLevels; i++) {
+            levels << quint8(qRound(qreal(i) * MAX_SELECTED / maxDecompositionLevels));
+        }
+    }
+
+    return levels;
+}
+
+/**
+ * Grows the grayscale \p src by the circle of \p radius in the scaled
+ * space and writes the \p tile part of the result into \p dst.
+ *
+ * Every level of the decomposition is grown separately, and a pixel
+ * takes the value of the nearest feature of the level, weighted by its
+ * coverage. The maximum over all the levels is the grayscale dilation.
+ */
+void growTile(const quint8 *src, const QRect &srcRect, quint8 *dst, const QRect &tile,
+              const QVector<quint8> &levels,
+              qreal radius, qreal xScale, qreal yScale)
+{
+    const int numPixels = srcRect.width() * srcRect.height();
+
+    QVector<float> distance(numPixels);
+    QVector<int> nearest(numPixels);
+
+    forEachTilePixel(srcRect, tile, [&] (int i, int j) {
+        dst[j] = src[i];
+    });
+
+    Q_FOREACH (quint8 level, levels) {
+        featureTransform(src, srcRect.width(), srcRect.height(), level, false,
+                         xScale, yScale, distance.data(), nearest.data());
+
+        /**
+         * The edge of the source lies half a pixel away from the centers of
+         * the selected pixels, so the grown edge is at (radius + 0.5)
+         */
+        forEachTilePixel(srcRect, tile, [&] (int i, int j) {
+            if (nearest[i] < 0) return;
+
+            const qreal coverage = qBound(0.0, radius + 1.0 - std::sqrt(distance[i]), 1.0);
+            dst[j] = qMax(dst[j], quint8(qRound(coverage * src[nearest[i]])));
+        });
+    }
+}
+
+/**
+ * Splits \p rect into tiles and calls \p func for every one of them with
+ * the source bytes of the tile grown by \p guard (and clipped by \p rect)
+ * and the destination buffer for the tile itself. The result of a pixel
+ * should not depend on the features farther than \p guard pixels from it,
+ * then the tiles give exactly the same result as the whole rect would.
+ *
+ * The source is read from a snapshot of the device, so the tiles written
+ * before do not affect the guard bands of the next ones.
+ */
+template <class Func>
+void processInTiles(KisPaintDeviceSP device, const QRect &rect, int guard, Func func)
+{
+    const int tileSize = qMax(512, 4 * guard);
+
+    KisPaintDeviceSP source = device;
+    if (rect.width() > tileSize || rect.height() > tileSize) {
+        source = new KisPaintDevice(*device);
+    }
+
+    QVector<quint8> src;
+    QVector<quint8> dst;
+
+    for (int y = rect.y(); y <= rect.bottom(); y += tileSize) {
+        for (int x = rect.x(); x <= rect.right(); x += tileSize) {
+            const QRect tile = QRect(x, y, tileSize, tileSize) & rect;
+            const QRect srcRect = kisGrowRect(tile, guard) & rect;
+
+            src.resize(srcRect.width() * srcRect.height());
+            source->readBytes(src.data(), srcRect);
+
+            dst.resize(tile.width() * tile.height());
+            func(src.constData(), srcRect, dst.data(), tile);
+
+            device->writeBytes(dst.constData(), tile);
+        }
+    }
+}
+
+
+}
+
+void KisDistanceTransform::squaredDistance(const quint8 *data, int width, int height,
+                                           float *result,
+                                           bool inverted,
+                                           qreal xScale, qreal yScale)
+{
+    if (width <= 0 || height <= 0) return;
+
+    featureTransform(data, width, height, featureThreshold, inverted,
+                     xScale, yScale, result, 0);
+}
+
+void KisDistanceTransform::applyGrow(KisPaintDeviceSP device, const QRect &rect,
+                                     qreal xRadius, qreal yRadius)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(device->pixelSize() == 1);
+    if (rect.isEmpty() || (xRadius <= 0 && yRadius <= 0)) return;
+
+    /**
+     * The ellipse is transformed into a circle of the larger radius
+     */
+    const qreal radius = qMax(xRadius, yRadius);
+    const qreal xScale = radius / qMax(xRadius, 0.5);
+    const qreal yScale = radius / qMax(yRadius, 0.5);
+
+    /**
+     * The scales are not less than 1, so the features affecting a pixel
+     * are never farther than (radius + 1) along any of the axes
+     */
+    const int guard = qCeil(radius) + 1;
+
+    const QVector<quint8> levels = decompositionLevels(device, rect, false, MIN_SELECTED);
+
+    processInTiles(device, rect, guard,
+        [&] (const quint8 *src, const QRect &srcRect, quint8 *dst, const QRect &tile) {
+            growTile(src, srcRect, dst, tile, levels, radius, xScale, yScale);
+        });
+}
+
+void KisDistanceTransform::applyShrink(KisPaintDeviceSP device, const QRect &rect,
+                                       qreal xRadius, qreal yRadius,
+                                       bool edgeLock)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(device->pixelSize() == 1);
+    if (rect.isEmpty() || (xRadius <= 0 && yRadius <= 0)) return;
+
+    const qreal radius = qMax(xRadius, yRadius);
+    const qreal xScale = radius / qMax(xRadius, 0.5);
+    const qreal yScale = radius / qMax(yRadius, 0.5);
+    const int guard = qCeil(radius) + 1;
+
+    /**
+     * Shrinking is growing of the complement of the mask
+     */
+    const quint8 outsideValue = edgeLock ? MIN_SELECTED : MAX_SELECTED;
+    const QVector<quint8> levels = decompositionLevels(device, rect, true, outsideValue);
+
+    processInTiles(device, rect, guard,
+        [&] (const quint8 *src, const QRect &srcRect, quint8 *dst, const QRect &tile) {
+            /**
+             * The pixels outside the rect take part in the transform, so the
+             * buffer gets a one-pixel border of them. Where the border cuts
+             * the guard band instead, it is too far to change anything.
+             */
+            const int paddedWidth = srcRect.width() + 2;
+            const int paddedHeight = srcRect.height() + 2;
+
+            QVector<quint8> padded(paddedWidth * paddedHeight, outsideValue);
+            for (int y = 0; y < srcRect.height(); y++) {
+                const quint8 *srcPtr = src + y * srcRect.width();
+                quint8 *dstPtr = padded.data() + (y + 1) * paddedWidth + 1;
+
+                for (int x = 0; x < srcRect.width(); x++) {
+                    dstPtr[x] = MAX_SELECTED - srcPtr[x];
+                }
+            }
+
+            growTile(padded.constData(), srcRect.adjusted(-1, -1, 1, 1), dst, tile,
+                     levels, radius, xScale, yScale);
+
+            const int numTilePixels = tile.width() * tile.height();
+            for (int i = 0; i < numTilePixels; i++) {
+                dst[i] = MAX_SELECTED - dst[i];
+            }
+        });
+}
+
+void KisDistanceTransform::applyFeather(KisPaintDeviceSP device, const QRect &rect,
+                                        int radius)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(device->pixelSize() == 1);
+    if (rect.isEmpty() || radius <= 0) return;
+
+    /**
+     * The profile is the step response of the kernel of
+     * KisFeatherSelectionFilter: a gaussian of sigma equal to the radius,
+     * truncated at the radius. profile[i] is the value of the pixel lying
+     * (i - radius - 1) pixels inside the edge.
+     */
+    const int kernelSize = 2 * radius + 1;
+    QVector<qreal> kernel(kernelSize);
+    qreal kernelSum = 0.0;
+
+    for (int i = 0; i < kernelSize; i++) {
+        kernel[i] = std::exp(-qreal(pow2(i - radius)) / (2.0 * pow2(radius)));
+        kernelSum += kernel[i];
+    }
+
+    QVector<qreal> profile(kernelSize + 1, 0.0);
+    for (int i = 1; i <= kernelSize; i++) {
+        profile[i] = profile[i - 1] + kernel[kernelSize - i] / kernelSum;
+    }
+
+    /**
+     * Outside the profile the values are exactly 0 or 255, so the
+     * features farther than (radius + 1) do not matter
+     */
+    const int guard = radius + 1;
+
+    const QVector<quint8> levels = decompositionLevels(device, rect, false, MIN_SELECTED);
+
+    processInTiles(device, rect, guard,
+        [&] (const quint8 *src, const QRect &srcRect, quint8 *dst, const QRect &tile) {
+            const int numPixels = srcRect.width() * srcRect.height();
+
+            QVector<float> outerDistance(numPixels);
+            QVector<float> innerDistance(numPixels);
+
+            /**
+             * Every level of the decomposition is feathered separately and
+             * the difference from its binary mask, weighted by the height of
+             * the level, is added to the source. When the levels cover all
+             * the values of the mask, the sum of the binary masks is the
+             * source itself, so the result is the sum of the feathered ones.
+             */
+            QVector<qreal> result(tile.width() * tile.height());
+            forEachTilePixel(srcRect, tile, [&] (int i, int j) {
+                result[j] = src[i];
+            });
+
+            quint8 previousLevel = MIN_SELECTED;
+
+            Q_FOREACH (quint8 level, levels) {
+                const qreal levelHeight = level - previousLevel;
+                previousLevel = level;
+
+                featureTransform(src, srcRect.width(), srcRect.height(), level, false,
+                                 1.0, 1.0, outerDistance.data(), 0);
+                featureTransform(src, srcRect.width(), srcRect.height(), level, true,
+                                 1.0, 1.0, innerDistance.data(), 0);
+
+                forEachTilePixel(srcRect, tile, [&] (int i, int j) {
+                    const bool isSelected = src[i] >= level;
+
+                    /**
+                     * The edge lies half a pixel away from the centers of the
+                     * pixels, so on straight edges the position is integral and
+                     * the result is the same as the one of the filter
+                     */
+                    const qreal position = isSelected ?
+                        std::sqrt(innerDistance[i]) - 1.0 : -std::sqrt(outerDistance[i]);
+
+                    const qreal index = qBound(0.0, position + radius + 1, qreal(kernelSize));
+                    const int base = qMin(int(index), kernelSize - 1);
+                    const qreal t = index - base;
+
+                    const qreal value = (1.0 - t) * profile[base] + t * profile[base + 1];
+                    result[j] += levelHeight * (value - (isSelected ? 1.0 : 0.0));
+                });
+            }
+
+            for (int j = 0; j < result.size(); j++) {
+                dst[j] = quint8(qBound(0, qRound(result[j]), int(MAX_SELECTED)));
+            }
+        });
+}
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KIS_DISTANCE_TRANSFORM_H
+#define __KIS_DISTANCE_TRANSFORM_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class QRect;
+
+/**
+ * Exact Euclidean distance transform of 8-bit masks (alpha devices and
+ * pixel selections) and the selection operations built on top of it.
+ *
+ * The transform uses the Felzenszwalb-Huttenlocher lower envelope of
+ * parabolas: one pass over the columns and one pass over the rows,
+ * each linear in the number of pixels, so the cost does not depend on
+ * the distances involved. The lines of every pass are processed in
+ * parallel.
+ *
+ * The operations on devices process the rect in tiles with a guard band
+ * of the size of the radius, so the memory they need does not depend on
+ * the size of the rect.
+ *
+ * \ref squaredDistance considers the pixels with values not less than
+ * \ref featureThreshold selected. The operations on devices handle
+ * grayscale masks by threshold decomposition: the mask is split into
+ * binary masks, one per distinct value, every one of them is transformed
+ * separately and the results are combined. The operations are exact
+ * when the rect has at most 32 distinct values. Otherwise the values
+ * are rounded down to 32 uniform levels before the transform, which
+ * underestimates the result by less than 8 but never overestimates it.
+ */
+class KRITAIMAGE_EXPORT KisDistanceTransform
+{
+public:
+    static const quint8 featureThreshold = 128;
+
+    /**
+     * Calculates the squared distance from every pixel of a \p width x
+     * \p height buffer to the nearest selected pixel (or the nearest
+     * unselected one if \p inverted is true). The distances along the
+     * axes are multiplied by \p xScale and \p yScale respectively. The
+     * pixels having no features at all get FLT_MAX.
+     */
+    static void squaredDistance(const quint8 *data, int width, int height,
+                                float *result,
+                                bool inverted = false,
+                                qreal xScale = 1.0, qreal yScale = 1.0);
+
+    /**
+     * Grows the selection in \p rect of \p device by the ellipse with
+     * the given radii. The pixels outside \p rect are considered
+     * unselected.
+     */
+    static void applyGrow(KisPaintDeviceSP device, const QRect &rect,
+                          qreal xRadius, qreal yRadius);
+
+    /**
+     * Shrinks the selection in \p rect of \p device by the ellipse with
+     * the given radii. The pixels outside \p rect are considered
+     * selected if \p edgeLock is true and unselected otherwise.
+     */
+    static void applyShrink(KisPaintDeviceSP device, const QRect &rect,
+                            qreal xRadius, qreal yRadius,
+                            bool edgeLock);
+
+    /**
+     * Feathers the edges of the selection in \p rect of \p device. The
+     * value of every pixel depends on its signed distance to the edge
+     * the way it would after blurring a straight edge with the kernel
+     * of KisFeatherSelectionFilter of the same \p radius. The pixels
+     * outside \p rect are considered unselected.
+     */
+    static void applyFeather(KisPaintDeviceSP device, const QRect &rect,
+                             int radius);
+};
+
+#endif /* __KIS_DISTANCE_TRANSFORM_H */
@@ -0,0 +1,375 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisMorphology.h"
+
+#include <cmath>
+
+#include <QRect>
+#include <QVector>
+#include <QPair>
+#include <QtConcurrent>
+
+#include "kis_global.h"
+#include "kis_paint_device.h"
+
+
+namespace {
+
+struct LineSegment {
+    int dx;
+    int dy;
+    int steps; // number of steps in each direction from the center
+};
+
+struct MaxOp {
+    static inline quint8 apply(quint8 a, quint8 b) {
+        return qMax(a, b);
+    }
+};
+
+struct MinOp {
+    static inline quint8 apply(quint8 a, quint8 b) {
+        return qMin(a, b);
+    }
+};
+
+/**
+ * Directions of the segments used for approximating an ellipse,
+ * sorted by angle in [0, pi)
+ */
+const int numEllipseDirections = 8;
+const int ellipseDirections[numEllipseDirections][2] = {
+    {1, 0}, {2, 1}, {1, 1}, {1, 2}, {0, 1}, {-1, 2}, {-1, 1}, {-2, 1}
+};
+
+inline qreal ellipseSupport(qreal nx, qreal ny, int xRadius, int yRadius)
+{
+    return std::sqrt(pow2(xRadius * nx) + pow2(yRadius * ny));
+}
+
+inline qreal zonotopeSupport(qreal nx, qreal ny, const qreal *steps)
+{
+    qreal result = 0.0;
+    for (int i = 0; i < numEllipseDirections; i++) {
+        result += steps[i] * qAbs(ellipseDirections[i][0] * nx + ellipseDirections[i][1] * ny);
+    }
+    return result;
+}
+
+qreal maxEllipseError(const qreal *steps, int xRadius, int yRadius)
+{
+    const int numSamples = 360;
+    qreal result = 0.0;
+
+    for (int k = 0; k < numSamples; k++) {
+        const qreal angle = M_PI * k / numSamples;
+        const qreal nx = std::cos(angle);
+        const qreal ny = std::sin(angle);
+
+        result = qMax(result, qAbs(zonotopeSupport(nx, ny, steps) -
+                                   ellipseSupport(nx, ny, xRadius, yRadius)));
+    }
+
+    return result;
+}
+
+/**
+ * The Minkowski sum of the segments is a centrally symmetric 16-gon
+ * with the edges parallel to the segments. First, the polygon tangent
+ * to the ellipse is built, then it is shrunk to balance the errors
+ * inside and outside the ellipse. Finally, the integer lengths of the
+ * segments are tuned to minimize the maximum error.
+ */
+QVector<LineSegment> decomposeEllipse(int xRadius, int yRadius)
+{
+    qreal normals[2 * numEllipseDirections][2];
+    qreal supports[2 * numEllipseDirections];
+
+    for (int i = 0; i < numEllipseDirections; i++) {
+        const qreal length = std::sqrt(qreal(pow2(ellipseDirections[i][0]) + pow2(ellipseDirections[i][1])));
+        normals[i][0] = -ellipseDirections[i][1] / length;
+        normals[i][1] = ellipseDirections[i][0] / length;
+        normals[i + numEllipseDirections][0] = -normals[i][0];
+        normals[i + numEllipseDirections][1] = -normals[i][1];
+    }
+
+    for (int i = 0; i < 2 * numEllipseDirections; i++) {
+        supports[i] = ellipseSupport(normals[i][0], normals[i][1], xRadius, yRadius);
+    }
+
+    auto tangentIntersection = [&] (int i, int j) {
+        const qreal det = normals[i][0] * normals[j][1] - normals[i][1] * normals[j][0];
+        return QPointF((supports[i] * normals[j][1] - normals[i][1] * supports[j]) / det,
+                       (normals[i][0] * supports[j] - supports[i] * normals[j][0]) / det);
+    };
+
+    qreal steps[numEllipseDirections];
+
+    for (int i = 0; i < numEllipseDirections; i++) {
+        const int prev = (i + 2 * numEllipseDirections - 1) % (2 * numEllipseDirections);
+        const int next = i + 1;
+
+        const QPointF edge = tangentIntersection(i, next) - tangentIntersection(prev, i);
+        const qreal directionLength = std::sqrt(qreal(pow2(ellipseDirections[i][0]) + pow2(ellipseDirections[i][1])));
+
+        steps[i] = std::sqrt(pow2(edge.x()) + pow2(edge.y())) / (2 * directionLength);
+    }
+
+    qreal maxRatio = 1.0;
+    const int numSamples = 720;
+    for (int k = 0; k < numSamples; k++) {
+        const qreal angle = 2 * M_PI * k / numSamples;
+        const qreal nx = std::cos(angle);
+        const qreal ny = std::sin(angle);
+
+        maxRatio = qMax(maxRatio, zonotopeSupport(nx, ny, steps) / ellipseSupport(nx, ny, xRadius, yRadius));
+    }
+
+    const qreal scale = 2.0 / (1.0 + maxRatio);
+    for (int i = 0; i < numEllipseDirections; i++) {
+        steps[i] = qRound(steps[i] * scale);
+    }
+
+    qreal bestError = maxEllipseError(steps, xRadius, yRadius);
+    bool improved = true;
+
+    while (improved) {
+        improved = false;
+
+        for (int i = 0; i < numEllipseDirections; i++) {
+            for (int delta = -1; delta <= 1; delta += 2) {
+                if (steps[i] + delta < 0) continue;
+
+                steps[i] += delta;
+                const qreal error = maxEllipseError(steps, xRadius, yRadius);
+
+                if (error < bestError) {
+                    bestError = error;
+                    improved = true;
+                } else {
+                    steps[i] -= delta;
+                }
+            }
+        }
+    }
+
+    QVector<LineSegment> segments;
+    for (int i = 0; i < numEllipseDirections; i++) {
+        if (steps[i] > 0) {
+            segments << LineSegment{ellipseDirections[i][0], ellipseDirections[i][1], int(steps[i])};
+        }
+    }
+
+    return segments;
+}
+
+QVector<LineSegment> decompose(KisMorphology::Shape shape, int xRadius, int yRadius)
+{
+    QVector<LineSegment> segments;
+
+    if (shape == KisMorphology::Ellipse && xRadius > 0 && yRadius > 0) {
+        segments = decomposeEllipse(xRadius, yRadius);
+    } else {
+        if (xRadius > 0) {
+            segments << LineSegment{1, 0, xRadius};
+        }
+        if (yRadius > 0) {
+            segments << LineSegment{0, 1, yRadius};
+        }
+    }
+
+    return segments;
+}
+
+/**
+ * The van Herk/Gil-Werman algorithm: the line is split into blocks of
+ * the window size, then every window covers the suffix of one block
+ * and the prefix of the next one, which are precalculated.
+ */
+template <class Op>
+void runningExtremum(const quint8 *src, quint8 *dst, int length, int radius, quint8 outsideValue,
+                     quint8 *extended, quint8 *prefix, quint8 *suffix)
+{
+    const int windowSize = 2 * radius + 1;
+    const int extendedLength = length + 2 * radius;
+
+    memset(extended, outsideValue, radius);
+    memcpy(extended + radius, src, length);
+    memset(extended + radius + length, outsideValue, radius);
+
+    for (int i = 0; i < extendedLength; i++) {
+        prefix[i] = i % windowSize ? Op::apply(prefix[i - 1], extended[i]) : extended[i];
+    }
+
+    for (int i = extendedLength - 1; i >= 0; i--) {
+        suffix[i] = i == extendedLength - 1 || i % windowSize == windowSize - 1 ?
+            extended[i] : Op::apply(suffix[i + 1], extended[i]);
+    }
+
+    for (int i = 0; i < length; i++) {
+        dst[i] = Op::apply(suffix[i], prefix[i + windowSize - 1]);
+    }
+}
+
+template <class Op>
+void applySegment(quint8 *data, int width, int height, LineSegment segment, quint8 outsideValue)
+{
+    int dx = segment.dx;
+    int dy = segment.dy;
+
+    if (dx < 0 || (dx == 0 && dy < 0)) {
+        dx = -dx;
+        dy = -dy;
+    }
+
+    /**
+     * The lines start at the pixels whose predecessor along the
+     * direction lies outside the buffer
+     */
+    QVector<QPoint> starts;
+
+    for (int x = 0; x < qMin(dx, width); x++) {
+        for (int y = 0; y < height; y++) {
+            starts << QPoint(x, y);
+        }
+    }
+
+    const int firstRow = dy > 0 ? 0 : qMax(0, height + dy);
+    const int lastRow = dy > 0 ? qMin(dy, height) : height;
+
+    if (dy != 0) {
+        for (int x = dx; x < width; x++) {
+            for (int y = firstRow; y < lastRow; y++) {
+                starts << QPoint(x, y);
+            }
+        }
+    }
+
+    int maxLineLength = dx > 0 ? (width + dx - 1) / dx : height;
+    if (dy != 0) {
+        maxLineLength = qMin(maxLineLength, (height + qAbs(dy) - 1) / qAbs(dy));
+    }
+
+    const int linesPerJob = 64;
+    QVector<QPair<int, int>> jobs;
+    for (int i = 0; i < starts.size(); i += linesPerJob) {
+        jobs << qMakePair(i, qMin(i + linesPerJob, starts.size()));
+    }
+
+    QtConcurrent::blockingMap(jobs, [&] (const QPair<int, int> &job) {
+        QVector<quint8> line(maxLineLength);
+        QVector<quint8> result(maxLineLength);
+        QVector<quint8> extended(maxLineLength + 2 * segment.steps);
+        QVector<quint8> prefix(extended.size());
+        QVector<quint8> suffix(extended.size());
+
+        for (int i = job.first; i < job.second; i++) {
+            int x = starts[i].x();
+            int y = starts[i].y();
+            int length = 0;
+
+            while (x >= 0 && x < width && y >= 0 && y < height) {
+                line[length++] = data[y * width + x];
+                x += dx;
+                y += dy;
+            }
+
+            runningExtremum<Op>(line.constData(), result.data(), length, segment.steps, outsideValue,
+                                extended.data(), prefix.data(), suffix.data());
+
+            x = starts[i].x();
+            y = starts[i].y();
+
+            for (int j = 0; j < length; j++) {
+                data[y * width + x] = result[j];
+                x += dx;
+                y += dy;
+            }
+        }
+    });
+}
+
+}
+
+void KisMorphology::apply(KisPaintDeviceSP device, const QRect &rect,
+                          Operation operation, Shape shape,
+                          int xRadius, int yRadius,
+                          quint8 outsideValue)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(device->pixelSize() == 1);
+    if (rect.isEmpty()) return;
+
+    QVector<quint8> data(rect.width() * rect.height());
+    device->readBytes(data.data(), rect);
+
+    apply(data.data(), rect.width(), rect.height(), operation, shape, xRadius, yRadius, outsideValue);
+
+    device->writeBytes(data.constData(), rect);
+}
+
+void KisMorphology::apply(quint8 *data, int width, int height,
+                          Operation operation, Shape shape,
+                          int xRadius, int yRadius,
+                          quint8 outsideValue)
+{
+    const QVector<LineSegment> segments = decompose(shape, xRadius, yRadius);
+    if (segments.isEmpty() || width <= 0 || height <= 0) return;
+
+    /**
+     * The intermediate results of the passes spread outside the
+     * buffer, so the buffer is extended by the reach of the whole
+     * structuring element.
+     */
+    int xReach = 0;
+    int yReach = 0;
+
+    Q_FOREACH (const LineSegment &segment, segments) {
+        xReach += segment.steps * qAbs(segment.dx);
+        yReach += segment.steps * qAbs(segment.dy);
+    }
+
+    const int extendedWidth = width + 2 * xReach;
+    const int extendedHeight = height + 2 * yReach;
+
+    QVector<quint8> extended(extendedWidth * extendedHeight, outsideValue);
+
+    for (int y = 0; y < height; y++) {
+        memcpy(extended.data() + (y + yReach) * extendedWidth + xReach, data + y * width, width);
+    }
+
+    Q_FOREACH (const LineSegment &segment, segments) {
+        if (operation == Dilate) {
+            applySegment<MaxOp>(extended.data(), extendedWidth, extendedHeight, segment, outsideValue);
+        } else {
+            applySegment<MinOp>(extended.data(), extendedWidth, extendedHeight, segment, outsideValue);
+        }
+    }
+
+    for (int y = 0; y < height; y++) {
+        memcpy(data + y * width, extended.constData() + (y + yReach) * extendedWidth + xReach, width);
+    }
+}
+
+bool KisMorphology::isEllipseApproximationAccurate(int xRadius, int yRadius)
+{
+    const int minRadius = qMin(xRadius, yRadius);
+    const int maxRadius = qMax(xRadius, yRadius);
+
+    return minRadius > 32 && maxRadius <= 2 * minRadius;
+}
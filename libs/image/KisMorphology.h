@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KIS_MORPHOLOGY_H
+#define __KIS_MORPHOLOGY_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class QRect;
+
+/**
+ * Grayscale dilation and erosion of 8-bit masks (alpha devices and
+ * pixel selections) with flat structuring elements.
+ *
+ * Every structuring element is decomposed into a Minkowski sum of line
+ * segments, and every segment is applied with the van Herk/Gil-Werman
+ * running min/max, which costs three comparisons per pixel regardless
+ * of the segment length. The lines of every pass are processed in
+ * parallel.
+ *
+ * A rectangle is exactly a sum of a horizontal and a vertical segment.
+ * An ellipse is approximated with a 16-gon built from the segments in
+ * eight directions, (1,0), (2,1), (1,1), (1,2) and their mirrors. The
+ * error of the approximation is about 1-2% of the radius, so for small
+ * radii the exact per-pixel algorithms should be preferred.
+ */
+class KRITAIMAGE_EXPORT KisMorphology
+{
+public:
+    enum Operation {
+        Dilate,
+        Erode
+    };
+
+    enum Shape {
+        Rectangle,
+        Ellipse
+    };
+
+    /**
+     * Applies the operation to \p rect of \p device, which should have
+     * exactly one 8-bit channel. The pixels outside \p rect are treated
+     * as equal to \p outsideValue.
+     */
+    static void apply(KisPaintDeviceSP device, const QRect &rect,
+                      Operation operation, Shape shape,
+                      int xRadius, int yRadius,
+                      quint8 outsideValue = 0);
+
+    /**
+     * Same as above, but applied to a \p width x \p height buffer with
+     * no row padding.
+     */
+    static void apply(quint8 *data, int width, int height,
+                      Operation operation, Shape shape,
+                      int xRadius, int yRadius,
+                      quint8 outsideValue = 0);
+
+    /**
+     * \return true if the ellipse with the given radii is approximated
+     *         well enough to replace the exact algorithms, that is, the
+     *         radii are large and the ellipse is not too eccentric
+     */
+    static bool isEllipseApproximationAccurate(int xRadius, int yRadius);
+};
+
+#endif /* __KIS_MORPHOLOGY_H */
@@ -0,0 +1,347 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisMotionBlur.h"
+
+#include <cmath>
+
+#include <QRect>
+#include <QSize>
+#include <QBitArray>
+#include <QThread>
+#include <QVector>
+#include <QtConcurrent>
+#include <QtMath>
+
+#include <KoColorSpace.h>
+#include <KoUpdater.h>
+
+#include "kis_global.h"
+#include "kis_paint_device.h"
+#include "kis_default_bounds_base.h"
+#include "KisParallelFilterUtils.h"
+
+
+namespace {
+
+using KisParallelFilterUtils::ChannelsContext;
+
+/**
+ * The parameters of the motion in the coordinates of the lines: the
+ * major axis goes along the lines, the minor one across them
+ */
+struct Geometry
+{
+    Geometry(qreal length, qreal angle)
+    {
+        const qreal radians = kisDegreesToRadians(angle);
+
+        // the Y axis of the image goes down
+        const qreal dx = std::cos(radians);
+        const qreal dy = -std::sin(radians);
+
+        horizontal = qAbs(dx) >= qAbs(dy);
+
+        const qreal major = horizontal ? dx : dy;
+        const qreal minor = horizontal ? dy : dx;
+
+        slope = minor / major;
+
+        /**
+         * The segment follows the kernel the filter used to rasterize
+         * with QPainter: a line with square caps, so one pixel longer
+         * than the motion, centered at the top-left corner of the
+         * pixel along the axes it extends in. The weight of a sample is
+         * the overlap of its pixel with the projection of the segment
+         * on the major axis.
+         */
+        const qreal epsilon = 1e-6;
+        const qreal halfLength = 0.5 * (qMax(length, 0.0) + 1.0) * qAbs(major);
+        const qreal majorShift = -0.5;
+        const qreal minorShift = qAbs(length * minor) > epsilon ? -0.5 : 0.0;
+
+        const qreal start = majorShift - halfLength;
+        const qreal end = majorShift + halfLength;
+
+        firstTap = qFloor(start + 0.5);
+        lastTap = qCeil(end - 0.5);
+
+        if (firstTap == lastTap) {
+            firstWeight = end - start;
+            lastWeight = 0.0;
+        } else {
+            firstWeight = firstTap + 0.5 - start;
+            lastWeight = end - (lastTap - 0.5);
+        }
+
+        norm = 1.0 / (end - start);
+
+        /**
+         * The line c passes through the centers of the segments of the
+         * pixels (u, c + slope * u - lineOffset)
+         */
+        lineOffset = minorShift - slope * majorShift;
+    }
+
+    bool horizontal;
+    qreal slope;
+    qreal lineOffset;
+    int firstTap;
+    int lastTap;
+    qreal firstWeight;
+    qreal lastWeight;
+    qreal norm;
+};
+
+void processBlock(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                  const QRect &block, const QRect &dataRect,
+                  const Geometry &geometry, const ChannelsContext &ctx)
+{
+    const int numChannels = ctx.numChannels;
+    const int pixelSize = ctx.pixelSize;
+
+    const qreal slope = geometry.slope;
+    const qreal lineOffset = geometry.lineOffset;
+    const int span = geometry.lastTap - geometry.firstTap;
+
+    // the ranges of the block along and across the lines
+    const int u0 = geometry.horizontal ? block.left() : block.top();
+    const int v0 = geometry.horizontal ? block.top() : block.left();
+    const int uSize = geometry.horizontal ? block.width() : block.height();
+    const int vSize = geometry.horizontal ? block.height() : block.width();
+
+    /**
+     * Line c passes through the points (u, c + slope * u), so the
+     * lines are the same for all the blocks. The pixel (u, v) is
+     * interpolated from the two lines around v - slope * u + lineOffset.
+     */
+    const int u1 = u0 + uSize - 1;
+    const int firstLine = qFloor(v0 - qMax(slope * u0, slope * u1) + lineOffset);
+    const int lastLine = qFloor(v0 + vSize - 1 - qMin(slope * u0, slope * u1) + lineOffset) + 1;
+
+    const int uLoadStart = u0 + geometry.firstTap;
+    const int uLoadEnd = u1 + geometry.lastTap;
+    const int lineLength = uLoadEnd - uLoadStart + 1;
+
+    const int vLoadStart = qFloor(firstLine + qMin(slope * uLoadStart, slope * uLoadEnd));
+    const int vLoadEnd = qFloor(lastLine + qMax(slope * uLoadStart, slope * uLoadEnd)) + 1;
+
+    QRect loadRect = geometry.horizontal ?
+        QRect(QPoint(uLoadStart, vLoadStart), QPoint(uLoadEnd, vLoadEnd)) :
+        QRect(QPoint(vLoadStart, uLoadStart), QPoint(vLoadEnd, uLoadEnd));
+
+    if (dataRect.isValid()) {
+        loadRect &= dataRect;
+    }
+
+    QVector<qreal> input(loadRect.width() * loadRect.height() * numChannels);
+
+    {
+        QVector<quint8> bytes(loadRect.width() * loadRect.height() * pixelSize);
+        src->readBytes(bytes.data(), loadRect);
+        ctx.loadPixels(bytes.constData(), input.data(), loadRect.width() * loadRect.height());
+    }
+
+    /**
+     * The offsets of the samples in the loaded buffer, the positions
+     * outside of it repeat the border pixels
+     */
+    const int rowStride = loadRect.width() * numChannels;
+
+    const int uMin = geometry.horizontal ? loadRect.left() : loadRect.top();
+    const int uMax = geometry.horizontal ? loadRect.right() : loadRect.bottom();
+    const int uStride = geometry.horizontal ? numChannels : rowStride;
+    const int vMin = geometry.horizontal ? loadRect.top() : loadRect.left();
+    const int vMax = geometry.horizontal ? loadRect.bottom() : loadRect.right();
+    const int vStride = geometry.horizontal ? rowStride : numChannels;
+
+    QVector<int> uOffsets(lineLength);
+    for (int i = 0; i < lineLength; i++) {
+        uOffsets[i] = (qBound(uMin, uLoadStart + i, uMax) - uMin) * uStride;
+    }
+
+    // the strides of the block in the result buffer
+    const int outUStride = (geometry.horizontal ? 1 : block.width()) * numChannels;
+    const int outVStride = (geometry.horizontal ? block.width() : 1) * numChannels;
+
+    QVector<qreal> result(block.width() * block.height() * numChannels, 0.0);
+    QVector<qreal> line(lineLength * numChannels);
+    QVector<qreal> boxSum(numChannels);
+    QVector<qreal> filtered(numChannels);
+
+    for (int c = firstLine; c <= lastLine; c++) {
+
+        // resample the line from the image
+        for (int i = 0; i < lineLength; i++) {
+            const qreal v = c + slope * (uLoadStart + i);
+            const int vFloor = qFloor(v);
+            const qreal weight = v - vFloor;
+
+            const qreal *ptr0 = input.constData() + uOffsets[i] + (qBound(vMin, vFloor, vMax) - vMin) * vStride;
+            const qreal *ptr1 = input.constData() + uOffsets[i] + (qBound(vMin, vFloor + 1, vMax) - vMin) * vStride;
+
+            qreal *dstPtr = line.data() + i * numChannels;
+            for (int ch = 0; ch < numChannels; ch++) {
+                dstPtr[ch] = ptr0[ch] + weight * (ptr1[ch] - ptr0[ch]);
+            }
+        }
+
+        /**
+         * The running sum of the inner samples of the segment of the
+         * pixel du, the outermost samples line[du] and line[du + span]
+         * are added with their fractional weights
+         */
+        boxSum.fill(0.0);
+        for (int i = 1; i < span; i++) {
+            for (int ch = 0; ch < numChannels; ch++) {
+                boxSum[ch] += line[i * numChannels + ch];
+            }
+        }
+
+        for (int du = 0; du < uSize; du++) {
+            if (du > 0 && span > 1) {
+                const qreal *addPtr = line.constData() + (du + span - 1) * numChannels;
+                const qreal *removePtr = line.constData() + du * numChannels;
+
+                for (int ch = 0; ch < numChannels; ch++) {
+                    boxSum[ch] += addPtr[ch] - removePtr[ch];
+                }
+            }
+
+            const qreal *firstPtr = line.constData() + du * numChannels;
+            const qreal *lastPtr = line.constData() + (du + span) * numChannels;
+
+            for (int ch = 0; ch < numChannels; ch++) {
+                filtered[ch] = (boxSum[ch] +
+                                geometry.firstWeight * firstPtr[ch] +
+                                geometry.lastWeight * lastPtr[ch]) * geometry.norm;
+            }
+
+            /**
+             * Shear the line back: its value is distributed between
+             * the two pixels around its position across the lines
+             */
+            const qreal v = c + slope * (u0 + du) - lineOffset;
+            const int vCeil = qCeil(v);
+            const qreal lowerWeight = vCeil - v;
+
+            qreal *dstPtr = result.data() + du * outUStride;
+
+            if (vCeil >= v0 && vCeil < v0 + vSize) {
+                qreal *ptr = dstPtr + (vCeil - v0) * outVStride;
+                for (int ch = 0; ch < numChannels; ch++) {
+                    ptr[ch] += (1.0 - lowerWeight) * filtered[ch];
+                }
+            }
+
+            if (lowerWeight > 0.0 && vCeil - 1 >= v0 && vCeil - 1 < v0 + vSize) {
+                qreal *ptr = dstPtr + (vCeil - 1 - v0) * outVStride;
+                for (int ch = 0; ch < numChannels; ch++) {
+                    ptr[ch] += lowerWeight * filtered[ch];
+                }
+            }
+        }
+    }
+
+    /**
+     * The channels excluded by the channel flags are taken from the
+     * source pixels
+     */
+    QVector<quint8> dstBytes(block.width() * block.height() * pixelSize);
+    src->readBytes(dstBytes.data(), block);
+    ctx.storePixels(result.constData(), dstBytes.data(), block.width() * block.height());
+
+    dst->writeBytes(dstBytes.constData(), block);
+}
+
+}
+
+QSize KisMotionBlur::kernelMargins(qreal length, qreal angle)
+{
+    const Geometry geometry(length, angle);
+
+    const int majorMargin = qMax(-geometry.firstTap, geometry.lastTap);
+
+    // one more pixel across the lines is touched by the interpolation
+    const int minorMargin =
+        qCeil(qMax(qAbs(geometry.lineOffset + geometry.slope * geometry.firstTap),
+                   qAbs(geometry.lineOffset + geometry.slope * geometry.lastTap))) + 1;
+
+    return geometry.horizontal ?
+        QSize(majorMargin, minorMargin) :
+        QSize(minorMargin, majorMargin);
+}
+
+bool KisMotionBlur::applyMotionBlur(KisPaintDeviceSP device,
+                                    const QRect& rect,
+                                    qreal length, qreal angle,
+                                    const QBitArray &channelFlags,
+                                    KoUpdater *progressUpdater)
+{
+    ChannelsContext ctx;
+    if (!ctx.init(device->colorSpace(), channelFlags)) return false;
+
+    if (!ctx.numChannels || rect.isEmpty() || length <= 0.0) return true;
+
+    /**
+     * In wraparound mode the device returns the wrapped pixels itself,
+     * so the source is never clipped.
+     */
+    const bool wrapAround = device->defaultBounds()->wrapAroundMode();
+    const QRect dataRect = wrapAround ? QRect() : rect | device->exactBounds();
+
+    const Geometry geometry(length, angle);
+
+    /**
+     * Every block resamples the lines crossing it together with the
+     * margins along them, so the blocks are made square (the lines of
+     * a diagonal motion cross a block on both sides) and large enough
+     * to keep the margins small compared to the block.
+     */
+    const int tileSize = 64;
+    const int maxBlockSize = 1024;
+    const int reach = qMax(-geometry.firstTap, geometry.lastTap);
+    const int blockSize = qBound(tileSize, (4 * reach + tileSize - 1) / tileSize * tileSize, maxBlockSize);
+
+    const QVector<QRect> blocks = KisParallelFilterUtils::splitIntoBlocks(rect, blockSize);
+
+    // the blocks read the areas written by their neighbours
+    KisPaintDeviceSP src = new KisPaintDevice(*device);
+
+    const int batchSize = qMax(1, QThread::idealThreadCount());
+
+    if (progressUpdater) {
+        progressUpdater->setRange(0, blocks.size());
+        progressUpdater->setValue(0);
+    }
+
+    for (int i = 0; i < blocks.size(); i += batchSize) {
+        QVector<QRect> batch = blocks.mid(i, batchSize);
+
+        QtConcurrent::blockingMap(batch, [&] (const QRect &block) {
+            processBlock(src, device, block, dataRect, geometry, ctx);
+        });
+
+        if (progressUpdater) {
+            progressUpdater->setValue(i + batch.size());
+            if (progressUpdater->interrupted()) break;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KIS_MOTION_BLUR_H
+#define __KIS_MOTION_BLUR_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class QRect;
+class QSize;
+class QBitArray;
+class KoUpdater;
+
+/**
+ * A linear motion blur engine. The blur is the average of the image
+ * along a segment of the given length and direction, which is
+ * calculated with a shear decomposition: the image is resampled along
+ * the lines parallel to the motion, every line is filtered with a
+ * running box sum and the result is sheared back. The cost per pixel
+ * does not depend on the length of the blur.
+ *
+ * The segment is the one the filter used to rasterize with QPainter: it
+ * is one pixel longer than the motion because of the square caps of the
+ * pen and passes through the top-left corner of the pixel, so the
+ * results of the filter do not shift.
+ *
+ * The lines go along the axis closest to the direction of the motion,
+ * so the shear is never steeper than 45 degrees. The linear
+ * interpolation of the two resampling steps softens the result across
+ * the motion by at most one pixel; for horizontal, vertical and
+ * diagonal motion both steps are exact.
+ *
+ * The rect is processed in tile-aligned blocks in parallel. The border
+ * handling follows BORDER_REPEAT of the convolution painter, the same
+ * way KisRecursiveGaussianBlur does.
+ */
+class KRITAIMAGE_EXPORT KisMotionBlur
+{
+public:
+    /**
+     * \return the distance the blur can spread the pixels to along
+     *         each of the axes
+     */
+    static QSize kernelMargins(qreal length, qreal angle);
+
+    /**
+     * Blurs \p rect of \p device in-place
+     *
+     * \param length the length of the motion segment in pixels
+     * \param angle the direction of the motion in degrees,
+     *        counterclockwise from the positive X axis
+     *
+     * \return false if the color space of the device cannot be
+     *         processed by the engine. The device is not touched then.
+     */
+    static bool applyMotionBlur(KisPaintDeviceSP device,
+                                const QRect& rect,
+                                qreal length, qreal angle,
+                                const QBitArray &channelFlags,
+                                KoUpdater *progressUpdater);
+};
+
+#endif /* __KIS_MOTION_BLUR_H */
@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KIS_PARALLEL_FILTER_UTILS_H
+#define __KIS_PARALLEL_FILTER_UTILS_H
+
+#include <QBitArray>
+#include <QList>
+#include <QPair>
+#include <QRect>
+#include <QVector>
+
+#include <KoChannelInfo.h>
+#include <KoColorSpace.h>
+
+#include "kis_assert.h"
+#include "kis_math_toolbox.h"
+
+/**
+ * Helpers shared by the filter engines that process a device in
+ * tile-aligned pieces in parallel (KisRecursiveGaussianBlur,
+ * KisSlidingHistogram, KisBokehBlur, KisMotionBlur, KisAtrousWavelet)
+ */
+namespace KisParallelFilterUtils
+{
+
+/**
+ * Converts the pixels of the device into premultiplied doubles and
+ * back in exactly the same way KisConvolutionWorkerSpatial does it.
+ */
+struct ChannelsContext
+{
+    bool init(const KoColorSpace *cs, QBitArray channelFlags) {
+        pixelSize = cs->pixelSize();
+
+        if (channelFlags.isEmpty()) {
+            channelFlags = QBitArray(cs->channelCount(), true);
+        }
+        KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(channelFlags.size() == int(cs->channelCount()), false);
+
+        QList<KoChannelInfo *> channelInfo = cs->channels();
+        for (int i = 0; i < channelInfo.size(); i++) {
+            if (!channelFlags.testBit(i)) continue;
+
+            if (channelInfo[i]->channelType() == KoChannelInfo::ALPHA) {
+                alphaIndex = channels.size();
+            }
+
+            channels.append(channelInfo[i]);
+            positions.append(channelInfo[i]->pos());
+        }
+
+        numChannels = channels.size();
+
+        KisMathToolbox mathToolbox;
+        toDouble = QVector<PtrToDouble>(numChannels);
+        if (!mathToolbox.getToDoubleChannelPtr(channels, toDouble)) return false;
+
+        fromDouble = QVector<PtrFromDouble>(numChannels);
+        if (!mathToolbox.getFromDoubleChannelPtr(channels, fromDouble)) return false;
+
+        for (int i = 0; i < numChannels; i++) {
+            minClamp.append(mathToolbox.minChannelValue(channels[i]));
+            maxClamp.append(mathToolbox.maxChannelValue(channels[i]));
+        }
+
+        return true;
+    }
+
+    void loadPixels(const quint8 *src, qreal *dst, int numPixels) const {
+        for (int i = 0; i < numPixels; i++) {
+            // no alpha is rare case, so just multiply by 1.0 in that case
+            const qreal alpha = alphaIndex >= 0 ? toDouble[alphaIndex](src, positions[alphaIndex]) : 1.0;
+
+            for (int k = 0; k < numChannels; k++) {
+                dst[k] = k == alphaIndex ? alpha : toDouble[k](src, positions[k]) * alpha;
+            }
+
+            src += pixelSize;
+            dst += numChannels;
+        }
+    }
+
+    inline qreal clampValue(qreal value, int channel) const {
+        if (value > maxClamp[channel]) {
+            value = maxClamp[channel];
+        } else if (!(value >= minClamp[channel])) { // value < min or value == NaN
+            value = minClamp[channel];
+        }
+        return value;
+    }
+
+    /**
+     * Writes the filtered channels into \p dst. The channels excluded
+     * by the channel flags are expected to be already there.
+     */
+    void storePixels(const qreal *src, quint8 *dst, int numPixels) const {
+        for (int i = 0; i < numPixels; i++) {
+            if (alphaIndex >= 0) {
+                const qreal alpha = clampValue(src[alphaIndex], alphaIndex);
+                fromDouble[alphaIndex](dst, positions[alphaIndex], alpha);
+
+                const qreal alphaInv = alpha != 0.0 ? 1.0 / alpha : 0.0;
+
+                for (int k = 0; k < numChannels; k++) {
+                    if (k == alphaIndex) continue;
+                    fromDouble[k](dst, positions[k], clampValue(src[k] * alphaInv, k));
+                }
+            } else {
+                for (int k = 0; k < numChannels; k++) {
+                    fromDouble[k](dst, positions[k], clampValue(src[k], k));
+                }
+            }
+
+            src += numChannels;
+            dst += pixelSize;
+        }
+    }
+
+    int pixelSize = 0;
+    int numChannels = 0;
+    int alphaIndex = -1;
+    QList<KoChannelInfo *> channels;
+    QVector<int> positions;
+    QVector<PtrToDouble> toDouble;
+    QVector<PtrFromDouble> fromDouble;
+    QVector<qreal> minClamp;
+    QVector<qreal> maxClamp;
+};
+
+/**
+ * Splits \p rc into strips along the tile grid, so that no two strips
+ * processed in parallel ever write into the same tile.
+ */
+inline QVector<QRect> splitIntoStrips(const QRect &rc, Qt::Orientation orientation)
+{
+    const int tileSize = 64;
+
+    const int start = orientation == Qt::Horizontal ? rc.top() : rc.left();
+    const int end = orientation == Qt::Horizontal ? rc.bottom() + 1 : rc.right() + 1;
+
+    QVector<QRect> strips;
+
+    int pos = start;
+    while (pos < end) {
+        const int tileStart = pos >= 0 ? pos / tileSize * tileSize : -((-pos + tileSize - 1) / tileSize * tileSize);
+        const int next = qMin(tileStart + tileSize, end);
+
+        strips << (orientation == Qt::Horizontal ?
+                   QRect(rc.left(), pos, rc.width(), next - pos) :
+                   QRect(pos, rc.top(), next - pos, rc.height()));
+        pos = next;
+    }
+
+    return strips;
+}
+
+/**
+ * Splits \p rc into the blocks of \p blockSize, aligned to the grid
+ * of the same size (which should be a multiple of the tile size)
+ */
+inline QVector<QRect> splitIntoBlocks(const QRect &rc, int blockSize)
+{
+    auto splitRange = [blockSize] (int start, int end) {
+        QVector<QPair<int, int>> ranges;
+
+        int pos = start;
+        while (pos <= end) {
+            const int blockStart = pos >= 0 ? pos / blockSize * blockSize : -((-pos + blockSize - 1) / blockSize * blockSize);
+            const int next = qMin(blockStart + blockSize, end + 1);
+
+            ranges << qMakePair(pos, next - pos);
+            pos = next;
+        }
+
+        return ranges;
+    };
+
+    const QVector<QPair<int, int>> rows = splitRange(rc.top(), rc.bottom());
+    const QVector<QPair<int, int>> columns = splitRange(rc.left(), rc.right());
+
+    QVector<QRect> blocks;
+
+    Q_FOREACH (const auto &row, rows) {
+        Q_FOREACH (const auto &column, columns) {
+            blocks << QRect(column.first, row.first, column.second, row.second);
+        }
+    }
+
+    return blocks;
+}
+
+}
+
+#endif /* __KIS_PARALLEL_FILTER_UTILS_H */
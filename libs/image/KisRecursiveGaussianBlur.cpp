@@ -0,0 +1,335 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisRecursiveGaussianBlur.h"
+
+#include <algorithm>
+
+#include <QRect>
+#include <QBitArray>
+#include <QVector>
+#include <QtConcurrent>
+#include <QtMath>
+
+#include <KoColorSpace.h>
+#include <KoUpdater.h>
+
+#include "kis_global.h"
+#include "kis_paint_device.h"
+#include "kis_default_bounds_base.h"
+#include "kis_math_toolbox.h"
+#include "kis_gaussian_kernel.h"
+#include "KisParallelFilterUtils.h"
+
+
+namespace {
+
+using KisParallelFilterUtils::ChannelsContext;
+using KisParallelFilterUtils::splitIntoStrips;
+
+/**
+ * Coefficients of the recursive filter from "Recursive implementation
+ * of the Gaussian filter" by I. T. Young and L. J. van Vliet (1995).
+ * The feedback coefficients are already normalized by b0, so the gain
+ * of the filter for a constant signal is exactly one.
+ */
+struct RecursiveCoefficients
+{
+    RecursiveCoefficients(qreal sigma) {
+        sigma = qMax(sigma, 0.5);
+
+        const qreal q = sigma >= 2.5 ?
+            0.98711 * sigma - 0.96330 :
+            3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma);
+
+        const qreal q2 = pow2(q);
+        const qreal q3 = q2 * q;
+
+        const qreal b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+
+        b1 = (2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+        b2 = -(1.4281 * q2 + 1.26661 * q3) / b0;
+        b3 = 0.422205 * q3 / b0;
+        B = 1.0 - (b1 + b2 + b3);
+
+        /**
+         * The line is virtually extended with its last input sample, as
+         * proposed by B. Triggs and M. Sdika in "Boundary conditions for
+         * Young-van Vliet recursive filtering" (2006). The history of the
+         * backward pass is then a linear function of the last three
+         * samples of the forward pass. The matrix of the function is
+         * found by running both passes over the extension for every unit
+         * state of the forward pass.
+         */
+        const int extensionLength = 20 * qCeil(sigma) + 50;
+        QVector<qreal> forward(extensionLength);
+
+        for (int k = 0; k < 3; k++) {
+            qreal w[3] = {0.0, 0.0, 0.0};
+            w[k] = 1.0;
+
+            for (int i = 0; i < extensionLength; i++) {
+                forward[i] = b1 * w[0] + b2 * w[1] + b3 * w[2];
+                w[2] = w[1];
+                w[1] = w[0];
+                w[0] = forward[i];
+            }
+
+            qreal y[3] = {0.0, 0.0, 0.0};
+
+            for (int i = extensionLength - 1; i >= 0; i--) {
+                const qreal value = B * forward[i] + b1 * y[0] + b2 * y[1] + b3 * y[2];
+                y[2] = y[1];
+                y[1] = y[0];
+                y[0] = value;
+            }
+
+            for (int i = 0; i < 3; i++) {
+                M[i][k] = y[i];
+            }
+        }
+    }
+
+    qreal B;
+    qreal b1;
+    qreal b2;
+    qreal b3;
+    qreal M[3][3];
+};
+
+/**
+ * Runs the forward and backward recursion over \p length samples of
+ * \p data. Each sample consists of \p count contiguous values, the
+ * samples are \p stride values apart.
+ */
+void filterLine(qreal *data, int length, int stride, int count, const RecursiveCoefficients &c)
+{
+    if (length <= 0 || count <= 0) return;
+
+    QVector<qreal> leftBorder(count);
+    QVector<qreal> rightBorder(count);
+    QVector<qreal> backwardHistory(3 * count);
+
+    /**
+     * Before the line the recursion starts in its steady state for a
+     * constant signal, which is the border sample itself.
+     */
+    std::copy(data, data + count, leftBorder.begin());
+
+    const qreal *last = data + (length - 1) * stride;
+    std::copy(last, last + count, rightBorder.begin());
+
+    const qreal *p1 = leftBorder.constData();
+    const qreal *p2 = p1;
+    const qreal *p3 = p1;
+
+    for (int i = 0; i < length; i++) {
+        qreal *ptr = data + i * stride;
+
+        for (int k = 0; k < count; k++) {
+            ptr[k] = c.B * ptr[k] + c.b1 * p1[k] + c.b2 * p2[k] + c.b3 * p3[k];
+        }
+
+        p3 = p2;
+        p2 = p1;
+        p1 = ptr;
+    }
+
+    const qreal *w[3] = {p1, p2, p3};
+
+    for (int i = 0; i < 3; i++) {
+        qreal *history = backwardHistory.data() + i * count;
+
+        for (int k = 0; k < count; k++) {
+            const qreal edge = rightBorder[k];
+            history[k] = edge +
+                c.M[i][0] * (w[0][k] - edge) +
+                c.M[i][1] * (w[1][k] - edge) +
+                c.M[i][2] * (w[2][k] - edge);
+        }
+    }
+
+    p1 = backwardHistory.constData();
+    p2 = p1 + count;
+    p3 = p2 + count;
+
+    for (int i = length - 1; i >= 0; i--) {
+        qreal *ptr = data + i * stride;
+
+        for (int k = 0; k < count; k++) {
+            ptr[k] = c.B * ptr[k] + c.b1 * p1[k] + c.b2 * p2[k] + c.b3 * p3[k];
+        }
+
+        p3 = p2;
+        p2 = p1;
+        p1 = ptr;
+    }
+}
+
+/**
+ * Blurs the rows of \p dstRect. The source row is read with the
+ * margin of the convolution kernel, clipped by \p dataRect (unless
+ * it is null). Everything outside the clipped range is considered to
+ * repeat the border pixel.
+ */
+void horizontalPass(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                    const QRect &dstRect, const QRect &dataRect,
+                    qreal radius, const ChannelsContext &ctx)
+{
+    const int margin = KisGaussianKernel::kernelSizeFromRadius(radius) / 2;
+    const RecursiveCoefficients coeffs(KisGaussianKernel::sigmaFromRadius(radius));
+
+    int inputLeft = dstRect.left() - margin;
+    int inputRight = dstRect.right() + margin;
+
+    if (dataRect.isValid()) {
+        inputLeft = qMax(inputLeft, dataRect.left());
+        inputRight = qMin(inputRight, dataRect.right());
+    }
+
+    const int inputWidth = inputRight - inputLeft + 1;
+    const int dstOffset = dstRect.left() - inputLeft;
+    const int pixelSize = ctx.pixelSize;
+    const int numChannels = ctx.numChannels;
+
+    QVector<QRect> strips = splitIntoStrips(dstRect, Qt::Horizontal);
+
+    QtConcurrent::blockingMap(strips, [&] (const QRect &strip) {
+        QVector<quint8> srcBytes(inputWidth * strip.height() * pixelSize);
+        QVector<quint8> dstBytes(dstRect.width() * strip.height() * pixelSize);
+        QVector<qreal> line(inputWidth * numChannels);
+
+        src->readBytes(srcBytes.data(), inputLeft, strip.y(), inputWidth, strip.height());
+
+        for (int row = 0; row < strip.height(); row++) {
+            const quint8 *srcRow = srcBytes.constData() + row * inputWidth * pixelSize;
+            quint8 *dstRow = dstBytes.data() + row * dstRect.width() * pixelSize;
+
+            ctx.loadPixels(srcRow, line.data(), inputWidth);
+            filterLine(line.data(), inputWidth, numChannels, numChannels, coeffs);
+
+            memcpy(dstRow, srcRow + dstOffset * pixelSize, dstRect.width() * pixelSize);
+            ctx.storePixels(line.constData() + dstOffset * numChannels, dstRow, dstRect.width());
+        }
+
+        dst->writeBytes(dstBytes.constData(), dstRect.x(), strip.y(), dstRect.width(), strip.height());
+    });
+}
+
+/**
+ * Blurs the columns of \p dstRect. A strip of columns is loaded as a
+ * whole, then the recursion runs over its rows, so that all the
+ * columns and channels of a row are filtered in a single loop.
+ */
+void verticalPass(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                  const QRect &dstRect, const QRect &dataRect,
+                  qreal radius, const ChannelsContext &ctx)
+{
+    const int margin = KisGaussianKernel::kernelSizeFromRadius(radius) / 2;
+    const RecursiveCoefficients coeffs(KisGaussianKernel::sigmaFromRadius(radius));
+
+    int inputTop = dstRect.top() - margin;
+    int inputBottom = dstRect.bottom() + margin;
+
+    if (dataRect.isValid()) {
+        inputTop = qMax(inputTop, dataRect.top());
+        inputBottom = qMin(inputBottom, dataRect.bottom());
+    }
+
+    const int inputHeight = inputBottom - inputTop + 1;
+    const int dstOffset = dstRect.top() - inputTop;
+    const int pixelSize = ctx.pixelSize;
+    const int numChannels = ctx.numChannels;
+
+    QVector<QRect> strips = splitIntoStrips(dstRect, Qt::Vertical);
+
+    QtConcurrent::blockingMap(strips, [&] (const QRect &strip) {
+        const int numPixels = inputHeight * strip.width();
+        const int rowValues = strip.width() * numChannels;
+
+        QVector<quint8> bytes(numPixels * pixelSize);
+        QVector<qreal> values(numPixels * numChannels);
+
+        src->readBytes(bytes.data(), strip.x(), inputTop, strip.width(), inputHeight);
+
+        ctx.loadPixels(bytes.constData(), values.data(), numPixels);
+        filterLine(values.data(), inputHeight, rowValues, rowValues, coeffs);
+
+        quint8 *dstBytes = bytes.data() + dstOffset * strip.width() * pixelSize;
+        ctx.storePixels(values.constData() + dstOffset * rowValues, dstBytes, dstRect.height() * strip.width());
+
+        dst->writeBytes(dstBytes, strip.x(), dstRect.y(), strip.width(), dstRect.height());
+    });
+}
+
+}
+
+bool KisRecursiveGaussianBlur::applyGaussian(KisPaintDeviceSP device,
+                                             const QRect& rect,
+                                             qreal xRadius, qreal yRadius,
+                                             const QBitArray &channelFlags,
+                                             KoUpdater *progressUpdater)
+{
+    ChannelsContext ctx;
+    if (!ctx.init(device->colorSpace(), channelFlags)) return false;
+
+    if (!ctx.numChannels || rect.isEmpty()) return true;
+
+    /**
+     * In wraparound mode the device returns the wrapped pixels itself,
+     * so the source is never clipped.
+     */
+    const bool wrapAround = device->defaultBounds()->wrapAroundMode();
+    const QRect dataRect = wrapAround ? QRect() : rect | device->exactBounds();
+
+    const int numPasses = int(xRadius > 0.0) + int(yRadius > 0.0);
+    if (progressUpdater) {
+        progressUpdater->setRange(0, numPasses);
+        progressUpdater->setValue(0);
+    }
+
+    if (xRadius > 0.0 && yRadius > 0.0) {
+        const int yMargin = KisGaussianKernel::kernelSizeFromRadius(yRadius) / 2;
+
+        QRect intermRect = rect.adjusted(0, -yMargin, 0, yMargin);
+        if (dataRect.isValid()) {
+            intermRect &= dataRect;
+        }
+
+        KisPaintDeviceSP interm = new KisPaintDevice(device->colorSpace());
+        horizontalPass(device, interm, intermRect, dataRect, xRadius, ctx);
+
+        if (progressUpdater) {
+            progressUpdater->setValue(1);
+            if (progressUpdater->interrupted()) return true;
+        }
+
+        verticalPass(interm, device, rect, intermRect, yRadius, ctx);
+
+    } else if (xRadius > 0.0) {
+        horizontalPass(device, device, rect, dataRect, xRadius, ctx);
+    } else if (yRadius > 0.0) {
+        verticalPass(device, device, rect, dataRect, yRadius, ctx);
+    }
+
+    if (progressUpdater) {
+        progressUpdater->setValue(numPasses);
+    }
+
+    return true;
+}
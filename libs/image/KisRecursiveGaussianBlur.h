@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KIS_RECURSIVE_GAUSSIAN_BLUR_H
+#define __KIS_RECURSIVE_GAUSSIAN_BLUR_H
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class QRect;
+class QBitArray;
+class KoUpdater;
+
+/**
+ * A Gaussian blur engine based on the third order recursive (IIR)
+ * filter by Young and van Vliet. The cost of the filter does not
+ * depend on the radius of the blur: every pass is a forward and a
+ * backward run of a 3-tap recursion over the line, so it is used
+ * instead of KisConvolutionPainter when the kernel becomes large.
+ *
+ * The passes are processed in tile-aligned strips in parallel. Every
+ * strip is loaded into a premultiplied buffer of doubles, where all
+ * the channels (and, for the vertical pass, all the columns) of a
+ * sample are filtered in one contiguous inner loop.
+ *
+ * The border handling follows BORDER_REPEAT of the convolution
+ * painter: the pixels outside the union of the requested rect and
+ * the device's exact bounds repeat the closest border pixel.
+ */
+class KRITAIMAGE_EXPORT KisRecursiveGaussianBlur
+{
+public:
+    /**
+     * Blurs \p rect of \p device in-place. The radii have the same
+     * meaning as in KisGaussianKernel::applyGaussian().
+     *
+     * \return false if the color space of the device cannot be
+     *         processed by the engine. The device is not touched then.
+     */
+    static bool applyGaussian(KisPaintDeviceSP device,
+                              const QRect& rect,
+                              qreal xRadius, qreal yRadius,
+                              const QBitArray &channelFlags,
+                              KoUpdater *progressUpdater);
+};
+
+#endif /* __KIS_RECURSIVE_GAUSSIAN_BLUR_H */
@@ -0,0 +1,305 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisSlidingHistogram.h"
+
+#include <QRect>
+#include <QThread>
+#include <QtMath>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <KoColorSpace.h>
+#include <KoUpdater.h>
+
+#include "kis_global.h"
+#include "kis_paint_device.h"
+#include "KisParallelFilterUtils.h"
+
+
+int KisSlidingHistogram::Window::modeBin() const
+{
+    int result = -1;
+    int maxCount = 0;
+
+    for (int i = 0; i < m_numBins; i++) {
+        if (m_counts[i] > maxCount) {
+            maxCount = m_counts[i];
+            result = i;
+        }
+    }
+
+    return result;
+}
+
+int KisSlidingHistogram::Window::percentileBin(qreal fraction) const
+{
+    if (!m_totalCount) return -1;
+
+    const int target = qBound(1, qCeil(fraction * m_totalCount), m_totalCount);
+
+    int cumulativeCount = 0;
+    for (int i = 0; i < m_numBins; i++) {
+        cumulativeCount += m_counts[i];
+        if (cumulativeCount >= target) return i;
+    }
+
+    return m_numBins - 1;
+}
+
+namespace {
+
+/**
+ * Histograms of the columns of the input rect and of the window
+ */
+struct HistogramState
+{
+    HistogramState(int numColumns, int numBins, int numChannels)
+        : numBins(numBins),
+          numChannels(numChannels),
+          columnCounts(numColumns * numBins, 0),
+          columnSums(numChannels ? numColumns * numBins * numChannels : 0, 0.0),
+          windowCounts(numBins, 0),
+          windowSums(numBins * numChannels, 0.0)
+    {
+    }
+
+    inline void updateColumn(int column, int bin, const double *values, int sign) {
+        columnCounts[column * numBins + bin] += sign;
+
+        double *sums = columnSums.data() + (column * numBins + bin) * numChannels;
+        for (int i = 0; i < numChannels; i++) {
+            sums[i] += sign * values[i];
+        }
+    }
+
+    inline void updateWindow(int column, int sign) {
+        const int *counts = columnCounts.constData() + column * numBins;
+        for (int i = 0; i < numBins; i++) {
+            windowCounts[i] += sign * counts[i];
+        }
+
+        const double *sums = columnSums.constData() + column * numBins * numChannels;
+        const int numValues = numBins * numChannels;
+        for (int i = 0; i < numValues; i++) {
+            windowSums[i] += sign * sums[i];
+        }
+    }
+
+    void resetWindow() {
+        windowCounts.fill(0);
+        windowSums.fill(0.0);
+    }
+
+    const int numBins;
+    const int numChannels;
+
+    QVector<int> columnCounts;
+    QVector<double> columnSums;
+
+    QVector<int> windowCounts;
+    QVector<double> windowSums;
+};
+
+/**
+ * Returns the ranges to remove from and to add to the [oldStart,
+ * oldEnd] range to make it [newStart, newEnd], provided that both
+ * ranges move forward only.
+ */
+template <class RemoveFunc, class AddFunc>
+inline void slideRange(int oldStart, int oldEnd, int newStart, int newEnd,
+                       RemoveFunc removeFunc, AddFunc addFunc)
+{
+    for (int i = oldStart; i <= qMin(oldEnd, newStart - 1); i++) {
+        removeFunc(i);
+    }
+
+    for (int i = qMax(oldEnd + 1, newStart); i <= newEnd; i++) {
+        addFunc(i);
+    }
+}
+
+}
+
+void KisSlidingHistogram::apply(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                                const QRect &applyRect, const QRect &sourceRect,
+                                int radius, int numBins, bool accumulateChannels,
+                                BinFunction binFunction, ResultFunction resultFunction,
+                                KoUpdater *progressUpdater)
+{
+    const int pixelSize = src->pixelSize();
+
+    auto bulkBinFunction = [binFunction, pixelSize] (const quint8 *pixels, int numPixels, int *bins) mutable {
+        for (int i = 0; i < numPixels; i++) {
+            bins[i] = binFunction(pixels + i * pixelSize);
+        }
+    };
+
+    applyWithBulkBins(src, dst, applyRect, sourceRect,
+                      radius, numBins, accumulateChannels,
+                      bulkBinFunction, resultFunction,
+                      progressUpdater);
+}
+
+void KisSlidingHistogram::applyWithBulkBins(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                                            const QRect &applyRect, const QRect &sourceRect,
+                                            int radius, int numBins, bool accumulateChannels,
+                                            BulkBinFunction binFunction, ResultFunction resultFunction,
+                                            KoUpdater *progressUpdater)
+{
+    if (applyRect.isEmpty()) return;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(radius >= 0);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(numBins > 0);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(*src->colorSpace() == *dst->colorSpace());
+
+    /**
+     * The strips read the areas written by their neighbours, so in-place
+     * filtering needs a snapshot of the source
+     */
+    KisPaintDeviceSP source = src == dst ? new KisPaintDevice(*src) : src;
+
+    const KoColorSpace *cs = source->colorSpace();
+    const int pixelSize = cs->pixelSize();
+    const int numChannels = accumulateChannels ? cs->channelCount() : 0;
+
+    auto processStrip = [&] (const QRect &strip) {
+        BulkBinFunction stripBinFunction = binFunction;
+        ResultFunction stripResultFunction = resultFunction;
+
+        const QRect inputRect = kisGrowRect(strip, radius) & sourceRect;
+
+        QVector<int> bins(inputRect.width() * inputRect.height());
+        QVector<double> values(bins.size() * numChannels);
+
+        if (!inputRect.isEmpty()) {
+            QVector<quint8> inputBytes(bins.size() * pixelSize);
+            source->readBytes(inputBytes.data(), inputRect);
+
+            stripBinFunction(inputBytes.constData(), bins.size(), bins.data());
+
+            QVector<float> channels(cs->channelCount());
+
+            for (int i = 0; i < bins.size(); i++) {
+                const quint8 *pixel = inputBytes.constData() + i * pixelSize;
+                bins[i] = qBound(0, bins[i], numBins - 1);
+
+                if (numChannels) {
+                    cs->normalisedChannelsValue(pixel, channels);
+                    std::copy(channels.begin(), channels.end(), values.begin() + i * numChannels);
+                }
+            }
+        }
+
+        QVector<quint8> srcBytes(strip.width() * strip.height() * pixelSize);
+        source->readBytes(srcBytes.data(), strip);
+
+        QVector<quint8> dstBytes(srcBytes.size());
+
+        HistogramState state(inputRect.width(), numBins, numChannels);
+
+        Window window;
+        window.m_numBins = numBins;
+        window.m_numChannels = numChannels;
+        window.m_counts = state.windowCounts.constData();
+        window.m_sums = numChannels ? state.windowSums.constData() : 0;
+
+        auto updateRow = [&] (int row, int sign) {
+            const int offset = (row - inputRect.top()) * inputRect.width();
+            for (int column = 0; column < inputRect.width(); column++) {
+                state.updateColumn(column, bins[offset + column],
+                                   values.constData() + (offset + column) * numChannels,
+                                   sign);
+            }
+        };
+
+        int rowsTop = 0;
+        int rowsBottom = -1;
+
+        for (int y = strip.top(); y <= strip.bottom(); y++) {
+            const int newTop = qMax(y - radius, inputRect.top());
+            const int newBottom = qMin(y + radius, inputRect.bottom());
+
+            if (y == strip.top()) {
+                rowsTop = newTop;
+                rowsBottom = newTop - 1;
+            }
+
+            slideRange(rowsTop, rowsBottom, newTop, newBottom,
+                       [&] (int row) { updateRow(row, -1); },
+                       [&] (int row) { updateRow(row, 1); });
+
+            rowsTop = newTop;
+            rowsBottom = newBottom;
+
+            const int numRows = qMax(0, rowsBottom - rowsTop + 1);
+
+            state.resetWindow();
+
+            int columnsLeft = 0;
+            int columnsRight = -1;
+
+            for (int x = strip.left(); x <= strip.right(); x++) {
+                const int newLeft = qMax(x - radius, inputRect.left()) - inputRect.left();
+                const int newRight = qMin(x + radius, inputRect.right()) - inputRect.left();
+
+                if (x == strip.left()) {
+                    columnsLeft = newLeft;
+                    columnsRight = newLeft - 1;
+                }
+
+                slideRange(columnsLeft, columnsRight, newLeft, newRight,
+                           [&] (int column) { state.updateWindow(column, -1); },
+                           [&] (int column) { state.updateWindow(column, 1); });
+
+                columnsLeft = newLeft;
+                columnsRight = newRight;
+
+                window.m_totalCount = numRows * qMax(0, columnsRight - columnsLeft + 1);
+
+                const int offset = ((y - strip.top()) * strip.width() + x - strip.left()) * pixelSize;
+                stripResultFunction(window, srcBytes.constData() + offset, dstBytes.data() + offset);
+            }
+        }
+
+        dst->writeBytes(dstBytes.constData(), strip);
+    };
+
+    const QVector<QRect> strips = KisParallelFilterUtils::splitIntoStrips(applyRect, Qt::Vertical);
+
+    /**
+     * The strips are processed in batches, so that the progress could
+     * be reported from the calling thread
+     */
+    const int batchSize = qMax(1, QThread::idealThreadCount());
+
+    if (progressUpdater) {
+        progressUpdater->setRange(0, strips.size());
+        progressUpdater->setValue(0);
+    }
+
+    for (int i = 0; i < strips.size(); i += batchSize) {
+        QVector<QRect> batch = strips.mid(i, batchSize);
+        QtConcurrent::blockingMap(batch, processStrip);
+
+        if (progressUpdater) {
+            progressUpdater->setValue(i + batch.size());
+            if (progressUpdater->interrupted()) break;
+        }
+    }
+}
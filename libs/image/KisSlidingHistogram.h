@@ -0,0 +1,147 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KIS_SLIDING_HISTOGRAM_H
+#define __KIS_SLIDING_HISTOGRAM_H
+
+#include <functional>
+
+#include "kritaimage_export.h"
+#include "kis_types.h"
+
+class QRect;
+class KoUpdater;
+
+/**
+ * Engine for the filters that calculate every pixel from the histogram
+ * of a square window around it (median, mode, oil paint, despeckle).
+ *
+ * The histograms are maintained in the style of the Perreault-Hebert
+ * constant-time median filter: every column keeps the histogram of its
+ * (2 * radius + 1) pixels and slides down by one pixel per row, the
+ * window histogram slides right by adding one column histogram and
+ * subtracting another. Therefore the cost per pixel depends on the
+ * number of bins, but not on the radius.
+ *
+ * The pixels are sorted into the bins by a user-provided function.
+ * Optionally, the engine also accumulates the normalised channel
+ * values of the pixels of every bin, so that the result can be the
+ * average color of a bin (the way oil paint works).
+ *
+ * The rect is split into tile-aligned vertical strips, which are
+ * processed in parallel.
+ */
+class KRITAIMAGE_EXPORT KisSlidingHistogram
+{
+public:
+    /**
+     * The histogram of the window around the current pixel
+     */
+    class Window
+    {
+    public:
+        inline int numBins() const {
+            return m_numBins;
+        }
+
+        inline int count(int bin) const {
+            return m_counts[bin];
+        }
+
+        inline int totalCount() const {
+            return m_totalCount;
+        }
+
+        /**
+         * \return the sums of the normalised channel values of the
+         *         pixels in \p bin, or null if the channels are not
+         *         accumulated
+         */
+        inline const double* channelSums(int bin) const {
+            return m_sums ? m_sums + bin * m_numChannels : 0;
+        }
+
+        /**
+         * \return the most populated bin (the lowest one on ties),
+         *         or -1 if the window is empty
+         */
+        int modeBin() const;
+
+        /**
+         * \return the lowest bin where the cumulative count reaches
+         *         \p fraction of the total count (0.5 is the median),
+         *         or -1 if the window is empty
+         */
+        int percentileBin(qreal fraction) const;
+
+    private:
+        friend class KisSlidingHistogram;
+
+        int m_numBins = 0;
+        int m_numChannels = 0;
+        int m_totalCount = 0;
+        const int *m_counts = 0;
+        const double *m_sums = 0;
+    };
+
+    /**
+     * Returns the bin of the pixel, in the range [0, numBins)
+     */
+    using BinFunction = std::function<int (const quint8 *pixel)>;
+
+    /**
+     * Sorts \p numPixels consecutive pixels into \p bins at once. It is
+     * preferable when the bin of a single pixel is expensive to get, e.g.
+     * when the pixels should be converted into another color space first.
+     */
+    using BulkBinFunction = std::function<void (const quint8 *pixels, int numPixels, int *bins)>;
+
+    /**
+     * Writes the resulting pixel into \p dstPixel. \p srcPixel is the
+     * source pixel at the same position.
+     */
+    using ResultFunction = std::function<void (const Window &window, const quint8 *srcPixel, quint8 *dstPixel)>;
+
+    /**
+     * Filters \p applyRect of \p src into \p dst (they may be the same
+     * device). Only the pixels inside \p sourceRect are counted in the
+     * windows, so the windows near its border are smaller.
+     *
+     * The functions are called concurrently, so they should be
+     * thread-safe. Every strip works with its own copies of the function
+     * objects, so a mutable lambda may keep its scratch buffers in its
+     * captures.
+     */
+    static void apply(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                      const QRect &applyRect, const QRect &sourceRect,
+                      int radius, int numBins, bool accumulateChannels,
+                      BinFunction binFunction, ResultFunction resultFunction,
+                      KoUpdater *progressUpdater = 0);
+
+    /**
+     * The same as apply(), but the pixels of every strip are sorted into
+     * the bins with a single call of \p binFunction
+     */
+    static void applyWithBulkBins(KisPaintDeviceSP src, KisPaintDeviceSP dst,
+                                  const QRect &applyRect, const QRect &sourceRect,
+                                  int radius, int numBins, bool accumulateChannels,
+                                  BulkBinFunction binFunction, ResultFunction resultFunction,
+                                  KoUpdater *progressUpdater = 0);
+};
+
+#endif /* __KIS_SLIDING_HISTOGRAM_H */
@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KIS_TILE_KERNEL_H
+#define __KIS_TILE_KERNEL_H
+
+#include <KoConfig.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceTraits.h>
+#include <KoColorModelStandardIds.h>
+
+#include "kis_assert.h"
+
+#include "kis_sequential_iterator.h"
+#include "KisSequentialIteratorProgress.h"
+
+/**
+ * Helpers for writing per-pixel loops that the compiler can vectorize.
+ *
+ * KisSequentialIterator already knows how many consequent pixels live
+ * in the current tile row (nConseqPixels()), but most of the code still
+ * calls nextPixel() and a virtual color space method for every pixel.
+ * The functions below walk the rect span by span and hand every span
+ * to a functor as a typed array of channels, so the body of the functor
+ * is a plain loop with the pixel layout known at compile time:
+ *
+ * \code
+ * KisTileKernel::processSpans<KoBgrU8Traits>(dev, rect,
+ *     [] (const quint8 *src, quint8 *dst, int numPixels) {
+ *         for (int i = 0; i < numPixels * 4; i++) {
+ *             dst[i] = 255 - src[i];
+ *         }
+ *     });
+ * \endcode
+ *
+ * The span never crosses a tile boundary, so its length is at most the
+ * tile width. The caller is responsible for the traits matching the
+ * color space of the device, or can let processRgbaSpans() pick them.
+ */
+namespace KisTileKernel {
+
+/**
+ * Calls \p func(const channels_type *oldData, channels_type *data, int numPixels)
+ * for every span of \p rect. \p oldData points to the old (pre-transaction)
+ * data of the same pixels.
+ */
+template <class Traits, class SpanFunc>
+void processSpans(KisPaintDeviceSP dev, const QRect &rect, SpanFunc func, KoProgressProxy *progressProxy = 0)
+{
+    typedef typename Traits::channels_type channels_type;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(dev->pixelSize() == Traits::pixelSize);
+
+    KisSequentialIteratorProgress it(dev, rect, progressProxy);
+
+    int conseq = it.nConseqPixels();
+    while (it.nextPixels(conseq)) {
+        conseq = it.nConseqPixels();
+        func(reinterpret_cast<const channels_type*>(it.oldRawData()),
+             reinterpret_cast<channels_type*>(it.rawData()),
+             conseq);
+    }
+}
+
+/**
+ * Calls \p func(const channels_type *data, int numPixels) for every span
+ * of \p rect without requesting write access to the device.
+ */
+template <class Traits, class SpanFunc>
+void processSpansConst(KisPaintDeviceSP dev, const QRect &rect, SpanFunc func)
+{
+    typedef typename Traits::channels_type channels_type;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(dev->pixelSize() == Traits::pixelSize);
+
+    KisSequentialConstIterator it(dev, rect);
+
+    int conseq = it.nConseqPixels();
+    while (it.nextPixels(conseq)) {
+        conseq = it.nConseqPixels();
+        func(reinterpret_cast<const channels_type*>(it.rawDataConst()), conseq);
+    }
+}
+
+/**
+ * Picks the traits of the RGBA color space of \p dev (8 and 16 bit
+ * integer, 16 and 32 bit float) and calls processSpans() with
+ * SpanOp<Traits>(args...) as the functor:
+ *
+ * \code
+ * template <class Traits>
+ * struct InvertSpan {
+ *     typedef typename Traits::channels_type channels_type;
+ *
+ *     void operator() (const channels_type *src, channels_type *dst, int numPixels) const {
+ *         KoInvertColorTransformationTraits<Traits>::invertPixels(src, dst, numPixels);
+ *     }
+ * };
+ *
+ * if (!KisTileKernel::processRgbaSpans<InvertSpan>(dev, rect, progressProxy)) {
+ *     // fall back to the color transformation
+ * }
+ * \endcode
+ *
+ * Returns false without touching the device if its color space is not
+ * one of them.
+ */
+template <template <class> class SpanOp, class... Args>
+bool processRgbaSpans(KisPaintDeviceSP dev, const QRect &rect, KoProgressProxy *progressProxy, Args... args)
+{
+    const KoColorSpace *cs = dev->colorSpace();
+    if (cs->colorModelId() != RGBAColorModelID) return false;
+
+    const KoID depthId = cs->colorDepthId();
+
+    if (depthId == Integer8BitsColorDepthID) {
+        processSpans<KoBgrU8Traits>(dev, rect, SpanOp<KoBgrU8Traits>(args...), progressProxy);
+    } else if (depthId == Integer16BitsColorDepthID) {
+        processSpans<KoBgrU16Traits>(dev, rect, SpanOp<KoBgrU16Traits>(args...), progressProxy);
+#ifdef HAVE_OPENEXR
+    } else if (depthId == Float16BitsColorDepthID) {
+        processSpans<KoRgbF16Traits>(dev, rect, SpanOp<KoRgbF16Traits>(args...), progressProxy);
+#endif
+    } else if (depthId == Float32BitsColorDepthID) {
+        processSpans<KoRgbF32Traits>(dev, rect, SpanOp<KoRgbF32Traits>(args...), progressProxy);
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+#endif /* __KIS_TILE_KERNEL_H */
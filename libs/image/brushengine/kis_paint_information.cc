@@ -312,6 +312,8 @@ void KisPaintInformation::toXML(QDomDocument&, QDomElement& e) const
     e.setAttribute("perspective", QString::number(perspective(), 'g', 15));
     e.setAttribute("time", QString::number(d->time, 'g', 15));
     e.setAttribute("speed", QString::number(d->speed, 'g', 15));
+    e.setAttribute("canvasRotation", QString::number(canvasRotation()));
+    e.setAttribute("canvasMirroredH", canvasMirroredH() ? "1" : "0");
 }
 
 KisPaintInformation KisPaintInformation::fromXML(const QDomElement& e)
@@ -327,8 +329,15 @@ KisPaintInformation KisPaintInformation::fromXML(const QDomElement& e)
     qreal time = KisDomUtils::toDouble(e.attribute("time", "0"));
     qreal speed = KisDomUtils::toDouble(e.attribute("speed", "0"));
 
-    return KisPaintInformation(QPointF(pointX, pointY), pressure, xTilt, yTilt,
-                               rotation, tangentialPressure, perspective, time, speed);
+    int canvasRotation = KisDomUtils::toInt(e.attribute("canvasRotation", "0"));
+    bool canvasMirroredH = KisDomUtils::toInt(e.attribute("canvasMirroredH", "0"));
+
+    KisPaintInformation pi(QPointF(pointX, pointY), pressure, xTilt, yTilt,
+                           rotation, tangentialPressure, perspective, time, speed);
+    pi.setCanvasRotation(canvasRotation);
+    pi.setCanvasHorizontalMirrorState(canvasMirroredH);
+
+    return pi;
 }
 
 const QPointF& KisPaintInformation::pos() const
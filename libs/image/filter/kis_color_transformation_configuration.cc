@@ -21,6 +21,7 @@
 #include <QMutexLocker>
 #include <QMap>
 #include <QThread>
+#include <KoLut3DColorTransformation.h>
 #include "filter/kis_color_transformation_filter.h"
 
 struct Q_DECL_HIDDEN KisColorTransformationConfiguration::Private {
@@ -35,6 +36,14 @@ struct Q_DECL_HIDDEN KisColorTransformationConfiguration::Private {
     // XXX: Threadlocal storage!!!
     QMap<QThread*, KoColorTransformation*> colorTransformation;
     QMutex mutex;
+
+    /**
+     * The table is baked once and shared by the transformations of all
+     * the threads. A null table means the transformation could not be
+     * baked for bakedColorSpace and is evaluated exactly.
+     */
+    QScopedPointer<KoLut3DColorTransformation> bakedTransformation;
+    const KoColorSpace *bakedColorSpace = 0;
 };
 
 KisColorTransformationConfiguration::KisColorTransformationConfiguration(const QString & name, qint32 version)
@@ -60,7 +69,29 @@ KoColorTransformation* KisColorTransformationConfiguration::colorTransformation(
     KoColorTransformation *transformation = d->colorTransformation.value(QThread::currentThread(), 0);
     if (!transformation) {
         KisFilterConfigurationSP config(const_cast<KisColorTransformationConfiguration*>(this));
-        transformation = filter->createTransformation(cs, config);
+        QScopedPointer<KoColorTransformation> exactTransformation;
+
+        if (filter->canBakeTransformation(cs, config) &&
+            KoLut3DColorTransformation::isColorSpaceSupported(cs)) {
+
+            if (d->bakedColorSpace != cs) {
+                exactTransformation.reset(filter->createTransformation(cs, config));
+                d->bakedTransformation.reset(
+                    KoLut3DColorTransformation::createBakedTransformation(cs, exactTransformation.data()));
+                d->bakedColorSpace = cs;
+            }
+
+            if (d->bakedTransformation) {
+                transformation = new KoLut3DColorTransformation(*d->bakedTransformation);
+            }
+        }
+
+        if (!transformation) {
+            transformation = exactTransformation ?
+                exactTransformation.take() :
+                filter->createTransformation(cs, config);
+        }
+
         d->colorTransformation.insert(QThread::currentThread(), transformation);
     }
     locker.unlock();
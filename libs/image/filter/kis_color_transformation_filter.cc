@@ -49,16 +49,7 @@ void KisColorTransformationFilter::processImpl(KisPaintDeviceSP device,
 {
     Q_ASSERT(!device.isNull());
 
-    const KoColorSpace * cs = device->colorSpace();
-    KoColorTransformation * colorTransformation = 0;
-    // Ew, casting
-    KisColorTransformationConfigurationSP colorTransformationConfiguration(dynamic_cast<KisColorTransformationConfiguration*>(const_cast<KisFilterConfiguration*>(config.data())));
-    if (colorTransformationConfiguration) {
-        colorTransformation = colorTransformationConfiguration->colorTransformation(cs, this);
-    }
-    else {
-        colorTransformation = createTransformation(cs, config);
-    }
+    QSharedPointer<KoColorTransformation> colorTransformation = this->colorTransformation(device->colorSpace(), config);
     if (!colorTransformation) return;
 
     KisSequentialIteratorProgress it(device, applyRect, progressUpdater);
@@ -68,11 +59,27 @@ void KisColorTransformationFilter::processImpl(KisPaintDeviceSP device,
         conseq = it.nConseqPixels();
         colorTransformation->transform(it.oldRawData(), it.rawData(), conseq);
     }
+}
 
-    if (!colorTransformationConfiguration) {
-        delete colorTransformation;
+QSharedPointer<KoColorTransformation> KisColorTransformationFilter::colorTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const
+{
+    // Ew, casting
+    KisColorTransformationConfigurationSP colorTransformationConfiguration(dynamic_cast<KisColorTransformationConfiguration*>(const_cast<KisFilterConfiguration*>(config.data())));
+    if (colorTransformationConfiguration) {
+        // the transformation is owned by the configuration, so the
+        // configuration is kept alive as long as the transformation is used
+        return QSharedPointer<KoColorTransformation>(colorTransformationConfiguration->colorTransformation(cs, this),
+                                                     [colorTransformationConfiguration] (KoColorTransformation *) {});
     }
 
+    return QSharedPointer<KoColorTransformation>(createTransformation(cs, config));
+}
+
+bool KisColorTransformationFilter::canBakeTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const
+{
+    Q_UNUSED(cs);
+    Q_UNUSED(config);
+    return false;
 }
 
 KisFilterConfigurationSP  KisColorTransformationFilter::factoryConfiguration() const
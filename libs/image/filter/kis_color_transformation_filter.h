@@ -20,6 +20,8 @@
 #ifndef _KIS_COLOR_TRANSFORMATION_FILTER_H_
 #define _KIS_COLOR_TRANSFORMATION_FILTER_H_
 
+#include <QSharedPointer>
+
 #include "kis_filter.h"
 #include "kritaimage_export.h"
 
@@ -42,6 +44,21 @@ public:
      */
     virtual KoColorTransformation* createTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const = 0;
 
+    /**
+     * The transformation processImpl() applies for \p config: either the
+     * one cached by the KisColorTransformationConfiguration or a new one
+     */
+    QSharedPointer<KoColorTransformation> colorTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const;
+
+    /**
+     * @return true if the transformation created for \p config is a pure
+     * function of the color channels of a pixel in \p cs and never touches
+     * alpha. KisColorTransformationConfiguration bakes such transformations
+     * into a 3D lookup table (see KoLut3DColorTransformation) when it is
+     * precise enough. The default implementation returns false.
+     */
+    virtual bool canBakeTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const;
+
     KisFilterConfigurationSP factoryConfiguration() const override;
 };
 
@@ -109,11 +109,47 @@ void KisBrushMaskVectorApplicator<MaskGenerator, _impl>::processVector(const QRe
 
     float *buffer = Vc::malloc<float, Vc::AlignOnCacheline>(simdWidth);
 
+    /**
+     * Small dabs are supersampled: the row processor is run once per
+     * subsample with a shifted center and the rows are averaged, which
+     * matches the sampling grid of processScalar()
+     */
+    const int supersample = (m_maskGenerator->shouldSupersample() ? SUPERSAMPLING : 1);
+    const float invss = 1.0f / supersample;
+    const Vc::float_v vSampleAreaCoeff(1.0f / pow2(supersample));
+    float *subsampleBuffer = supersample != 1 ? Vc::malloc<float, Vc::AlignOnCacheline>(simdWidth) : 0;
+
     typename MaskGenerator::FastRowProcessor processor(m_maskGenerator);
 
     for (int y = rect.y(); y < rect.y() + rect.height(); y++) {
 
-        processor.template process<_impl>(buffer, simdWidth, y, m_d->cosa, m_d->sina, m_d->centerX, m_d->centerY);
+        if (supersample == 1) {
+            processor.template process<_impl>(buffer, simdWidth, y, m_d->cosa, m_d->sina, m_d->centerX, m_d->centerY);
+        } else {
+            memset(buffer, 0, simdWidth * sizeof(float));
+
+            for (int sy = 0; sy < supersample; sy++) {
+                for (int sx = 0; sx < supersample; sx++) {
+                    processor.template process<_impl>(subsampleBuffer, simdWidth,
+                                                      y + sy * invss,
+                                                      m_d->cosa, m_d->sina,
+                                                      m_d->centerX - sx * invss,
+                                                      m_d->centerY);
+
+                    for (int i = 0; i < simdWidth; i += Vc::float_v::size()) {
+                        Vc::float_v acc(buffer + i, Vc::Aligned);
+                        acc += Vc::float_v(subsampleBuffer + i, Vc::Aligned);
+                        acc.store(buffer + i, Vc::Aligned);
+                    }
+                }
+            }
+
+            for (int i = 0; i < simdWidth; i += Vc::float_v::size()) {
+                Vc::float_v acc(buffer + i, Vc::Aligned);
+                acc *= vSampleAreaCoeff;
+                acc.store(buffer + i, Vc::Aligned);
+            }
+        }
 
         if (m_d->randomness != 0.0 || m_d->density != 1.0) {
             for (int x = 0; x < width; x++) {
@@ -144,6 +180,9 @@ void KisBrushMaskVectorApplicator<MaskGenerator, _impl>::processVector(const QRe
         dabPointer += offset;
     }//endfor y
     Vc::free(buffer);
+    if (subsampleBuffer) {
+        Vc::free(subsampleBuffer);
+    }
 }
 
 #endif /* defined HAVE_VC */
@@ -100,7 +100,7 @@ bool KisCircleMaskGenerator::shouldSupersample() const
 
 bool KisCircleMaskGenerator::shouldVectorize() const
 {
-    return !shouldSupersample() && spikes() == 2;
+    return spikes() == 2;
 }
 
 KisBrushMaskApplicatorBase* KisCircleMaskGenerator::applicator()
@@ -23,27 +23,142 @@
 #include <iostream>
 
 #include <KoChannelInfo.h>
+#include <kis_debug.h>
 
 #include "kis_convolution_worker.h"
 #include "kis_math_toolbox.h"
 
 #include <QMutex>
+#include <QMutexLocker>
+#include <QHash>
+#include <QPair>
 #include <QVector>
 #include <QTextStream>
 #include <QFile>
+#include <QFileInfo>
 #include <QDir>
+#include <QStandardPaths>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <cstdio>
 
 #include <fftw3.h>
 
-template<class _IteratorFactory_> class KisConvolutionWorkerFFT;
-class KisConvolutionWorkerFFTLock
+/**
+ * The FFTW planner is not thread-safe, so all the plans are created
+ * under a global lock. Execution of the plans is thread-safe, so the
+ * same plan is used by all the tiles of the convolution (via the
+ * new-array execute functions).
+ *
+ * The worker uses only power-of-two tile sizes, so the plans are
+ * cached for the whole lifetime of the application. The wisdom of
+ * the measured plans is saved into the cache directory, so the
+ * expensive measurement happens only once per tile size.
+ */
+class KisConvolutionWorkerFFTPlanCache
 {
+public:
+    struct Plans {
+        fftw_plan forward = 0;
+        fftw_plan backward = 0;
+    };
+
+    /**
+     * Returns the plans for an in-place real-to-complex transform of
+     * \p width x \p height and its inverse. The input rows should
+     * be padded to 2 * (width / 2 + 1) doubles.
+     */
+    static Plans plans(int width, int height) {
+        Private *d = instance();
+        QMutexLocker l(&d->mutex);
+
+        if (!d->wisdomLoaded) {
+            d->loadWisdom();
+            d->wisdomLoaded = true;
+        }
+
+        const QPair<int, int> key(width, height);
+
+        auto it = d->plans.constFind(key);
+        if (it != d->plans.constEnd()) {
+            return *it;
+        }
+
+        /**
+         * Measuring huge transforms takes too long, so they fall back
+         * to the estimated plans
+         */
+        const int maxMeasuredArea = 2048 * 2048;
+        const unsigned flags = width * height <= maxMeasuredArea ? FFTW_MEASURE : FFTW_ESTIMATE;
+
+        // the planner may overwrite the arrays, so it gets a scratch buffer
+        const int length = height * (width / 2 + 1);
+        fftw_complex *scratch = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * length);
+
+        Plans plans;
+        plans.forward = fftw_plan_dft_r2c_2d(height, width, (double*)scratch, scratch, flags);
+        plans.backward = fftw_plan_dft_c2r_2d(height, width, scratch, (double*)scratch, flags);
+
+        fftw_free(scratch);
+
+        d->plans.insert(key, plans);
+
+        if (flags & FFTW_MEASURE) {
+            d->saveWisdom();
+        }
+
+        return plans;
+    }
+
+    static QMutex* mutex() {
+        return &instance()->mutex;
+    }
+
 private:
-    static QMutex fftwMutex;
-    template<class _IteratorFactory_> friend class KisConvolutionWorkerFFT;
-};
+    struct Private {
+        ~Private() {
+            Q_FOREACH (const Plans &plans, this->plans) {
+                fftw_destroy_plan(plans.forward);
+                fftw_destroy_plan(plans.backward);
+            }
+        }
+
+        static QString wisdomFileName() {
+            return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/fftw_wisdom";
+        }
+
+        void loadWisdom() {
+            FILE *file = fopen(QFile::encodeName(wisdomFileName()).constData(), "r");
+            if (!file) return;
+
+            if (!fftw_import_wisdom_from_file(file)) {
+                warnKrita << "Failed to load FFTW wisdom from" << wisdomFileName();
+            }
 
-QMutex KisConvolutionWorkerFFTLock::fftwMutex;
+            fclose(file);
+        }
+
+        void saveWisdom() {
+            QDir().mkpath(QFileInfo(wisdomFileName()).absolutePath());
+
+            FILE *file = fopen(QFile::encodeName(wisdomFileName()).constData(), "w");
+            if (!file) return;
+
+            fftw_export_wisdom_to_file(file);
+            fclose(file);
+        }
+
+        QMutex mutex;
+        bool wisdomLoaded = false;
+        QHash<QPair<int, int>, Plans> plans;
+    };
+
+    static Private* instance() {
+        static Private s_instance;
+        return &s_instance;
+    }
+};
 
 
 template<class _IteratorFactory_>
@@ -82,89 +197,169 @@ public:
         const quint32 halfKernelWidth = (kernel->width() - 1) / 2;
         const quint32 halfKernelHeight = (kernel->height() - 1) / 2;
 
-        m_fftWidth = areaSize.width() + 4 * halfKernelWidth;
-        m_fftHeight = areaSize.height() + 2 * halfKernelHeight;
-
         /**
-         * FIXME: check whether this "optimization" is needed to
-         * be uncommented. My tests showed about 30% better performance
-         * when the line is commented out (DK).
+         * The area is convolved in tiles using overlap-save method: every
+         * tile is transformed with a margin of the kernel size, and only
+         * the part unaffected by the circular wrapping is written back.
+         * Therefore the memory footprint depends on the size of the
+         * kernel only, and the tiles can be processed in parallel.
          */
-        //optimumDimensions(m_fftWidth, m_fftHeight);
+        m_fftWidth = fftTileSize(areaSize.width(), kernel->width());
+        m_fftHeight = fftTileSize(areaSize.height(), kernel->height());
 
         m_fftLength = m_fftHeight * (m_fftWidth / 2 + 1);
         m_extraMem = (m_fftWidth % 2) ? 1 : 2;
 
+        const QVector<QPair<int, int>> columns =
+            splitIntoBlocks(dstPos.x(), areaSize.width(), m_fftWidth - kernel->width() + 1);
+        const QVector<QPair<int, int>> rows =
+            splitIntoBlocks(dstPos.y(), areaSize.height(), m_fftHeight - kernel->height() + 1);
+
+        /**
+         * The tiles are written while the others are still being read,
+         * so the in-place convolution should read from a snapshot
+         */
+        KisPaintDeviceSP source = src;
+        if (src == this->m_painter->device()) {
+            source = new KisPaintDevice(*src);
+        }
+
+        const KisConvolutionWorkerFFTPlanCache::Plans plans =
+            KisConvolutionWorkerFFTPlanCache::plans(m_fftWidth, m_fftHeight);
+
         // create and fill kernel
         m_kernelFFT = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
         memset(m_kernelFFT, 0, sizeof(fftw_complex) * m_fftLength);
         fftFillKernelMatrix(kernel, m_kernelFFT);
+        fftw_execute_dft_r2c(plans.forward, (double*)m_kernelFFT, m_kernelFFT);
 
         // find out which channels need convolving
         QList<KoChannelInfo*> convChannelList = this->convolvableChannelList(src);
 
-        m_channelFFT.resize(convChannelList.count());
-        for (auto i = m_channelFFT.begin(); i != m_channelFFT.end(); ++i) {
-            *i = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
-        }
-
         const double kernelFactor = kernel->factor() ? kernel->factor() : 1;
         const double fftScale = 1.0 / (m_fftHeight * m_fftWidth) / kernelFactor;
 
-        FFTInfo info (fftScale, convChannelList, kernel, this->m_painter->device()->colorSpace());
-        int cacheRowStride = m_fftWidth + m_extraMem;
+        const FFTInfo info (fftScale, convChannelList, kernel, this->m_painter->device()->colorSpace());
+        const int cacheRowStride = m_fftWidth + m_extraMem;
 
-        fillCacheFromDevice(src,
-                            QRect(srcPos.x() - halfKernelWidth,
-                                  srcPos.y() - halfKernelHeight,
-                                  m_fftWidth,
-                                  m_fftHeight),
-                            cacheRowStride,
-                            info, dataRect);
+        QVector<QRect> tiles;
+        for (auto row = rows.constBegin(); row != rows.constEnd(); ++row) {
+            for (auto column = columns.constBegin(); column != columns.constEnd(); ++column) {
+                tiles << QRect(column->first, row->first, column->second, row->second);
+            }
+        }
 
         addToProgress(10);
         if (isInterrupted()) return;
 
-        // calculate number off fft operations required for progress reporting
-        const float progressPerFFT = (100 - 30) / (double)(convChannelList.count() * 2 + 1);
+        auto processTile = [&] (const QRect &tile) {
+            QVector<fftw_complex*> channelFFT(info.numChannels());
+            for (auto i = channelFFT.begin(); i != channelFFT.end(); ++i) {
+                *i = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
+            }
 
-        // perform FFT
-        fftw_plan fftwPlanForward, fftwPlanBackward;
+            fillCacheFromDevice(source,
+                                QRect(srcPos.x() + tile.x() - halfKernelWidth,
+                                      srcPos.y() + tile.y() - halfKernelHeight,
+                                      m_fftWidth,
+                                      m_fftHeight),
+                                cacheRowStride,
+                                info, dataRect, channelFFT);
+
+            for (auto k = channelFFT.begin(); k != channelFFT.end(); ++k) {
+                fftw_execute_dft_r2c(plans.forward, (double*)(*k), *k);
+                fftMultiply(*k, m_kernelFFT);
+                fftw_execute_dft_c2r(plans.backward, *k, (double*)*k);
+            }
 
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
-        fftwPlanForward = fftw_plan_dft_r2c_2d(m_fftHeight, m_fftWidth, (double*)m_kernelFFT, m_kernelFFT, FFTW_ESTIMATE);
-        fftwPlanBackward = fftw_plan_dft_c2r_2d(m_fftHeight, m_fftWidth, m_kernelFFT, (double*)m_kernelFFT, FFTW_ESTIMATE);
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
+            writeResultToDevice(tile.translated(dstPos),
+                                cacheRowStride, halfKernelWidth, halfKernelHeight,
+                                info, dataRect, channelFFT);
 
-        fftw_execute(fftwPlanForward);
-        addToProgress(progressPerFFT);
-        if (isInterrupted()) return;
+            Q_FOREACH (fftw_complex *channel, channelFFT) {
+                fftw_free(channel);
+            }
+        };
 
-        for (auto k = m_channelFFT.begin(); k != m_channelFFT.end(); ++k)
-        {
-            fftw_execute_dft_r2c(fftwPlanForward, (double*)(*k), *k);
-            addToProgress(progressPerFFT);
-            if (isInterrupted()) return;
+        /**
+         * The tiles are processed in batches, so that the progress
+         * is reported and the cancellation is checked from the
+         * calling thread only. Huge kernels get smaller batches to
+         * keep the memory footprint bounded.
+         */
+        const qint64 maxBatchMemory = 512 * 1024 * 1024;
+        const qint64 tileMemory = qint64(qMax(1, info.numChannels())) * m_fftLength * sizeof(fftw_complex);
+        const int batchSize = qBound(1, int(maxBatchMemory / tileMemory), qMax(1, QThread::idealThreadCount()));
+        const float progressPerTile = (100 - 10) / (float)tiles.size();
 
-            fftMultiply(*k, m_kernelFFT);
+        for (int i = 0; i < tiles.size(); i += batchSize) {
+            QVector<QRect> batch = tiles.mid(i, batchSize);
+            QtConcurrent::blockingMap(batch, processTile);
 
-            fftw_execute_dft_c2r(fftwPlanBackward, *k, (double*)*k);
-            addToProgress(progressPerFFT);
+            addToProgress(progressPerTile * batch.size());
             if (isInterrupted()) return;
         }
 
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
-        fftw_destroy_plan(fftwPlanForward);
-        fftw_destroy_plan(fftwPlanBackward);
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
+        cleanUp();
+    }
 
+    /**
+     * The size of the FFT tile along one axis: a power of two large
+     * enough to keep the overhead of the overlap small, but not larger
+     * than needed for the whole area.
+     */
+    static quint32 fftTileSize(int areaSize, int kernelSize)
+    {
+        const int preferredSize = qMax(256, 4 * (kernelSize - 1));
+        const int requiredSize = qMin(preferredSize, areaSize + kernelSize - 1);
 
-        writeResultToDevice(QRect(dstPos.x(), dstPos.y(), areaSize.width(), areaSize.height()),
-                            cacheRowStride, halfKernelWidth, halfKernelHeight,
-                            info, dataRect);
+        quint32 size = 1;
+        while (size < quint32(requiredSize)) {
+            size <<= 1;
+        }
 
-        addToProgress(20);
-        cleanUp();
+        return size;
+    }
+
+    /**
+     * Splits the range [start, start + length) into blocks of at most
+     * \p blockSize pixels. The boundaries of the blocks are aligned to
+     * the grid of the device tiles, so the parallel tiles never write
+     * into the same device tile. Returns (offset, size) pairs relative
+     * to \p start.
+     */
+    static QVector<QPair<int, int>> splitIntoBlocks(int start, int length, int blockSize)
+    {
+        const int deviceTileSize = 64;
+
+        if (blockSize >= deviceTileSize) {
+            blockSize -= blockSize % deviceTileSize;
+        }
+
+        QVector<QPair<int, int>> blocks;
+
+        const int end = start + length;
+        int pos = start;
+
+        while (pos < end) {
+            int next = pos + blockSize;
+
+            if (blockSize >= deviceTileSize) {
+                const int alignedNext = next >= 0 ?
+                    next / deviceTileSize * deviceTileSize :
+                    -((-next + deviceTileSize - 1) / deviceTileSize * deviceTileSize);
+
+                if (alignedNext > pos) {
+                    next = alignedNext;
+                }
+            }
+
+            next = qMin(next, end);
+            blocks << qMakePair(pos - start, next - pos);
+            pos = next;
+        }
+
+        return blocks;
     }
 
     struct FFTInfo {
@@ -222,7 +417,8 @@ public:
                              const QRect &rect,
                              const int cacheRowStride,
                              const FFTInfo &info,
-                             const QRect &dataRect) {
+                             const QRect &dataRect,
+                             const QVector<fftw_complex*> &channelFFT) {
 
         typename _IteratorFactory_::HLineConstIterator hitSrc =
             _IteratorFactory_::createHLineConstIterator(src,
@@ -234,7 +430,7 @@ public:
         const auto channelPtrBegin = channelPtr.begin();
         const auto channelPtrEnd = channelPtr.end();
 
-        auto iFFt = m_channelFFT.constBegin();
+        auto iFFt = channelFFT.constBegin();
         for (auto i = channelPtrBegin; i != channelPtrEnd; ++i, ++iFFt) {
             *i = (double*)*iFFt;
         }
@@ -313,7 +509,8 @@ public:
                              const int halfKernelWidth,
                              const int halfKernelHeight,
                              const FFTInfo &info,
-                             const QRect &dataRect) {
+                             const QRect &dataRect,
+                             const QVector<fftw_complex*> &channelFFT) {
 
         typename _IteratorFactory_::HLineIterator hitDst =
             _IteratorFactory_::createHLineIterator(this->m_painter->device(),
@@ -327,7 +524,7 @@ public:
         const auto channelPtrBegin = channelPtr.begin();
         const auto channelPtrEnd = channelPtr.end();
 
-        auto iFFt = m_channelFFT.constBegin();
+        auto iFFt = channelFFT.constBegin();
         for (auto i = channelPtrBegin; i != channelPtrEnd; ++i, ++iFFt) {
             *i = (double*)*iFFt + initialOffset;
         }
@@ -472,14 +669,13 @@ private:
 
     void fftLogMatrix(double* channel, const QString &f)
     {
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
+        QMutexLocker l(KisConvolutionWorkerFFTPlanCache::mutex());
         QString filename(QDir::homePath() + "/log_" + f + ".txt");
         dbgKrita << "Log File Name: " << filename;
         QFile file (filename);
         if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
         {
             dbgKrita << "Failed";
-            KisConvolutionWorkerFFTLock::fftwMutex.unlock();
             return;
         }
 
@@ -496,7 +692,6 @@ private:
             }
             in << "\n";
         }
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
     }
 
     void addToProgress(float amount)
@@ -523,19 +718,14 @@ private:
         // free kernel fft data
         if (m_kernelFFT) {
             fftw_free(m_kernelFFT);
+            m_kernelFFT = 0;
         }
-
-        Q_FOREACH (fftw_complex *channel, m_channelFFT) {
-            fftw_free(channel);
-        }
-        m_channelFFT.clear();
     }
 private:
     quint32 m_fftWidth, m_fftHeight, m_fftLength, m_extraMem;
     float m_currentProgress;
 
     fftw_complex* m_kernelFFT;
-    QVector<fftw_complex*> m_channelFFT;
 };
 
 #endif
@@ -101,7 +101,7 @@ void KisCurveCircleMaskGenerator::setScale(qreal scaleX, qreal scaleY)
 
 bool KisCurveCircleMaskGenerator::shouldVectorize() const
 {
-    return !shouldSupersample() && spikes() == 2;
+    return spikes() == 2;
 }
 
 KisBrushMaskApplicatorBase* KisCurveCircleMaskGenerator::applicator()
@@ -21,6 +21,7 @@
 
 #include <KoIcon.h>
 #include <kis_icon.h>
+#include <KoColorTransformation.h>
 
 
 KisEffectMask::KisEffectMask()
@@ -42,3 +43,10 @@ QIcon KisEffectMask::icon() const
     return KisIconUtils::loadIcon("bookmarks");
 }
 
+QSharedPointer<KoColorTransformation> KisEffectMask::pixelTransformation(KisPaintDeviceSP projection, const QRect &applyRect) const
+{
+    Q_UNUSED(projection);
+    Q_UNUSED(applyRect);
+
+    return QSharedPointer<KoColorTransformation>();
+}
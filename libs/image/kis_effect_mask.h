@@ -19,7 +19,12 @@
 #ifndef _KIS_EFFECT_MASK_
 #define _KIS_EFFECT_MASK_
 
+#include <QSharedPointer>
+
 #include "kis_mask.h"
+
+class KoColorTransformation;
+
 /**
  * An effect mask is a single channel mask that applies a particular
  * effect to the layer the mask belongs to. It differs from an
@@ -46,6 +51,15 @@ public:
     QIcon icon() const override;
 
     using KisMask::apply;
+
+    /**
+     * If applying the mask to \p applyRect of \p projection is a pure
+     * per-pixel color transformation, returns this transformation, so
+     * that the layer could apply a chain of such masks in a single pass
+     * right on the projection. Otherwise returns null and the mask
+     * should be applied with apply().
+     */
+    virtual QSharedPointer<KoColorTransformation> pixelTransformation(KisPaintDeviceSP projection, const QRect &applyRect) const;
 };
 
 #endif //_KIS_EFFECT_MASK_
@@ -53,7 +53,7 @@
 #include "kis_pixel_selection.h"
 #include <KoCompositeOpRegistry.h>
 #include <floodfill/kis_scanline_fill.h>
-#include "kis_selection_filters.h"
+#include "KisDistanceTransform.h"
 
 KisFillPainter::KisFillPainter()
         : KisPainter()
@@ -308,16 +308,15 @@ KisSelectionSP KisFillPainter::createFloodSelection(int startX, int startY, KisP
     gc.fillSelection(pixelSelection);
 
     if (m_sizemod > 0) {
-        KisGrowSelectionFilter biggy(m_sizemod, m_sizemod);
-        biggy.process(pixelSelection, selection->selectedRect().adjusted(-m_sizemod, -m_sizemod, m_sizemod, m_sizemod));
+        KisDistanceTransform::applyGrow(pixelSelection, selection->selectedRect().adjusted(-m_sizemod, -m_sizemod, m_sizemod, m_sizemod),
+                                        m_sizemod, m_sizemod);
     }
     else if (m_sizemod < 0) {
-        KisShrinkSelectionFilter tiny(-m_sizemod, -m_sizemod, false);
-        tiny.process(pixelSelection, selection->selectedRect());
+        KisDistanceTransform::applyShrink(pixelSelection, selection->selectedRect(), -m_sizemod, -m_sizemod, false);
     }
     if (m_feather > 0) {
-        KisFeatherSelectionFilter feathery(m_feather);
-        feathery.process(pixelSelection, selection->selectedRect().adjusted(-m_feather, -m_feather, m_feather, m_feather));
+        KisDistanceTransform::applyFeather(pixelSelection, selection->selectedRect().adjusted(-m_feather, -m_feather, m_feather, m_feather),
+                                           m_feather);
     }
 
     return selection;
@@ -26,7 +26,9 @@
 #include "filter/kis_filter.h"
 #include "filter/kis_filter_configuration.h"
 #include "filter/kis_filter_registry.h"
+#include "filter/kis_color_transformation_filter.h"
 #include "kis_selection.h"
+#include "kis_pixel_selection.h"
 #include "kis_processing_information.h"
 #include "kis_node.h"
 #include "kis_node_visitor.h"
@@ -103,6 +105,53 @@ QRect KisFilterMask::decorateRect(KisPaintDeviceSP &src,
     return r;
 }
 
+QSharedPointer<KoColorTransformation> KisFilterMask::pixelTransformation(KisPaintDeviceSP projection, const QRect &applyRect) const
+{
+    KisFilterConfigurationSP filterConfig = filter();
+    if (!filterConfig) return QSharedPointer<KoColorTransformation>();
+
+    const KisColorTransformationFilter *filter =
+        dynamic_cast<const KisColorTransformationFilter*>(
+            KisFilterRegistry::instance()->value(filterConfig->name()).data());
+
+    if (!filter) return QSharedPointer<KoColorTransformation>();
+
+    // KisFilter::process() would filter a copy of the device then
+    const bool weirdColorSpace =
+        projection->colorSpace() != projection->compositionSourceColorSpace() &&
+        *projection->colorSpace() != *projection->compositionSourceColorSpace();
+
+    if (weirdColorSpace) return QSharedPointer<KoColorTransformation>();
+
+    /**
+     * The selection should not blend the result with the source,
+     * i.e. the default pixel is fully selected and no pixels differing
+     * from it are stored in the rect
+     */
+    KisSelectionSP selection = this->selection();
+    if (selection) {
+        flattenSelectionProjection(selection, applyRect);
+
+        KisIndirectPaintingSupport::ReadLocker l(this);
+
+        if (hasTemporaryTarget()) return QSharedPointer<KoColorTransformation>();
+
+        KisPixelSelectionSP pixelSelection = selection->projection();
+
+        if (*pixelSelection->defaultPixel().data() != MAX_SELECTED ||
+            pixelSelection->extent().intersects(applyRect)) {
+
+            return QSharedPointer<KoColorTransformation>();
+        }
+    }
+
+    if (KisBusyProgressIndicator *indicator = busyProgressIndicator()) {
+        indicator->update();
+    }
+
+    return filter->colorTransformation(projection->colorSpace(), filterConfig);
+}
+
 bool KisFilterMask::accept(KisNodeVisitor &v)
 {
     return v.visit(this);
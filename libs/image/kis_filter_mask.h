@@ -63,6 +63,8 @@ public:
                        const QRect & rc,
                        PositionToFilthy maskPos) const override;
 
+    QSharedPointer<KoColorTransformation> pixelTransformation(KisPaintDeviceSP projection, const QRect &applyRect) const override;
+
     QRect changeRect(const QRect &rect, PositionToFilthy pos = N_FILTHY) const override;
     QRect needRect(const QRect &rect, PositionToFilthy pos = N_FILTHY) const override;
 };
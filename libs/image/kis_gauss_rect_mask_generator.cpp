@@ -132,7 +132,7 @@ quint8 KisGaussRectangleMaskGenerator::valueAt(qreal x, qreal y) const
 
 bool KisGaussRectangleMaskGenerator::shouldVectorize() const
 {
-    return !shouldSupersample() && spikes() == 2;
+    return spikes() == 2;
 }
 
 KisBrushMaskApplicatorBase* KisGaussRectangleMaskGenerator::applicator()
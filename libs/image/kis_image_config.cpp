@@ -528,6 +528,16 @@ void KisImageConfig::setFpsLimit(int value)
     m_config.writeEntry("fpsLimit", value);
 }
 
+bool KisImageConfig::useHalfFloatLayerStorage(bool defaultValue) const
+{
+    return defaultValue ? false : m_config.readEntry("useHalfFloatLayerStorage", false);
+}
+
+void KisImageConfig::setUseHalfFloatLayerStorage(bool value)
+{
+    m_config.writeEntry("useHalfFloatLayerStorage", value);
+}
+
 bool KisImageConfig::useOnDiskAnimationCacheSwapping(bool defaultValue) const
 {
     return defaultValue ? true : m_config.readEntry("useOnDiskAnimationCacheSwapping", true);
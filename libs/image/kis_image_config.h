@@ -120,6 +120,14 @@ public:
     int fpsLimit(bool defaultValue = false) const;
     void setFpsLimit(int value);
 
+    /**
+     * When enabled, new paint layers of RGBA F32 images store their
+     * pixels in RGBA F16. The projection is still composited in F32.
+     * See KisLayerUtils::newPaintLayerColorSpace().
+     */
+    bool useHalfFloatLayerStorage(bool defaultValue = false) const;
+    void setUseHalfFloatLayerStorage(bool value);
+
     bool useOnDiskAnimationCacheSwapping(bool defaultValue = false) const;
     void setUseOnDiskAnimationCacheSwapping(bool value);
 
@@ -36,6 +36,7 @@
 #include <KoProperties.h>
 #include <KoCompositeOpRegistry.h>
 #include <KoColorSpace.h>
+#include <KoColorTransformation.h>
 
 #include "kis_debug.h"
 #include "kis_image.h"
@@ -58,6 +59,7 @@
 #include "krita_utils.h"
 #include "kis_layer_properties_icons.h"
 #include "kis_layer_utils.h"
+#include "kis_sequential_iterator.h"
 #include "kis_projection_leaf.h"
 
 
@@ -697,6 +699,55 @@ KisNode::PositionToFilthy calculatePositionToFilthy(KisNodeSP nodeInQuestion,
     return KisNode::N_BELOW_FILTHY;
 }
 
+namespace {
+
+/**
+ * Applies the transformations of \p chain one after another to every
+ * pixel of \p rect. The pixels are passed through two scratch buffers,
+ * so that no transformation is run in-place.
+ */
+void applyColorTransformationChain(KisPaintDeviceSP device, const QRect &rect,
+                                   const QVector<QSharedPointer<KoColorTransformation>> &chain)
+{
+    const int pixelSize = device->pixelSize();
+    QVector<quint8> buffers[2];
+
+    KisSequentialIterator it(device, rect);
+
+    int conseq = it.nConseqPixels();
+    while (it.nextPixels(conseq)) {
+        conseq = it.nConseqPixels();
+
+        if (buffers[0].size() < conseq * pixelSize) {
+            buffers[0].resize(conseq * pixelSize);
+            buffers[1].resize(conseq * pixelSize);
+        }
+
+        quint8 *pixels = it.rawData();
+        const int numBytes = conseq * pixelSize;
+
+        /**
+         * The transformations may leave the channels they don't touch
+         * (like alpha) as they are in dst, so the scratch buffers start
+         * as copies of the source pixels
+         */
+        memcpy(buffers[0].data(), pixels, numBytes);
+        if (chain.size() > 1) {
+            memcpy(buffers[1].data(), pixels, numBytes);
+        }
+
+        const quint8 *src = buffers[0].constData();
+
+        for (int i = 0; i < chain.size(); i++) {
+            quint8 *dst = i == chain.size() - 1 ? pixels : buffers[(i + 1) & 0x1].data();
+            chain[i]->transform(src, dst, conseq);
+            src = dst;
+        }
+    }
+}
+
+}
+
 QRect KisLayer::applyMasks(const KisPaintDeviceSP source,
                            KisPaintDeviceSP destination,
                            const QRect &requestedRect,
@@ -745,14 +796,41 @@ QRect KisLayer::applyMasks(const KisPaintDeviceSP source,
                 copyOriginalToProjection(source, destination, needRect);
             }
 
+            /**
+             * The chains of masks that are pure per-pixel color
+             * transformations are applied in a single pass right on
+             * the destination, without the intermediate devices
+             */
+            QVector<QSharedPointer<KoColorTransformation>> chain;
+            QRect chainRect;
+
             Q_FOREACH (const KisEffectMaskSP& mask, masks) {
                 const QRect maskApplyRect = applyRects.pop();
                 const QRect maskNeedRect =
                     applyRects.isEmpty() ? needRect : applyRects.top();
 
+                QSharedPointer<KoColorTransformation> transformation =
+                    mask->pixelTransformation(destination, maskApplyRect);
+
+                if (!chain.isEmpty() && (!transformation || maskApplyRect != chainRect)) {
+                    applyColorTransformationChain(destination, chainRect, chain);
+                    chain.clear();
+                }
+
+                if (transformation) {
+                    chain << transformation;
+                    chainRect = maskApplyRect;
+                    continue;
+                }
+
                 PositionToFilthy maskPosition = calculatePositionToFilthy(mask, filthyNode, const_cast<KisLayer*>(this));
                 mask->apply(destination, maskApplyRect, maskNeedRect, maskPosition);
             }
+
+            if (!chain.isEmpty()) {
+                applyColorTransformationChain(destination, chainRect, chain);
+            }
+
             Q_ASSERT(applyRects.isEmpty());
         } else {
             /**
@@ -22,6 +22,8 @@
 
 #include <QUuid>
 #include <KoColorSpaceConstants.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorModelStandardIds.h>
 #include <KoProperties.h>
 
 #include "kis_painter.h"
@@ -54,6 +56,7 @@
 #include <KisDelayedUpdateNodeInterface.h>
 #include "krita_utils.h"
 #include "kis_image_signal_router.h"
+#include "kis_image_config.h"
 
 
 namespace KisLayerUtils {
@@ -1146,6 +1149,28 @@ namespace KisLayerUtils {
         }
     }
 
+    const KoColorSpace* newPaintLayerColorSpace(KisImageSP image)
+    {
+        const KoColorSpace *cs = image->colorSpace();
+
+        if (cs->colorModelId() == RGBAColorModelID &&
+            cs->colorDepthId() == Float32BitsColorDepthID &&
+            KisImageConfig(true).useHalfFloatLayerStorage()) {
+
+            const KoColorSpace *halfFloatCs =
+                KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(),
+                                                             Float16BitsColorDepthID.id(),
+                                                             cs->profile());
+
+            // F16 is not available without OpenEXR
+            if (halfFloatCs) {
+                cs = halfFloatCs;
+            }
+        }
+
+        return cs;
+    }
+
     KisNodeList findNodesWithProps(KisNodeSP root, const KoProperties &props, bool excludeRoot)
     {
         KisNodeList nodes;
@@ -28,6 +28,7 @@
 
 class KoProperties;
 class KoColor;
+class KoColorSpace;
 class QUuid;
 
 namespace KisMetaData
@@ -72,6 +73,15 @@ namespace KisLayerUtils
 
     KRITAIMAGE_EXPORT void changeImageDefaultProjectionColor(KisImageSP image, const KoColor &color);
 
+    /**
+     * The color space new paint layers of \p image store their pixels
+     * in. It is the color space of the image, unless the image is RGBA
+     * F32 and KisImageConfig::useHalfFloatLayerStorage() is enabled.
+     * Then it is RGBA F16 with the same profile. The projection stays in
+     * F32, and the layers are converted to it while being composited.
+     */
+    KRITAIMAGE_EXPORT const KoColorSpace* newPaintLayerColorSpace(KisImageSP image);
+
     typedef QMap<int, QSet<KisNodeSP> > FrameJobs;
     void updateFrameJobs(FrameJobs *jobs, KisNodeSP node);
     void updateFrameJobsRecursive(FrameJobs *jobs, KisNodeSP rootNode);
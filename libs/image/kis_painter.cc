@@ -1442,17 +1442,7 @@ void KisPainter::Private::fillPainterPathImpl(const QPainterPath& path, const QR
             qint32 rectWidth = qMin(fillRect.x() + fillRect.width() - x, maskImageWidth);
             qint32 rectHeight = qMin(fillRect.y() + fillRect.height() - y, maskImageHeight);
 
-            KisHLineIteratorSP lineIt = polygon->createHLineIteratorNG(x, y, rectWidth);
-
-            quint8 tmp;
-            for (int row = y; row < y + rectHeight; row++) {
-                QRgb* line = reinterpret_cast<QRgb*>(polygonMaskImage.scanLine(row - y));
-                do {
-                    tmp = qRed(line[lineIt->x() - x]);
-                    polygon->colorSpace()->applyAlphaU8Mask(lineIt->rawData(), &tmp, 1);
-                } while (lineIt->nextPixel());
-                lineIt->nextRow();
-            }
+            applyPolygonMaskImage(x, y, rectWidth, rectHeight);
 
         }
     }
@@ -1519,17 +1509,7 @@ void KisPainter::drawPainterPath(const QPainterPath& path, const QPen& pen, cons
             qint32 rectWidth = qMin(fillRect.x() + fillRect.width() - x, d->maskImageWidth);
             qint32 rectHeight = qMin(fillRect.y() + fillRect.height() - y, d->maskImageHeight);
 
-            KisHLineIteratorSP lineIt = d->polygon->createHLineIteratorNG(x, y, rectWidth);
-
-            quint8 tmp;
-            for (int row = y; row < y + rectHeight; row++) {
-                QRgb* line = reinterpret_cast<QRgb*>(d->polygonMaskImage.scanLine(row - y));
-                do {
-                    tmp = qRed(line[lineIt->x() - x]);
-                    d->polygon->colorSpace()->applyAlphaU8Mask(lineIt->rawData(), &tmp, 1);
-                } while (lineIt->nextPixel());
-                lineIt->nextRow();
-            }
+            d->applyPolygonMaskImage(x, y, rectWidth, rectHeight);
 
         }
     }
@@ -1556,6 +1536,112 @@ inline void KisPainter::compositeOnePixel(quint8 *dst, const KoColor &color)
                           d->conversionFlags);
 }
 
+void KisPainter::Private::applyPolygonMaskImage(qint32 x, qint32 y, qint32 width, qint32 height)
+{
+    const KoColorSpace *polygonColorSpace = polygon->colorSpace();
+    QVector<quint8> maskRow(width);
+
+    KisHLineIteratorSP lineIt = polygon->createHLineIteratorNG(x, y, width);
+
+    for (int row = 0; row < height; row++) {
+        const QRgb *line = reinterpret_cast<const QRgb*>(polygonMaskImage.constScanLine(row));
+        for (int i = 0; i < width; i++) {
+            maskRow[i] = qRed(line[i]);
+        }
+
+        const quint8 *maskPtr = maskRow.constData();
+        qint32 numPixels = 0;
+
+        do {
+            numPixels = lineIt->nConseqPixels();
+            polygonColorSpace->applyAlphaU8Mask(lineIt->rawData(), maskPtr, numPixels);
+            maskPtr += numPixels;
+        } while (lineIt->nextPixels(numPixels));
+
+        lineIt->nextRow();
+    }
+}
+
+void KisPainter::Private::compositeHSpan(KisRandomAccessorSP accessor,
+                                         KisRandomConstAccessorSP selectionAccessor,
+                                         qint32 x, qint32 y, qint32 length,
+                                         const KoColor &color)
+{
+    if (length <= 0) return;
+
+    if (selectionAccessor || !(*color.colorSpace() == *colorSpace)) {
+        for (qint32 i = 0; i < length; i++) {
+            accessor->moveTo(x + i, y);
+            if (selectionAccessor) selectionAccessor->moveTo(x + i, y);
+
+            if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
+                q->compositeOnePixel(accessor->rawData(), color);
+            }
+        }
+        return;
+    }
+
+    paramInfo.srcRowStart = color.data();
+    paramInfo.srcRowStride = 0;
+    paramInfo.maskRowStart = 0;
+    paramInfo.maskRowStride = 0;
+    paramInfo.rows = 1;
+
+    qint32 i = 0;
+    while (i < length) {
+        accessor->moveTo(x + i, y);
+        const qint32 numPixels = qMin(length - i, accessor->numContiguousColumns(x + i));
+
+        paramInfo.dstRowStart = accessor->rawData();
+        paramInfo.dstRowStride = 0;
+        paramInfo.cols = numPixels;
+
+        compositeOp->composite(paramInfo);
+
+        i += numPixels;
+    }
+}
+
+void KisPainter::Private::compositeVSpan(KisRandomAccessorSP accessor,
+                                         KisRandomConstAccessorSP selectionAccessor,
+                                         qint32 x, qint32 y, qint32 length,
+                                         const KoColor &color)
+{
+    if (length <= 0) return;
+
+    if (selectionAccessor || !(*color.colorSpace() == *colorSpace)) {
+        for (qint32 i = 0; i < length; i++) {
+            accessor->moveTo(x, y + i);
+            if (selectionAccessor) selectionAccessor->moveTo(x, y + i);
+
+            if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
+                q->compositeOnePixel(accessor->rawData(), color);
+            }
+        }
+        return;
+    }
+
+    paramInfo.srcRowStart = color.data();
+    paramInfo.srcRowStride = 0;
+    paramInfo.maskRowStart = 0;
+    paramInfo.maskRowStride = 0;
+    paramInfo.cols = 1;
+
+    qint32 i = 0;
+    while (i < length) {
+        accessor->moveTo(x, y + i);
+        const qint32 numPixels = qMin(length - i, accessor->numContiguousRows(y + i));
+
+        paramInfo.dstRowStart = accessor->rawData();
+        paramInfo.dstRowStride = accessor->rowStride(x, y + i);
+        paramInfo.rows = numPixels;
+
+        compositeOp->composite(paramInfo);
+
+        i += numPixels;
+    }
+}
+
 /**/
 void KisPainter::drawLine(const QPointF& start, const QPointF& end, qreal width, bool antialias){
     int x1 = qFloor(start.x());
@@ -1603,6 +1689,16 @@ void KisPainter::drawLine(const QPointF& start, const QPointF& end, qreal width,
         selectionAccessor = d->selection->projection()->createRandomConstAccessorNG(x1, y1);
     }
 
+    /**
+     * The fully covered pixels of every row are composited in
+     * tile-contiguous spans. The antialiased edge pixels keep
+     * multiplying the alpha of the color itself, so that the coverage
+     * is not quantized to 8 bits on the high bit depth devices.
+     */
+    const int rowStart = x1 - W_;
+    const int rowLength = x2 - x1 + 2 * W_;
+    QVector<qreal> coverage(rowLength);
+
     for (int y = y1-W_; y < y2+W_ ; y++){
         for (int x = x1-W_; x < x2+W_; x++){
 
@@ -1617,22 +1713,44 @@ void KisPainter::drawLine(const QPointF& start, const QPointF& end, qreal width,
                 AA_ = qAbs(dstY*x - dstX*y + uniC) * denominator;
             }
 
+            qreal &value = coverage[x - rowStart];
+
             if (AA_>halfWidth) {
+                value = 0.0;
+            } else if (antialias && AA_ > halfWidth-1.0) {
+                value = 1.0 - (AA_-(halfWidth-1.0));
+            } else {
+                value = 1.0;
+            }
+        }
+
+        int i = 0;
+        while (i < rowLength) {
+            if (coverage[i] == 1.0) {
+                int spanEnd = i + 1;
+                while (spanEnd < rowLength && coverage[spanEnd] == 1.0) spanEnd++;
+
+                d->compositeHSpan(accessor, selectionAccessor,
+                                  rowStart + i, y, spanEnd - i,
+                                  d->paintColor);
+                i = spanEnd;
                 continue;
             }
 
-            accessor->moveTo(x, y);
-            if (selectionAccessor) selectionAccessor->moveTo(x,y);
+            if (coverage[i] > 0.0) {
+                const int x = rowStart + i;
 
-            if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                KoColor mycolor = d->paintColor;
+                accessor->moveTo(x, y);
+                if (selectionAccessor) selectionAccessor->moveTo(x,y);
 
-                if (antialias && AA_ > halfWidth-1.0) {
-                    mycolor.colorSpace()->multiplyAlpha(mycolor.data(), 1.0 - (AA_-(halfWidth-1.0)), 1);
+                if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
+                    KoColor mycolor = d->paintColor;
+                    mycolor.colorSpace()->multiplyAlpha(mycolor.data(), coverage[i], 1);
+                    compositeOnePixel(accessor->rawData(), mycolor);
                 }
-
-                compositeOnePixel(accessor->rawData(), mycolor);
             }
+
+            i++;
         }
     }
 }
@@ -1823,39 +1941,21 @@ void KisPainter::drawWuLine(const QPointF & start, const QPointF & end)
     yd = (y2 - y1);
 
     if (yd == 0) {
-        /* Horizontal line */
-        int incr = (x1 < x2) ? 1 : -1;
-        ix1 = x1;
-        ix2 = x2;
-        iy1 = y1;
-        while (ix1 != ix2) {
-            ix1 = ix1 + incr;
-
-            accessor->moveTo(ix1, iy1);
-            if (selectionAccessor) selectionAccessor->moveTo(ix1, iy1);
-
-            if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                compositeOnePixel(accessor->rawData(), lineColor);
-            }
+        /* Horizontal line, the starting point is not painted */
+        if (x1 < x2) {
+            d->compositeHSpan(accessor, selectionAccessor, x1 + 1, y1, x2 - x1, lineColor);
+        } else {
+            d->compositeHSpan(accessor, selectionAccessor, x2, y1, x1 - x2, lineColor);
         }
         return;
     }
 
     if (xd == 0) {
-        /* Vertical line */
-        int incr = (y1 < y2) ? 1 : -1;
-        iy1 = y1;
-        iy2 = y2;
-        ix1 = x1;
-        while (iy1 != iy2) {
-            iy1 = iy1 + incr;
-
-            accessor->moveTo(ix1, iy1);
-            if (selectionAccessor) selectionAccessor->moveTo(ix1, iy1);
-
-            if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                compositeOnePixel(accessor->rawData(), lineColor);
-            }
+        /* Vertical line, the starting point is not painted */
+        if (y1 < y2) {
+            d->compositeVSpan(accessor, selectionAccessor, x1, y1 + 1, y2 - y1, lineColor);
+        } else {
+            d->compositeVSpan(accessor, selectionAccessor, x1, y2, y1 - y2, lineColor);
         }
         return;
     }
@@ -2128,41 +2228,11 @@ void KisPainter::drawThickLine(const QPointF & start, const QPointF & end, int s
     }
 
     if (horizontal) { // draw endpoints
-        for (int i = y0a; i <= y0b; i++) {
-
-            accessor->moveTo(x0, i);
-            if (selectionAccessor) selectionAccessor->moveTo(x0, i);
-
-            if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                compositeOnePixel(accessor->rawData(), c1);
-            }
-        }
-        for (int i = y1a; i <= y1b; i++) {
-
-            accessor->moveTo(x1, i);
-            if (selectionAccessor) selectionAccessor->moveTo(x1, i);
-
-            if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                compositeOnePixel(accessor->rawData(), c1);
-            }
-        }
-
+        d->compositeVSpan(accessor, selectionAccessor, x0, y0a, y0b - y0a + 1, c1);
+        d->compositeVSpan(accessor, selectionAccessor, x1, y1a, y1b - y1a + 1, c1);
     } else {
-        for (int i = x0a; i <= x0b; i++) {
-
-            accessor->moveTo(i, y0);
-            if (selectionAccessor) selectionAccessor->moveTo(i, y0);
-
-            if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                compositeOnePixel(accessor->rawData(), c1);
-            }
-        }
-        for (int i = x1a; i <= x1b; i++) {
-            accessor->moveTo(i, y1);
-            if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                compositeOnePixel(accessor->rawData(), c1);
-            }
-        }
+        d->compositeHSpan(accessor, selectionAccessor, x0a, y0, x0b - x0a + 1, c1);
+        d->compositeHSpan(accessor, selectionAccessor, x1a, y1, x1b - x1a + 1, c1);
     }
 
     //antialias endpoints
@@ -2310,27 +2380,13 @@ void KisPainter::drawThickLine(const QPointF & start, const QPointF & end, int s
 
             // fill remaining pixels
             if (!(startWidth == 1 && endWidth == 1)) {
-                if (yfa < yfb)
-                    for (int i = qFloor(yfa) + 1; i <= qFloor(yfb); i++) {
-
-                        accessor->moveTo(x, i);
-                        if (selectionAccessor) selectionAccessor->moveTo(x, i);
-
-                        if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                            compositeOnePixel(accessor->rawData(), c3);
-                        }
-                    }
-                else
-                    for (int i = qFloor(yfa) + 1; i >= qFloor(yfb); i--) {
-
-                        accessor->moveTo(x, i);
-                        if (selectionAccessor) selectionAccessor->moveTo(x, i);
-
-                        if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                            compositeOnePixel(accessor->rawData(), c3);
-                        }
-                    }
-
+                if (yfa < yfb) {
+                    d->compositeVSpan(accessor, selectionAccessor,
+                                      x, qFloor(yfa) + 1, qFloor(yfb) - qFloor(yfa), c3);
+                } else {
+                    d->compositeVSpan(accessor, selectionAccessor,
+                                      x, qFloor(yfb), qFloor(yfa) + 2 - qFloor(yfb), c3);
+                }
             }
 
             yfa += grada;
@@ -2428,26 +2484,13 @@ void KisPainter::drawThickLine(const QPointF & start, const QPointF & end, int s
 
             // fill remaining pixels between current xfa,xfb
             if (!(startWidth == 1 && endWidth == 1)) {
-                if (xfa < xfb)
-                    for (int i = qFloor(xfa) + 1; i <= qFloor(xfb); i++) {
-
-                        accessor->moveTo(i, y);
-                        if (selectionAccessor) selectionAccessor->moveTo(i, y);
-
-                        if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                            compositeOnePixel(accessor->rawData(), c3);
-                        }
-                    }
-                else
-                    for (int i = qFloor(xfb); i <= qFloor(xfa) + 1; i++) {
-
-                        accessor->moveTo(i, y);
-                        if (selectionAccessor) selectionAccessor->moveTo(i, y);
-
-                        if (!selectionAccessor || *selectionAccessor->oldRawData() > SELECTION_THRESHOLD) {
-                            compositeOnePixel(accessor->rawData(), c3);
-                        }
-                    }
+                if (xfa < xfb) {
+                    d->compositeHSpan(accessor, selectionAccessor,
+                                      qFloor(xfa) + 1, y, qFloor(xfb) - qFloor(xfa), c3);
+                } else {
+                    d->compositeHSpan(accessor, selectionAccessor,
+                                      qFloor(xfb), y, qFloor(xfa) + 2 - qFloor(xfb), c3);
+                }
             }
 
             xfa += grada;
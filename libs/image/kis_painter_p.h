@@ -87,6 +87,36 @@ struct Q_DECL_HIDDEN KisPainter::Private {
 
     void fillPainterPathImpl(const QPainterPath& path, const QRect &requestedRect);
 
+    /**
+     * Applies the red channel of polygonMaskImage to the alpha channel
+     * of the polygon device in the rect (\p x, \p y, \p width, \p height).
+     * The mask is passed to the color space in tile-contiguous runs.
+     */
+    void applyPolygonMaskImage(qint32 x, qint32 y, qint32 width, qint32 height);
+
+    /**
+     * Composites \p color onto a horizontal span of \p length pixels
+     * starting at (\p x, \p y). The span is split into tile-contiguous
+     * runs and every run is passed to the composite op in a single call,
+     * which gives the same result as compositing the pixels one by one.
+     *
+     * When there is a selection, or the color needs conversion, the
+     * pixels are composited one by one.
+     */
+    void compositeHSpan(KisRandomAccessorSP accessor,
+                        KisRandomConstAccessorSP selectionAccessor,
+                        qint32 x, qint32 y, qint32 length,
+                        const KoColor &color);
+
+    /**
+     * The same as compositeHSpan(), but for a vertical span of pixels
+     * starting at (\p x, \p y)
+     */
+    void compositeVSpan(KisRandomAccessorSP accessor,
+                        KisRandomConstAccessorSP selectionAccessor,
+                        qint32 x, qint32 y, qint32 length,
+                        const KoColor &color);
+
     void applyDevice(const QRect &applyRect,
                      const KisRenderedDab &dab,
                      KisRandomAccessorSP dstIt,
@@ -106,7 +106,7 @@ bool KisRectangleMaskGenerator::shouldSupersample() const
 
 bool KisRectangleMaskGenerator::shouldVectorize() const
 {
-    return !shouldSupersample() && spikes() == 2;
+    return spikes() == 2;
 }
 
 KisBrushMaskApplicatorBase* KisRectangleMaskGenerator::applicator()
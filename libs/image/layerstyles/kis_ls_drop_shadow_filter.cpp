@@ -29,7 +29,7 @@
 
 #include "kis_convolution_kernel.h"
 #include "kis_convolution_painter.h"
-#include "kis_gaussian_kernel.h"
+#include "KisDistanceTransform.h"
 
 #include "kis_pixel_selection.h"
 #include "kis_fill_painter.h"
@@ -90,7 +90,7 @@ struct ShadowRectsData
             KisLsUtils::growRectFromRadius(noiseNeedRect, blur_size) : noiseNeedRect;
 
         spreadNeedRect = spread_size ?
-            KisLsUtils::growRectFromRadius(blurNeedRect, spread_size) : blurNeedRect;
+            kisGrowRect(blurNeedRect, spread_size + 1) : blurNeedRect;
 
         // dbgKrita << ppVar(dstRect);
         // dbgKrita << ppVar(srcRect);
@@ -157,11 +157,12 @@ void applyDropShadow(KisPaintDeviceSP srcDevice,
      * Spread and blur the selection
      */
     if (d.spread_size) {
-        KisLsUtils::applyGaussianWithTransaction(selection, d.blurNeedRect, d.spread_size);
-
-        // TODO: find out why in libpsd we pass false here. If we do so,
-        //       the result is fully black, which is not expected
-        KisLsUtils::findEdge(selection, d.blurNeedRect, true /*shadow->edgeHidden()*/);
+        /**
+         * The pixels outside the rect are considered unselected by the
+         * distance transform, so it should be given the whole area the
+         * spread reads, not just the area the blur needs
+         */
+        KisDistanceTransform::applyGrow(selection, d.spreadNeedRect, d.spread_size, d.spread_size);
     }
 
     //selection->convertToQImage(0, QRect(0,0,300,300)).save("1_selection_spread.png");
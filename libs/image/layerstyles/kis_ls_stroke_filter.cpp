@@ -30,7 +30,7 @@
 
 #include "kis_convolution_kernel.h"
 #include "kis_convolution_painter.h"
-#include "kis_gaussian_kernel.h"
+#include "KisDistanceTransform.h"
 
 #include "kis_pixel_selection.h"
 #include "kis_fill_painter.h"
@@ -100,13 +100,23 @@ void KisLsStrokeFilter::applyStroke(KisPaintDeviceSP srcDevice,
         KisPixelSelectionSP knockOutSelection = new KisPixelSelection(new KisSelectionEmptyBounds(0));
         knockOutSelection->makeCloneFromRough(selection, needRect);
 
+        /**
+         * The stroke used to be built with the dilate kernel of
+         * KisGaussianKernel, which is fully opaque up to radius - 1
+         * and fades out at the radius itself. The distance transform
+         * fades out one pixel further, hence the radii are decreased
+         * by one to keep the width of the stroke.
+         */
+        const int fullRadius = qMax(0, 2 * config->size() - 1);
+        const int halfRadius = qMax(0, config->size() - 1);
+
         if (config->position() == psd_stroke_outside) {
-            KisGaussianKernel::applyDilate(selection, needRect, 2 * config->size(), QBitArray(), 0, true);
+            KisDistanceTransform::applyGrow(selection, needRect, fullRadius, fullRadius);
         } else if (config->position() == psd_stroke_inside) {
-            KisGaussianKernel::applyErodeU8(knockOutSelection, needRect, 2 * config->size(), QBitArray(), 0, true);
+            KisDistanceTransform::applyShrink(knockOutSelection, needRect, fullRadius, fullRadius, false);
         } else if (config->position() == psd_stroke_center) {
-            KisGaussianKernel::applyDilate(selection, needRect, config->size(), QBitArray(), 0, true);
-            KisGaussianKernel::applyErodeU8(knockOutSelection, needRect, config->size(), QBitArray(), 0, true);
+            KisDistanceTransform::applyGrow(selection, needRect, halfRadius, halfRadius);
+            KisDistanceTransform::applyShrink(knockOutSelection, needRect, halfRadius, halfRadius, false);
         }
 
         KisPainter gc(selection);
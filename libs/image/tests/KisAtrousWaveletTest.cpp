@@ -0,0 +1,207 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisAtrousWaveletTest.h"
+
+#include <QTest>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_paint_device.h"
+#include "kis_convolution_kernel.h"
+#include "kis_convolution_painter.h"
+#include "kis_sequential_iterator.h"
+#include "KisAtrousWavelet.h"
+#include "testutil.h"
+
+
+namespace {
+
+KisPaintDeviceSP createReferenceDevice()
+{
+    QImage referenceImage(QString(FILES_DATA_DIR) + QDir::separator() + "hakonepa.png");
+
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    dev->convertFromQImage(referenceImage, 0, 0, 0);
+
+    return dev;
+}
+
+KisPaintDeviceSP createNoisyDevice(const QRect &rect, int amplitude)
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    dev->fill(rect, KoColor(QColor(128, 128, 128), cs));
+
+    qsrand(1);
+
+    KisSequentialIterator it(dev, rect);
+    while (it.nextPixel()) {
+        quint8 *pixel = it.rawData();
+        for (int i = 0; i < 3; i++) {
+            pixel[i] += qrand() % (2 * amplitude + 1) - amplitude;
+        }
+    }
+
+    return dev;
+}
+
+qreal deviation(KisPaintDeviceSP dev, const QRect &rect, qreal *mean)
+{
+    qreal sum = 0.0;
+    qreal squaresSum = 0.0;
+    int count = 0;
+
+    KisSequentialConstIterator it(dev, rect);
+    while (it.nextPixel()) {
+        const quint8 *pixel = it.rawDataConst();
+        for (int i = 0; i < 3; i++) {
+            sum += pixel[i];
+            squaresSum += pow2(qreal(pixel[i]));
+            count++;
+        }
+    }
+
+    *mean = sum / count;
+    return std::sqrt(squaresSum / count - pow2(*mean));
+}
+
+}
+
+void KisAtrousWaveletTest::testSmoothing_data()
+{
+    QTest::addColumn<int>("level");
+
+    QTest::newRow("level0") << 0;
+    QTest::newRow("level2") << 2;
+    QTest::newRow("level5") << 5;
+}
+
+void KisAtrousWaveletTest::testSmoothing()
+{
+    QFETCH(int, level);
+
+    KisPaintDeviceSP dev = createReferenceDevice();
+    const QRect imageRect = dev->exactBounds();
+    const QRect applyRect = imageRect.adjusted(13, 7, -5, -11);
+    const QBitArray channelFlags = dev->colorSpace()->channelFlags(true, true);
+
+    /**
+     * The reference is the convolution with the 2D kernel of the level
+     */
+    const int step = 1 << level;
+    const int kernelSize = 2 * step + 1;
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, 1> taps = Eigen::Matrix<qreal, Eigen::Dynamic, 1>::Zero(kernelSize);
+    taps(0) = 0.25;
+    taps(step) = 0.5;
+    taps(2 * step) = 0.25;
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> matrix = taps * taps.transpose();
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMatrix(matrix, 0, matrix.sum());
+
+    KisPaintDeviceSP convolutionDev = new KisPaintDevice(*dev);
+    KisConvolutionPainter painter(convolutionDev);
+    painter.setChannelFlags(channelFlags);
+    painter.applyMatrix(kernel, convolutionDev, applyRect.topLeft(), applyRect.topLeft(),
+                        applyRect.size(), BORDER_REPEAT);
+
+    KisPaintDeviceSP waveletDev = new KisPaintDevice(*dev);
+    QVERIFY(KisAtrousWavelet::applySmoothing(waveletDev, applyRect, level, channelFlags, 0));
+
+    QImage convolutionImage = convolutionDev->convertToQImage(0, imageRect);
+    QImage waveletImage = waveletDev->convertToQImage(0, imageRect);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, convolutionImage, waveletImage, 1, 1)) {
+        convolutionImage.save(QString("atrous_smoothing_%1_convolution.png").arg(level));
+        waveletImage.save(QString("atrous_smoothing_%1_wavelet.png").arg(level));
+        QFAIL(QString("Smoothing differs from the convolution, first failed pixel: %1,%2")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
+void KisAtrousWaveletTest::testReconstruction()
+{
+    KisPaintDeviceSP dev = createReferenceDevice();
+    const QRect imageRect = dev->exactBounds();
+    const QBitArray channelFlags = dev->colorSpace()->channelFlags(true, false);
+
+    KisPaintDeviceSP waveletDev = new KisPaintDevice(*dev);
+    QVERIFY(KisAtrousWavelet::applyNoiseReduction(waveletDev, imageRect, 0.0, channelFlags, 0));
+
+    // with zero threshold the bands sum up to the original image
+    QImage referenceImage = dev->convertToQImage(0, imageRect);
+    QImage waveletImage = waveletDev->convertToQImage(0, imageRect);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, referenceImage, waveletImage, 0, 0)) {
+        QFAIL(QString("Reconstruction differs from the original, first failed pixel: %1,%2")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
+void KisAtrousWaveletTest::testNoiseReduction()
+{
+    const QRect rect(0, 0, 300, 200);
+    KisPaintDeviceSP dev = createNoisyDevice(rect, 20);
+
+    qreal meanBefore = 0.0;
+    const qreal deviationBefore = deviation(dev, rect, &meanBefore);
+
+    QVERIFY(KisAtrousWavelet::applyNoiseReduction(dev, rect, 20.0, dev->colorSpace()->channelFlags(true, false), 0));
+
+    qreal meanAfter = 0.0;
+    const qreal deviationAfter = deviation(dev, rect, &meanAfter);
+
+    QVERIFY(deviationAfter < 0.5 * deviationBefore);
+    QVERIFY(qAbs(meanAfter - meanBefore) < 1.0);
+
+    // the alpha channel is not touched
+    QCOMPARE(dev->pixel(QPoint(10, 10)).opacityU8(), OPACITY_OPAQUE_U8);
+}
+
+void KisAtrousWaveletTest::testPartialUpdate()
+{
+    const QRect rect(0, 0, 600, 400);
+    KisPaintDeviceSP dev = createNoisyDevice(rect, 30);
+    const QBitArray channelFlags = dev->colorSpace()->channelFlags(true, false);
+
+    KisPaintDeviceSP fullDev = new KisPaintDevice(*dev);
+    QVERIFY(KisAtrousWavelet::applyNoiseReduction(fullDev, rect, 10.0, channelFlags, 0));
+
+    /**
+     * The rect crosses the borders of the blocks, the pixels around it
+     * are read from the guard borders
+     */
+    const QRect partialRect(230, 100, 100, 250);
+    KisPaintDeviceSP partialDev = new KisPaintDevice(*dev);
+    QVERIFY(KisAtrousWavelet::applyNoiseReduction(partialDev, partialRect, 10.0, channelFlags, 0));
+
+    QImage fullImage = fullDev->convertToQImage(0, partialRect);
+    QImage partialImage = partialDev->convertToQImage(0, partialRect);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, fullImage, partialImage, 0, 0)) {
+        QFAIL(QString("Partial update differs from the full one, first failed pixel: %1,%2")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
+QTEST_MAIN(KisAtrousWaveletTest)
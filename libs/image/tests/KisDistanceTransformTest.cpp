@@ -0,0 +1,150 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisDistanceTransformTest.h"
+
+#include <QTest>
+
+#include <cfloat>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_global.h"
+#include "kis_paint_device.h"
+#include "KisDistanceTransform.h"
+
+
+void KisDistanceTransformTest::testSquaredDistance_data()
+{
+    QTest::addColumn<bool>("inverted");
+    QTest::addColumn<qreal>("xScale");
+    QTest::addColumn<qreal>("yScale");
+
+    QTest::newRow("plain") << false << 1.0 << 1.0;
+    QTest::newRow("inverted") << true << 1.0 << 1.0;
+    QTest::newRow("scaled") << false << 1.5 << 0.7;
+}
+
+void KisDistanceTransformTest::testSquaredDistance()
+{
+    QFETCH(bool, inverted);
+    QFETCH(qreal, xScale);
+    QFETCH(qreal, yScale);
+
+    const int width = 37;
+    const int height = 29;
+
+    qsrand(1);
+
+    QVector<quint8> data(width * height);
+    for (int i = 0; i < data.size(); i++) {
+        const bool isFeature = qrand() % 50 == 0;
+        data[i] = isFeature != inverted ? 200 : 10;
+    }
+
+    QVector<float> result(data.size());
+    KisDistanceTransform::squaredDistance(data.constData(), width, height, result.data(),
+                                          inverted, xScale, yScale);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            qreal expected = FLT_MAX;
+
+            for (int j = 0; j < height; j++) {
+                for (int i = 0; i < width; i++) {
+                    const bool isSelected = data[j * width + i] >= KisDistanceTransform::featureThreshold;
+                    if (isSelected == inverted) continue;
+
+                    expected = qMin(expected, pow2(xScale * (x - i)) + pow2(yScale * (y - j)));
+                }
+            }
+
+            QVERIFY(qAbs(result[y * width + x] - expected) < 1e-3);
+        }
+    }
+
+    QVector<quint8> empty(width * height, inverted ? 255 : 0);
+    KisDistanceTransform::squaredDistance(empty.constData(), width, height, result.data(), inverted);
+
+    Q_FOREACH (float value, result) {
+        QCOMPARE(value, FLT_MAX);
+    }
+}
+
+void KisDistanceTransformTest::testGrowShrink()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->alpha8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect rect(0, 0, 200, 200);
+    const QRect square(90, 80, 20, 30);
+
+    dev->fill(square, KoColor(Qt::white, cs));
+
+    KisDistanceTransform::applyGrow(dev, rect, 40, 40);
+
+    /**
+     * The corners are rounded, so the bounds are defined by the sides
+     */
+    QCOMPARE(dev->exactBounds(), square.adjusted(-40, -40, 40, 40));
+    QCOMPARE(dev->pixel(QPoint(50, 100)).opacityU8(), quint8(255));
+    QCOMPARE(dev->pixel(QPoint(50, 80 - 40)).opacityU8(), quint8(0));
+
+    KisDistanceTransform::applyShrink(dev, rect, 40, 40, false);
+    QCOMPARE(dev->exactBounds(), square);
+}
+
+void KisDistanceTransformTest::testShrinkEdgeLock()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->alpha8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect rect(0, 0, 100, 100);
+    dev->fill(rect, KoColor(Qt::white, cs));
+
+    KisDistanceTransform::applyShrink(dev, rect, 10, 10, true);
+    QCOMPARE(dev->exactBounds(), rect);
+
+    KisDistanceTransform::applyShrink(dev, rect, 10, 10, false);
+    QCOMPARE(dev->exactBounds(), rect.adjusted(10, 10, -10, -10));
+}
+
+void KisDistanceTransformTest::testFeather()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->alpha8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect rect(0, 0, 200, 200);
+    const QRect square(50, 50, 100, 100);
+
+    dev->fill(square, KoColor(Qt::white, cs));
+
+    KisDistanceTransform::applyFeather(dev, rect, 20);
+
+    // the values fade monotonically across the edge
+    QVERIFY(dev->pixel(QPoint(100, 49)).opacityU8() < 128);
+    QVERIFY(dev->pixel(QPoint(100, 50)).opacityU8() > 128);
+    QVERIFY(dev->pixel(QPoint(100, 40)).opacityU8() < dev->pixel(QPoint(100, 49)).opacityU8());
+    QVERIFY(dev->pixel(QPoint(100, 60)).opacityU8() > dev->pixel(QPoint(100, 50)).opacityU8());
+
+    QCOMPARE(dev->pixel(QPoint(100, 100)).opacityU8(), quint8(255));
+    QCOMPARE(dev->pixel(QPoint(100, 5)).opacityU8(), quint8(0));
+}
+
+QTEST_MAIN(KisDistanceTransformTest)
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisMorphologyTest.h"
+
+#include <QTest>
+
+#include <cmath>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_global.h"
+
+#include "kis_paint_device.h"
+#include "KisMorphology.h"
+
+
+void KisMorphologyTest::testRectangle_data()
+{
+    QTest::addColumn<int>("operation");
+    QTest::addColumn<int>("xRadius");
+    QTest::addColumn<int>("yRadius");
+    QTest::addColumn<int>("outsideValue");
+
+    QTest::newRow("dilate-1x1") << int(KisMorphology::Dilate) << 1 << 1 << 0;
+    QTest::newRow("dilate-4x2") << int(KisMorphology::Dilate) << 4 << 2 << 0;
+    QTest::newRow("dilate-0x3") << int(KisMorphology::Dilate) << 0 << 3 << 0;
+    QTest::newRow("dilate-7x7-outside") << int(KisMorphology::Dilate) << 7 << 7 << 128;
+    QTest::newRow("erode-1x1") << int(KisMorphology::Erode) << 1 << 1 << 255;
+    QTest::newRow("erode-3x5") << int(KisMorphology::Erode) << 3 << 5 << 255;
+    QTest::newRow("erode-6x0-outside") << int(KisMorphology::Erode) << 6 << 0 << 0;
+}
+
+void KisMorphologyTest::testRectangle()
+{
+    QFETCH(int, operation);
+    QFETCH(int, xRadius);
+    QFETCH(int, yRadius);
+    QFETCH(int, outsideValue);
+
+    const int width = 53;
+    const int height = 41;
+
+    qsrand(1);
+
+    QVector<quint8> source(width * height);
+    for (int i = 0; i < source.size(); i++) {
+        source[i] = qrand() % 256;
+    }
+
+    QVector<quint8> result = source;
+    KisMorphology::apply(result.data(), width, height,
+                         KisMorphology::Operation(operation), KisMorphology::Rectangle,
+                         xRadius, yRadius, outsideValue);
+
+    const bool isDilate = operation == KisMorphology::Dilate;
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int expected = isDilate ? 0 : 255;
+
+            for (int j = -yRadius; j <= yRadius; j++) {
+                for (int i = -xRadius; i <= xRadius; i++) {
+                    const int sx = x + i;
+                    const int sy = y + j;
+
+                    const int value =
+                        sx < 0 || sy < 0 || sx >= width || sy >= height ?
+                        outsideValue : source[sy * width + sx];
+
+                    expected = isDilate ? qMax(expected, value) : qMin(expected, value);
+                }
+            }
+
+            if (result[y * width + x] != expected) {
+                qDebug() << "Failed pixel" << x << y << result[y * width + x] << expected;
+                QFAIL("Result differs from the brute-force one");
+            }
+        }
+    }
+}
+
+void KisMorphologyTest::testEllipse()
+{
+    const int xRadius = 100;
+    const int yRadius = 70;
+    const int size = 2 * xRadius + 21;
+    const int center = size / 2;
+
+    QVector<quint8> data(size * size, 0);
+    data[center * size + center] = 255;
+
+    KisMorphology::apply(data.data(), size, size,
+                         KisMorphology::Dilate, KisMorphology::Ellipse,
+                         xRadius, yRadius);
+
+    /**
+     * The dilated point should repeat the shape of the structuring
+     * element, which deviates from the true ellipse by a few pixels
+     */
+    const qreal tolerance = 3.0;
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            const qreal distance =
+                std::sqrt(pow2(qreal(x - center) / xRadius) + pow2(qreal(y - center) / yRadius));
+            const qreal error = qAbs(distance - 1.0) * yRadius;
+
+            const bool isInside = data[y * size + x];
+
+            if (error > tolerance && isInside != (distance < 1.0)) {
+                qDebug() << "Failed pixel" << x << y << isInside << distance;
+                QFAIL("Dilated point deviates from the ellipse");
+            }
+        }
+    }
+}
+
+void KisMorphologyTest::testPaintDevice()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->alpha8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect rect(10, 20, 100, 80);
+    const QRect square(50, 50, 10, 10);
+
+    dev->fill(square, KoColor(Qt::white, cs));
+
+    KisMorphology::apply(dev, rect, KisMorphology::Dilate, KisMorphology::Rectangle, 5, 3);
+    QCOMPARE(dev->exactBounds(), square.adjusted(-5, -3, 5, 3));
+
+    KisMorphology::apply(dev, rect, KisMorphology::Erode, KisMorphology::Rectangle, 5, 3);
+    QCOMPARE(dev->exactBounds(), square);
+
+    KisMorphology::apply(dev, rect, KisMorphology::Erode, KisMorphology::Rectangle, 5, 5);
+    QCOMPARE(dev->exactBounds(), QRect());
+}
+
+QTEST_MAIN(KisMorphologyTest)
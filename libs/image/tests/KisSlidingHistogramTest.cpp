@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisSlidingHistogramTest.h"
+
+#include <QTest>
+
+#include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
+
+#include "kis_assert.h"
+#include "kis_paint_device.h"
+#include "kis_sequential_iterator.h"
+#include "KisSlidingHistogram.h"
+
+
+namespace {
+
+KisPaintDeviceSP createRandomDevice(const QRect &rect)
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->alpha8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    qsrand(1);
+
+    KisSequentialIterator it(dev, rect);
+    while (it.nextPixel()) {
+        *it.rawData() = qrand() % 256;
+    }
+
+    return dev;
+}
+
+}
+
+void KisSlidingHistogramTest::testMedian_data()
+{
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<QRect>("sourceRect");
+
+    QTest::newRow("r1") << 1 << QRect(-20, -20, 200, 200);
+    QTest::newRow("r5") << 5 << QRect(-20, -20, 200, 200);
+    QTest::newRow("r7-clipped") << 7 << QRect(10, 5, 100, 60);
+}
+
+void KisSlidingHistogramTest::testMedian()
+{
+    QFETCH(int, radius);
+    QFETCH(QRect, sourceRect);
+
+    const QRect rect(-10, 0, 140, 70);
+
+    KisPaintDeviceSP src = createRandomDevice(QRect(-20, -20, 200, 200));
+    KisPaintDeviceSP dst = new KisPaintDevice(src->colorSpace());
+
+    KisSlidingHistogram::apply(src, dst, rect, sourceRect, radius, 256, false,
+        [] (const quint8 *pixel) {
+            return *pixel;
+        },
+        [] (const KisSlidingHistogram::Window &window, const quint8 *, quint8 *dstPixel) {
+            *dstPixel = window.percentileBin(0.5);
+        });
+
+    for (int y = rect.top(); y <= rect.bottom(); y++) {
+        for (int x = rect.left(); x <= rect.right(); x++) {
+            const QRect windowRect = QRect(x - radius, y - radius, 2 * radius + 1, 2 * radius + 1) & sourceRect;
+
+            QVector<quint8> values(windowRect.width() * windowRect.height());
+            src->readBytes(values.data(), windowRect);
+            std::sort(values.begin(), values.end());
+
+            const quint8 expected = values[(values.size() - 1) / 2];
+
+            quint8 result = 0;
+            dst->readBytes(&result, x, y, 1, 1);
+
+            if (result != expected) {
+                qDebug() << "Failed pixel" << x << y << result << expected;
+                QFAIL("Median differs from the brute-force one");
+            }
+        }
+    }
+}
+
+void KisSlidingHistogramTest::testChannelSums()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect rect(0, 0, 100, 100);
+
+    dev->fill(QRect(0, 0, 100, 50), KoColor(Qt::red, cs));
+    dev->fill(QRect(0, 50, 100, 50), KoColor(Qt::blue, cs));
+
+    /**
+     * In-place filtering: every pixel takes the color of the bin
+     * with more pixels (the two colors differ in intensity)
+     */
+    KisSlidingHistogram::apply(dev, dev, rect, rect, 10, 256, true,
+        [cs] (const quint8 *pixel) {
+            return cs->intensity8(pixel);
+        },
+        [cs] (const KisSlidingHistogram::Window &window, const quint8 *, quint8 *dstPixel) {
+            const int bin = window.modeBin();
+            const double *sums = window.channelSums(bin);
+
+            QVector<float> channels(cs->channelCount());
+            for (int i = 0; i < channels.size(); i++) {
+                channels[i] = sums[i] / window.count(bin);
+            }
+            cs->fromNormalisedChannelsValue(dstPixel, channels);
+        });
+
+    QCOMPARE(dev->pixel(QPoint(50, 45)).toQColor(), QColor(Qt::red));
+    QCOMPARE(dev->pixel(QPoint(50, 54)).toQColor(), QColor(Qt::blue));
+    QCOMPARE(dev->pixel(QPoint(0, 0)).toQColor(), QColor(Qt::red));
+    QCOMPARE(dev->pixel(QPoint(99, 99)).toQColor(), QColor(Qt::blue));
+}
+void KisSlidingHistogramTest::testBulkBins()
+{
+    const QRect rect(-10, 0, 140, 70);
+
+    KisPaintDeviceSP src = createRandomDevice(QRect(-20, -20, 200, 200));
+    KisPaintDeviceSP perPixelDst = new KisPaintDevice(src->colorSpace());
+    KisPaintDeviceSP bulkDst = new KisPaintDevice(src->colorSpace());
+
+    auto median = [] (const KisSlidingHistogram::Window &window, const quint8 *, quint8 *dstPixel) {
+        *dstPixel = window.percentileBin(0.5);
+    };
+
+    KisSlidingHistogram::apply(src, perPixelDst, rect, rect, 3, 256, false,
+        [] (const quint8 *pixel) {
+            return *pixel;
+        },
+        median);
+
+    /**
+     * The bulk function is copied for every strip, so the counter
+     * of the calls is per strip as well
+     */
+    int numCalls = 0;
+
+    KisSlidingHistogram::applyWithBulkBins(src, bulkDst, rect, rect, 3, 256, false,
+        [numCalls] (const quint8 *pixels, int numPixels, int *bins) mutable {
+            KIS_ASSERT(!numCalls++);
+            std::copy(pixels, pixels + numPixels, bins);
+        },
+        median);
+
+    QVector<quint8> perPixelBytes(rect.width() * rect.height());
+    QVector<quint8> bulkBytes(perPixelBytes.size());
+    perPixelDst->readBytes(perPixelBytes.data(), rect);
+    bulkDst->readBytes(bulkBytes.data(), rect);
+
+    QCOMPARE(bulkBytes, perPixelBytes);
+}
+
+QTEST_MAIN(KisSlidingHistogramTest)
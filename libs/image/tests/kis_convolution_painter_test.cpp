@@ -32,6 +32,10 @@
 #include "kis_convolution_painter.h"
 #include "kis_convolution_kernel.h"
 #include <kis_gaussian_kernel.h>
+#include <KisRecursiveGaussianBlur.h>
+#include <KisBokehBlur.h>
+#include <KisMotionBlur.h>
+#include "kis_global.h"
 #include <kis_mask_generator.h>
 #include "testutil.h"
 
@@ -437,6 +441,270 @@ void KisConvolutionPainterTest::testGaussianDetailsFFTW()
     testGaussianDetails(true);
 }
 
+void KisConvolutionPainterTest::testRecursiveGaussian()
+{
+    QImage referenceImage(TestUtil::fetchDataFileLazy("kritaTransparent.png"));
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    dev->convertFromQImage(referenceImage, 0, 0, 0);
+
+    const QBitArray channelFlags = dev->colorSpace()->channelFlags(true, true);
+    const QRect applyRect = dev->exactBounds();
+
+    for (qreal radius = 8; radius <= 32; radius *= 2) {
+        for (int passes = 0; passes < 2; passes++) {
+            const bool horizontalOnly = passes == 0;
+
+            /**
+             * The reference is calculated by the spatial convolution
+             * with the same border handling as applyGaussian() has
+             */
+            KisPaintDeviceSP spatialDev = new KisPaintDevice(*dev);
+
+            KisConvolutionKernelSP kernelHoriz = KisGaussianKernel::createHorizontalKernel(radius);
+            KisConvolutionKernelSP kernelVertical = KisGaussianKernel::createVerticalKernel(radius);
+            const int verticalMargin = horizontalOnly ? 0 : kernelVertical->height() / 2;
+
+            KisPaintDeviceSP interm = new KisPaintDevice(dev->colorSpace());
+            KisConvolutionPainter horizPainter(interm, KisConvolutionPainter::SPATIAL);
+            horizPainter.setChannelFlags(channelFlags);
+            horizPainter.applyMatrix(kernelHoriz, dev,
+                                     applyRect.topLeft() - QPoint(0, verticalMargin),
+                                     applyRect.topLeft() - QPoint(0, verticalMargin),
+                                     applyRect.size() + QSize(0, 2 * verticalMargin),
+                                     BORDER_REPEAT);
+
+            if (horizontalOnly) {
+                spatialDev = interm;
+            } else {
+                KisConvolutionPainter verticalPainter(spatialDev, KisConvolutionPainter::SPATIAL);
+                verticalPainter.setChannelFlags(channelFlags);
+                verticalPainter.applyMatrix(kernelVertical, interm,
+                                            applyRect.topLeft(), applyRect.topLeft(),
+                                            applyRect.size(), BORDER_REPEAT);
+            }
+
+            KisPaintDeviceSP recursiveDev = new KisPaintDevice(*dev);
+            QVERIFY(KisRecursiveGaussianBlur::applyGaussian(recursiveDev, applyRect,
+                                                            radius, horizontalOnly ? 0.0 : radius,
+                                                            channelFlags, 0));
+
+            /**
+             * The blur spreads the edges into nearly transparent pixels,
+             * whose color is meaningless, so the images are compared
+             * premultiplied
+             */
+            QImage spatialImage = spatialDev->convertToQImage(0, applyRect)
+                .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+            QImage recursiveImage = recursiveDev->convertToQImage(0, applyRect)
+                .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+            /**
+             * The recursive filter only approximates the Gaussian, so
+             * the results may differ for a few levels on sharp edges.
+             * The errors of the two passes add up on the corners of
+             * opaque shapes, so a small share of pixels may differ more.
+             */
+            const int maxNumFailingPixels = applyRect.width() * applyRect.height() / 100;
+
+            QPoint errpoint;
+            if (!TestUtil::compareQImages(errpoint, spatialImage, recursiveImage, 4, 4, maxNumFailingPixels)) {
+                spatialImage.save(QString("recursive_gaussian_%1_%2_spatial.png").arg(radius).arg(passes + 1));
+                recursiveImage.save(QString("recursive_gaussian_%1_%2_recursive.png").arg(radius).arg(passes + 1));
+                QFAIL(QString("Recursive gaussian differs from the spatial one, radius %1, first failed pixel: %2,%3")
+                      .arg(radius).arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+            }
+        }
+    }
+}
+
+void KisConvolutionPainterTest::testTiledFFTW()
+{
+    QImage referenceImage(QString(FILES_DATA_DIR) + QDir::separator() + "hakonepa.png");
+    const QRect imageRect(QPoint(), referenceImage.size());
+
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    dev->convertFromQImage(referenceImage, 0, 0, 0);
+
+    /**
+     * The kernel is large enough for the image to be split into
+     * several FFT tiles, and the rect is not aligned to the tile grid
+     */
+    KisCircleMaskGenerator* kas = new KisCircleMaskGenerator(41, 1.0, 5, 5, 2, false);
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMaskGenerator(kas);
+    const QRect applyRect = imageRect.adjusted(13, 7, -5, -11);
+
+    KisPaintDeviceSP spatialDev = new KisPaintDevice(*dev);
+    KisConvolutionPainter spatialPainter(spatialDev, KisConvolutionPainter::SPATIAL);
+    spatialPainter.beginTransaction();
+    spatialPainter.applyMatrix(kernel, spatialDev, applyRect.topLeft(), applyRect.topLeft(),
+                               applyRect.size(), BORDER_REPEAT);
+    spatialPainter.deleteTransaction();
+
+    // the convolution is done in-place, so the tiles should not see the results of each other
+    KisPaintDeviceSP fftwDev = new KisPaintDevice(*dev);
+    KisConvolutionPainter fftwPainter(fftwDev, KisConvolutionPainter::FFTW);
+    fftwPainter.applyMatrix(kernel, fftwDev, applyRect.topLeft(), applyRect.topLeft(),
+                            applyRect.size(), BORDER_REPEAT);
+
+    QImage spatialImage = spatialDev->convertToQImage(0, imageRect);
+    QImage fftwImage = fftwDev->convertToQImage(0, imageRect);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, spatialImage, fftwImage, 1, 1)) {
+        spatialImage.save("tiled_fftw_spatial.png");
+        fftwImage.save("tiled_fftw_fftw.png");
+        QFAIL(QString("Tiled FFTW convolution differs from the spatial one, first failed pixel: %1,%2")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
+void KisConvolutionPainterTest::testCircularBokeh()
+{
+    QImage referenceImage(QString(FILES_DATA_DIR) + QDir::separator() + "hakonepa.png");
+    const QRect imageRect(QPoint(), referenceImage.size());
+
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    dev->convertFromQImage(referenceImage, 0, 0, 0);
+
+    const QBitArray channelFlags = dev->colorSpace()->channelFlags(true, true);
+    const QRect applyRect = imageRect.adjusted(13, 7, -5, -11);
+    const qreal radius = 16;
+
+    /**
+     * The reference is the convolution with an antialiased disk
+     */
+    const int supersampling = 4;
+    const int kernelSize = 2 * std::ceil(radius) + 1;
+    const int center = kernelSize / 2;
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> disk(kernelSize, kernelSize);
+
+    for (int y = 0; y < kernelSize; y++) {
+        for (int x = 0; x < kernelSize; x++) {
+            int coverage = 0;
+
+            for (int j = 0; j < supersampling; j++) {
+                for (int i = 0; i < supersampling; i++) {
+                    const qreal dx = x - center + (i + 0.5) / supersampling - 0.5;
+                    const qreal dy = y - center + (j + 0.5) / supersampling - 0.5;
+                    coverage += pow2(dx) + pow2(dy) <= pow2(radius);
+                }
+            }
+
+            disk(y, x) = qreal(coverage) / pow2(supersampling);
+        }
+    }
+
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMatrix(disk, 0, disk.sum());
+
+    KisPaintDeviceSP convolutionDev = new KisPaintDevice(*dev);
+    KisConvolutionPainter painter(convolutionDev);
+    painter.setChannelFlags(channelFlags);
+    painter.applyMatrix(kernel, convolutionDev, applyRect.topLeft(), applyRect.topLeft(),
+                        applyRect.size(), BORDER_REPEAT);
+
+    KisPaintDeviceSP bokehDev = new KisPaintDevice(*dev);
+    QVERIFY(KisBokehBlur::applyCircularBlur(bokehDev, applyRect, radius, channelFlags, 0));
+
+    QImage convolutionImage = convolutionDev->convertToQImage(0, imageRect);
+    QImage bokehImage = bokehDev->convertToQImage(0, imageRect);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, convolutionImage, bokehImage, 3, 3)) {
+        convolutionImage.save("circular_bokeh_convolution.png");
+        bokehImage.save("circular_bokeh_bokeh.png");
+        QFAIL(QString("Bokeh blur differs from the disk convolution, first failed pixel: %1,%2")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
+void KisConvolutionPainterTest::testMotionBlur_data()
+{
+    QTest::addColumn<qreal>("angle");
+    QTest::addColumn<qreal>("length");
+
+    QTest::newRow("horizontal") << 0.0 << 17.0;
+    QTest::newRow("vertical") << 90.0 << 12.5;
+    QTest::newRow("diagonal") << 45.0 << 30.0;
+    QTest::newRow("antidiagonal") << 135.0 << 9.0;
+}
+
+void KisConvolutionPainterTest::testMotionBlur()
+{
+    QFETCH(qreal, angle);
+    QFETCH(qreal, length);
+
+    QImage referenceImage(QString(FILES_DATA_DIR) + QDir::separator() + "hakonepa.png");
+    const QRect imageRect(QPoint(), referenceImage.size());
+
+    KisPaintDeviceSP dev = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    dev->convertFromQImage(referenceImage, 0, 0, 0);
+
+    const QBitArray channelFlags = dev->colorSpace()->channelFlags(true, true);
+    const QRect applyRect = imageRect.adjusted(13, 7, -5, -11);
+
+    /**
+     * For the motion along the axes and the diagonals the shear does
+     * not interpolate anything, so the result should be equal to the
+     * convolution with the segment the filter used to rasterize: one
+     * pixel longer than the motion because of the square caps and
+     * passing through the top-left corner of the pixel
+     */
+    const qreal radians = kisDegreesToRadians(angle);
+    const qreal dx = std::cos(radians);
+    const qreal dy = -std::sin(radians);
+
+    const bool horizontal = qAbs(dx) >= qAbs(dy);
+    const qreal major = horizontal ? dx : dy;
+    const int slope = qRound((horizontal ? dy : dx) / major);
+
+    const qreal halfLength = 0.5 * (length + 1.0) * qAbs(major);
+    const qreal start = -0.5 - halfLength;
+    const qreal end = -0.5 + halfLength;
+
+    const int reach = std::ceil(halfLength) + 1;
+    const int kernelSize = 2 * reach + 1;
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> segment =
+        Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic>::Zero(kernelSize, kernelSize);
+
+    for (int k = -reach + 1; k < reach; k++) {
+        const qreal weight = qMin(end, k + 0.5) - qMax(start, k - 0.5);
+        if (weight <= 0.0) continue;
+
+        const int majorOffset = k;
+        const int minorOffset = std::floor(slope * (k + 0.5));
+
+        const int offsetX = horizontal ? majorOffset : minorOffset;
+        const int offsetY = horizontal ? minorOffset : majorOffset;
+
+        // the convolution painter flips the kernel
+        segment(reach - offsetY, reach - offsetX) = weight;
+    }
+
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMatrix(segment, 0, segment.sum());
+
+    KisPaintDeviceSP convolutionDev = new KisPaintDevice(*dev);
+    KisConvolutionPainter painter(convolutionDev);
+    painter.setChannelFlags(channelFlags);
+    painter.applyMatrix(kernel, convolutionDev, applyRect.topLeft(), applyRect.topLeft(),
+                        applyRect.size(), BORDER_REPEAT);
+
+    KisPaintDeviceSP motionDev = new KisPaintDevice(*dev);
+    QVERIFY(KisMotionBlur::applyMotionBlur(motionDev, applyRect, length, angle, channelFlags, 0));
+
+    QImage convolutionImage = convolutionDev->convertToQImage(0, imageRect);
+    QImage motionImage = motionDev->convertToQImage(0, imageRect);
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, convolutionImage, motionImage, 1, 1)) {
+        convolutionImage.save(QString("motion_blur_%1_convolution.png").arg(angle));
+        motionImage.save(QString("motion_blur_%1_motion.png").arg(angle));
+        QFAIL(QString("Motion blur differs from the segment convolution, first failed pixel: %1,%2")
+              .arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 #include "kis_transaction.h"
 
 void KisConvolutionPainterTest::testDilate()
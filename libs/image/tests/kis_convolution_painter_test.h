@@ -57,6 +57,12 @@ private Q_SLOTS:
     void testGaussianDetailsSpatial();
     void testGaussianDetailsFFTW();
 
+    void testRecursiveGaussian();
+    void testTiledFFTW();
+    void testCircularBokeh();
+    void testMotionBlur_data();
+    void testMotionBlur();
+
     void testDilate();
     void testErode();
 };
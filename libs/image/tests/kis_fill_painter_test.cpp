@@ -22,6 +22,10 @@
 
 #include <QTest>
 #include "kis_fill_painter.h"
+#include "kis_selection.h"
+#include "kis_pixel_selection.h"
+#include "kis_convolution_kernel.h"
+#include "kis_convolution_painter.h"
 
 #include <floodfill/kis_scanline_fill.h>
 
@@ -204,5 +208,88 @@ void KisFillPainterTest::testPatternFill()
 
 }
 
+/**
+ * The separable gaussian blur KisFeatherSelectionFilter used before it
+ * was moved to the distance transform
+ */
+void separableFeather(KisPixelSelectionSP pixelSelection, const QRect &rect, int radius)
+{
+    const uint kernelSize = radius * 2 + 1;
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> gaussianMatrix(1, kernelSize);
+
+    const qreal multiplicand = 1.0 / (2.0 * M_PI * radius * radius);
+    const qreal exponentMultiplicand = 1.0 / (2.0 * radius * radius);
+
+    for (uint x = 0; x < kernelSize; x++) {
+        uint xDistance = qAbs(radius - (int)x);
+        gaussianMatrix(0, x) = multiplicand * exp( -(qreal)((xDistance * xDistance) + (radius * radius)) * exponentMultiplicand );
+    }
+
+    KisConvolutionKernelSP kernelHoriz = KisConvolutionKernel::fromMatrix(gaussianMatrix, 0, gaussianMatrix.sum());
+    KisConvolutionKernelSP kernelVertical = KisConvolutionKernel::fromMatrix(gaussianMatrix.transpose(), 0, gaussianMatrix.sum());
+
+    KisPaintDeviceSP interm = new KisPaintDevice(pixelSelection->colorSpace());
+    KisConvolutionPainter horizPainter(interm);
+    horizPainter.setChannelFlags(interm->colorSpace()->channelFlags(false, true));
+    horizPainter.applyMatrix(kernelHoriz, pixelSelection, rect.topLeft(), rect.topLeft(), rect.size(), BORDER_REPEAT);
+    horizPainter.end();
+
+    KisConvolutionPainter verticalPainter(pixelSelection);
+    verticalPainter.setChannelFlags(pixelSelection->colorSpace()->channelFlags(false, true));
+    verticalPainter.applyMatrix(kernelVertical, interm, rect.topLeft(), rect.topLeft(), rect.size(), BORDER_REPEAT);
+    verticalPainter.end();
+}
+
+void KisFillPainterTest::testFloodSelectionFeather()
+{
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect imageRect(0, 0, 300, 200);
+    const QRect shapeRect(60, 50, 150, 90);
+    const int feather = 10;
+
+    dev->fill(imageRect, KoColor(Qt::white, cs));
+    dev->fill(shapeRect, KoColor(Qt::black, cs));
+
+    KisFillPainter gc(dev);
+    gc.setFillThreshold(THRESHOLD);
+    gc.setWidth(imageRect.width());
+    gc.setHeight(imageRect.height());
+
+    // the way the selection was feathered before the distance transform
+    KisSelectionSP reference = gc.createFloodSelection(100, 100, dev);
+
+    separableFeather(reference->pixelSelection(),
+                     reference->selectedRect().adjusted(-feather, -feather, feather, feather),
+                     feather);
+
+    gc.setFeather(feather);
+    KisSelectionSP result = gc.createFloodSelection(100, 100, dev);
+
+    QImage referenceImage =
+        reference->pixelSelection()->convertToQImage(0,
+                                                     imageRect.x(), imageRect.y(),
+                                                     imageRect.width(), imageRect.height());
+    QImage resultImage =
+        result->pixelSelection()->convertToQImage(0,
+                                                  imageRect.x(), imageRect.y(),
+                                                  imageRect.width(), imageRect.height());
+
+    // the straight edges are feathered the same way as by the blur
+    for (int x = imageRect.left(); x <= imageRect.right(); x++) {
+        const QPoint pt(x, shapeRect.center().y());
+        QVERIFY(qAbs(qGray(resultImage.pixel(pt)) - qGray(referenceImage.pixel(pt))) <= 1);
+    }
+
+    /**
+     * The blur treats the corners separably, while the distance
+     * transform rounds them, so only the corners may differ
+     */
+    const int cornerArea = 4 * (2 * feather + 2) * (2 * feather + 2);
+
+    QPoint pt;
+    QVERIFY(TestUtil::compareQImages(pt, resultImage, referenceImage, 1, 1, cornerArea));
+}
 
 QTEST_MAIN(KisFillPainterTest)
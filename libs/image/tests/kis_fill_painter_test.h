@@ -38,6 +38,8 @@ private Q_SLOTS:
     void benchmarkFillingScanlineSelection();
 
     void testPatternFill();
+
+    void testFloodSelectionFeather();
 };
 
 #endif
@@ -18,6 +18,7 @@
 
 #include "kis_filter_mask_test.h"
 #include <QTest>
+#include <QPainter>
 
 #include <KoColorSpaceRegistry.h>
 
@@ -122,4 +123,127 @@ void KisFilterMaskTest::testProjectionSelected()
 
 }
 
+void KisFilterMaskTest::testFusedColorTransformations()
+{
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    QImage qimage(QString(FILES_DATA_DIR) + QDir::separator() + "hakonepa.png");
+    QImage inverted(QString(FILES_DATA_DIR) + QDir::separator() + "inverted_hakonepa.png");
+
+    KisFilterSP f = KisFilterRegistry::instance()->value("invert");
+    Q_ASSERT(f);
+
+    KisImageSP image = new KisImage(0, IMAGE_WIDTH, IMAGE_HEIGHT, 0, "tests");
+
+    KisPaintDeviceSP device = new KisPaintDevice(cs);
+    device->convertFromQImage(qimage, 0, 0, 0);
+
+    KisPaintLayerSP layer = new KisPaintLayer(image, 0, 100, device);
+    image->addNode(layer);
+
+    /**
+     * The first and the last masks are fully selected, so they are
+     * applied in a single pass each, the one in the middle is selected
+     * partially and breaks the chain
+     */
+    const QRect selectedRect(100, 50, 200, 150);
+
+    for (int i = 0; i < 3; i++) {
+        KisFilterMaskSP mask = new KisFilterMask();
+        mask->setFilter(f->defaultConfiguration());
+        image->addNode(mask, layer);
+
+        mask->initSelection(layer);
+        mask->createNodeProgressProxy();
+
+        if (i == 1) {
+            mask->select(QRect(0, 0, IMAGE_WIDTH, IMAGE_HEIGHT), MIN_SELECTED);
+            mask->select(selectedRect, MAX_SELECTED);
+        }
+    }
+
+    image->refreshGraph();
+    image->waitForDone();
+
+    QImage expected = qimage;
+    {
+        QPainter gc(&expected);
+        gc.drawImage(selectedRect.topLeft(), inverted, selectedRect);
+    }
+
+    QImage result = layer->projection()->convertToQImage(0, 0, 0, qimage.width(), qimage.height());
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, expected, result)) {
+        result.save("filtermasktest_fused.png");
+        QFAIL(QString("Failed to apply the chain of masks, first different pixel: %1,%2 ").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
+void KisFilterMaskTest::testFusedColorTransformationChain()
+{
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    QImage qimage(QString(FILES_DATA_DIR) + QDir::separator() + "hakonepa.png");
+
+    KisFilterSP invert = KisFilterRegistry::instance()->value("invert");
+    KisFilterSP hsv = KisFilterRegistry::instance()->value("hsvadjustment");
+    Q_ASSERT(invert);
+    Q_ASSERT(hsv);
+
+    /**
+     * All three masks are fully selected, so they are fused into a single
+     * chain that goes through both scratch buffers. The HSV adjustment is
+     * not symmetric to the inversion, so the order of the chain matters.
+     */
+    auto createConfigurations = [invert, hsv] () {
+        KisFilterConfigurationSP hsvConfig = hsv->defaultConfiguration();
+        hsvConfig->setProperty("h", 30);
+        hsvConfig->setProperty("s", 20);
+        hsvConfig->setProperty("v", 40);
+
+        return QList<KisFilterConfigurationSP>()
+            << invert->defaultConfiguration()
+            << hsvConfig
+            << invert->defaultConfiguration();
+    };
+
+    KisPaintDeviceSP expectedDevice = new KisPaintDevice(cs);
+    expectedDevice->convertFromQImage(qimage, 0, 0, 0);
+
+    Q_FOREACH (KisFilterConfigurationSP config, createConfigurations()) {
+        KisFilterSP f = KisFilterRegistry::instance()->value(config->name());
+        f->process(expectedDevice, qimage.rect(), config);
+    }
+
+    KisImageSP image = new KisImage(0, IMAGE_WIDTH, IMAGE_HEIGHT, 0, "tests");
+
+    KisPaintDeviceSP device = new KisPaintDevice(cs);
+    device->convertFromQImage(qimage, 0, 0, 0);
+
+    KisPaintLayerSP layer = new KisPaintLayer(image, 0, 100, device);
+    image->addNode(layer);
+
+    Q_FOREACH (KisFilterConfigurationSP config, createConfigurations()) {
+        KisFilterMaskSP mask = new KisFilterMask();
+        mask->setFilter(config);
+        image->addNode(mask, layer);
+
+        mask->initSelection(layer);
+        mask->createNodeProgressProxy();
+    }
+
+    image->refreshGraph();
+    image->waitForDone();
+
+    QImage expected = expectedDevice->convertToQImage(0, 0, 0, qimage.width(), qimage.height());
+    QImage result = layer->projection()->convertToQImage(0, 0, 0, qimage.width(), qimage.height());
+
+    QPoint errpoint;
+    if (!TestUtil::compareQImages(errpoint, expected, result)) {
+        result.save("filtermasktest_fused_chain.png");
+        QFAIL(QString("Failed to apply the fused chain of masks, first different pixel: %1,%2 ").arg(errpoint.x()).arg(errpoint.y()).toLatin1());
+    }
+}
+
 QTEST_MAIN(KisFilterMaskTest)
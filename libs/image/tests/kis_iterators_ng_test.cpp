@@ -474,6 +474,87 @@ void KisIteratorNGTest::sequentialIteratorWithProgressIncomplete()
     QCOMPARE(proxy.value(), proxy.max());
 }
 
+#include <KisTileKernel.h>
+#include <KoColorModelStandardIds.h>
+#include <KoInvertColorTransformation.h>
+
+namespace {
+
+template <class Traits>
+struct InvertSpan
+{
+    typedef typename Traits::channels_type channels_type;
+
+    void operator() (const channels_type *src, channels_type *dst, int numPixels) const {
+        KoInvertColorTransformationTraits<Traits>::invertPixels(src, dst, numPixels);
+    }
+};
+
+}
+
+void KisIteratorNGTest::tileKernelSpans()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect rc(10,10,200,150);
+    dev->fill(rc, KoColor(QColor(10, 20, 30, 40), cs));
+
+    int numPixels = 0;
+    KisTileKernel::processSpans<KoBgrU8Traits>(dev, rc,
+        [&numPixels] (const quint8 *src, quint8 *dst, int numConseqPixels) {
+            QVERIFY(numConseqPixels > 0);
+            QVERIFY(numConseqPixels <= 64);
+
+            for (int i = 0; i < numConseqPixels * 4; i++) {
+                dst[i] = 255 - src[i];
+            }
+            numPixels += numConseqPixels;
+        });
+
+    QCOMPARE(numPixels, rc.width() * rc.height());
+
+    KoColor expected(QColor(245, 235, 225, 215), cs);
+
+    numPixels = 0;
+    KisTileKernel::processSpansConst<KoBgrU8Traits>(dev, rc,
+        [&numPixels, &expected] (const quint8 *src, int numConseqPixels) {
+            for (int i = 0; i < numConseqPixels; i++) {
+                QVERIFY(memcmp(src + i * 4, expected.data(), 4) == 0);
+            }
+            numPixels += numConseqPixels;
+        });
+
+    QCOMPARE(numPixels, rc.width() * rc.height());
+}
+
+void KisIteratorNGTest::tileKernelRgbaSpans()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb16();
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+
+    const QRect rc(10,10,200,150);
+    dev->fill(rc, KoColor(QColor(10, 20, 30, 40), cs));
+
+    KoColor expected(QColor(10, 20, 30, 40), cs);
+    QScopedPointer<KoColorTransformation> transformation(cs->createInvertTransformation());
+    transformation->transform(expected.data(), expected.data(), 1);
+
+    QVERIFY(KisTileKernel::processRgbaSpans<InvertSpan>(dev, rc, 0));
+
+    KisSequentialConstIterator it(dev, rc);
+    while (it.nextPixel()) {
+        QVERIFY(memcmp(it.rawDataConst(), expected.data(), cs->pixelSize()) == 0);
+    }
+
+    const KoColorSpace *labCs = KoColorSpaceRegistry::instance()->lab16();
+    KisPaintDeviceSP labDev = new KisPaintDevice(labCs);
+    labDev->fill(rc, KoColor(QColor(10, 20, 30, 40), labCs));
+
+    QVERIFY(!KisTileKernel::processRgbaSpans<InvertSpan>(labDev, rc, 0));
+    QVERIFY(labDev->pixel(rc.center()) == KoColor(QColor(10, 20, 30, 40), labCs));
+}
+
 void KisIteratorNGTest::hLineIter()
 {
     allCsApplicator(&KisIteratorNGTest::hLineIter);
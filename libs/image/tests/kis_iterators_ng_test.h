@@ -47,6 +47,8 @@ private Q_SLOTS:
     void sequentialIter();
     void sequentialIteratorWithProgress();
     void sequentialIteratorWithProgressIncomplete();
+    void tileKernelSpans();
+    void tileKernelRgbaSpans();
     void hLineIter();
     void randomAccessor();
 };
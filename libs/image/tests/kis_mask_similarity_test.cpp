@@ -177,6 +177,18 @@ public:
         // KisMaskSimilarityTester::exahustiveTest(bounds,type);
     }
 
+    template <typename MaskGenerator>
+    static void runSmallMaskGenTest(MaskGenerator& generator, MaskType type) {
+        // dabs this small are supersampled by both backends
+        QRect bounds(0,0,12,12);
+        generator.setDiameter(7.5);
+        QVERIFY(generator.shouldSupersample());
+        MaskGenerator scalarGenerator(generator);
+
+        scalarGenerator.resetMaskApplicator(true); // Force usage of scalar backend
+        KisMaskSimilarityTester(scalarGenerator.applicator(), generator.applicator(), bounds, type);
+    }
+
 private:
     QString getTypeName(MaskType type) {
 
@@ -258,4 +270,16 @@ void KisMaskSimilarityTest::testSoftRectMask()
     KisMaskSimilarityTester::runMaskGenTest(generator,RECT_SOFT);
 }
 
+void KisMaskSimilarityTest::testSmallCircleMask()
+{
+    KisCircleMaskGenerator generator(7.5, 0.8, 0.5, 0.5, 2, true);
+    KisMaskSimilarityTester::runSmallMaskGenTest(generator,DEFAULT);
+}
+
+void KisMaskSimilarityTest::testSmallRectMask()
+{
+    KisRectangleMaskGenerator generator(7.5, 0.8, 0.5, 0.5, 2, true);
+    KisMaskSimilarityTester::runSmallMaskGenTest(generator,RECT);
+}
+
 QTEST_MAIN(KisMaskSimilarityTest)
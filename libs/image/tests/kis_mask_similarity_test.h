@@ -33,6 +33,9 @@ private Q_SLOTS:
     void testRectMask();
     void testGaussRectMask();
     void testSoftRectMask();
+
+    void testSmallCircleMask();
+    void testSmallRectMask();
 };
 
 #endif
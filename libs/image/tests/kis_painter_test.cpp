@@ -683,6 +683,184 @@ void KisPainterTest::testOptimizedCopying()
 
 }
 
+void KisPainterTest::testLineSpansMatchPerPixelPath()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QRect rc(0, 0, 300, 300);
+
+    KisSelectionSP selection = new KisSelection();
+    selection->pixelSelection()->select(rc);
+    selection->updateProjection();
+
+    auto drawLines = [cs] (KisPaintDeviceSP dev, KisSelectionSP selection) {
+        KisPainter gc(dev, selection);
+        KoColor color(Qt::red, cs);
+        color.setOpacity(quint8(200));
+        gc.setPaintColor(color);
+
+        // cross the tile borders in both directions
+        gc.drawThickLine(QPointF(10, 20), QPointF(290, 90), 9, 15);
+        gc.drawThickLine(QPointF(30, 10), QPointF(100, 290), 12, 4);
+        gc.drawThickLine(QPointF(280, 280), QPointF(20, 200), 7, 7);
+        gc.drawWuLine(QPointF(250, 60), QPointF(5, 60));
+        gc.drawWuLine(QPointF(140, 5), QPointF(140, 250));
+        gc.drawLine(QPointF(20, 270), QPointF(270, 140), 11.5, true);
+    };
+
+    // a selection covering the whole device forces the per-pixel path
+    KisPaintDeviceSP spanDev = new KisPaintDevice(cs);
+    KisPaintDeviceSP pixelDev = new KisPaintDevice(cs);
+
+    drawLines(spanDev, KisSelectionSP());
+    drawLines(pixelDev, selection);
+
+    QPoint errorPoint;
+    QVERIFY(TestUtil::comparePaintDevices(errorPoint, spanDev, pixelDev));
+    QVERIFY(!spanDev->exactBounds().isEmpty());
+}
+
+#include <KoColorModelStandardIds.h>
+#include <KoCompositeOp.h>
+#include "kis_random_accessor_ng.h"
+
+namespace {
+
+/**
+ * A copy of the pixel-by-pixel rendering of the wide lines, as it was
+ * before KisPainter started to composite their spans
+ */
+void drawReferenceWideLine(KisPaintDeviceSP dev, const KoColor &color,
+                           const QPointF& start, const QPointF& end,
+                           qreal width, bool antialias)
+{
+    int x1 = qFloor(start.x());
+    int y1 = qFloor(start.y());
+    int x2 = qFloor(end.x());
+    int y2 = qFloor(end.y());
+
+    if ((x2 == x1 ) && (y2 == y1)) return;
+
+    int dstX = x2-x1;
+    int dstY = y2-y1;
+
+    qreal uniC = dstX*y1 - dstY*x1;
+    qreal projectionDenominator = 1.0 / (pow((double)dstX, 2) + pow((double)dstY, 2));
+
+    qreal subPixel;
+    if (qAbs(dstX) > qAbs(dstY)){
+        subPixel = start.x() - x1;
+    }else{
+        subPixel = start.y() - y1;
+    }
+
+    qreal halfWidth = width * 0.5 + subPixel;
+    int W_ = qRound(halfWidth) + 1;
+
+    int X1_ = x1;
+    int Y1_ = y1;
+    int X2_ = x2;
+    int Y2_ = y2;
+
+    if (x2<x1) std::swap(x1,x2);
+    if (y2<y1) std::swap(y1,y2);
+
+    qreal denominator = sqrt(pow((double)dstY,2) + pow((double)dstX,2));
+    if (denominator == 0.0) {
+        denominator = 1.0;
+    }
+    denominator = 1.0/denominator;
+
+    const KoCompositeOp *op = dev->colorSpace()->compositeOp(COMPOSITE_OVER);
+
+    qreal projection,scanX,scanY,AA_;
+    KisRandomAccessorSP accessor = dev->createRandomAccessorNG(x1, y1);
+
+    for (int y = y1-W_; y < y2+W_ ; y++){
+        for (int x = x1-W_; x < x2+W_; x++){
+
+            projection = ( (x-X1_)* dstX + (y-Y1_)*dstY ) * projectionDenominator;
+            scanX = X1_ + projection * dstX;
+            scanY = Y1_ + projection * dstY;
+
+            if (((scanX < x1) || (scanX > x2)) || ((scanY < y1) || (scanY > y2))) {
+                AA_ = qMin( sqrt( pow((double)x - X1_, 2) + pow((double)y - Y1_, 2) ),
+                            sqrt( pow((double)x - X2_, 2) + pow((double)y - Y2_, 2) ));
+            }else{
+                AA_ = qAbs(dstY*x - dstX*y + uniC) * denominator;
+            }
+
+            if (AA_>halfWidth) {
+                continue;
+            }
+
+            accessor->moveTo(x, y);
+
+            KoColor mycolor = color;
+
+            if (antialias && AA_ > halfWidth-1.0) {
+                mycolor.colorSpace()->multiplyAlpha(mycolor.data(), 1.0 - (AA_-(halfWidth-1.0)), 1);
+            }
+
+            op->composite(accessor->rawData(), 0, mycolor.data(), 0, 0, 0, 1, 1, OPACITY_OPAQUE_U8);
+        }
+    }
+}
+
+}
+
+void KisPainterTest::testWideLineMatchesReference_data()
+{
+    QTest::addColumn<QString>("colorDepthId");
+
+    QTest::newRow("u8") << Integer8BitsColorDepthID.id();
+    QTest::newRow("u16") << Integer16BitsColorDepthID.id();
+    QTest::newRow("f32") << Float32BitsColorDepthID.id();
+}
+
+void KisPainterTest::testWideLineMatchesReference()
+{
+    QFETCH(QString, colorDepthId);
+
+    const KoColorSpace *cs =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), colorDepthId, "");
+    QVERIFY(cs);
+
+    KoColor color(Qt::red, cs);
+    color.setOpacity(quint8(200));
+
+    struct Line {
+        QPointF start;
+        QPointF end;
+        qreal width;
+        bool antialias;
+    };
+
+    // cross the tile borders in all the directions
+    const QVector<Line> lines({
+        {QPointF(20, 270), QPointF(270, 140), 11.5, true},
+        {QPointF(10.3, 15.7), QPointF(280.6, 40.2), 6.3, true},
+        {QPointF(150.5, 5.5), QPointF(130.2, 290.8), 20.0, true},
+        {QPointF(250, 250), QPointF(30, 60), 9.0, false}
+    });
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    KisPaintDeviceSP referenceDev = new KisPaintDevice(cs);
+
+    KisPainter gc(dev);
+    gc.setPaintColor(color);
+
+    Q_FOREACH (const Line &line, lines) {
+        gc.drawLine(line.start, line.end, line.width, line.antialias);
+        drawReferenceWideLine(referenceDev, color, line.start, line.end, line.width, line.antialias);
+    }
+
+    QVERIFY(!dev->exactBounds().isEmpty());
+    QCOMPARE(dev->exactBounds(), referenceDev->exactBounds());
+
+    QPoint errorPoint;
+    QVERIFY(TestUtil::comparePaintDevices(errorPoint, dev, referenceDev));
+}
+
 KISTEST_MAIN(KisPainterTest)
 
 
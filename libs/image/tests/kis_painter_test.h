@@ -63,6 +63,11 @@ private Q_SLOTS:
 
 
     void testOptimizedCopying();
+
+    void testLineSpansMatchPerPixelPath();
+
+    void testWideLineMatchesReference_data();
+    void testWideLineMatchesReference();
 };
 
 #endif
@@ -41,7 +41,7 @@ Item {
             id: brushSize;
             width: parent.width;
             placeholder: "Brush size";
-            min: 1; max: 5; decimals: 0;
+            min: 1; max: 50; decimals: 0;
             onValueChanged: setProp("halfWidth", value);
         }
         RangeInput {
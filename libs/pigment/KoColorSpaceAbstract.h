@@ -139,7 +139,7 @@ public:
     }
 
     KoColorTransformation* createInvertTransformation() const override {
-        return KoInvertColorTransformation::getTransformator(this);
+        return KoInvertColorTransformation::getTransformator<_CSTrait>(this);
     }
 
     KoColorTransformation *createDarkenAdjustment(qint32 shade, bool compensate, qreal compensation) const override {
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KO_DESATURATE_KERNEL_H
+#define __KO_DESATURATE_KERNEL_H
+
+#include <QtGlobal>
+
+#include "KoColorSpaceMaths.h"
+
+namespace KoDesaturate {
+
+// http://www.tannerhelland.com/3643/grayscale-image-algorithm-vb6/
+
+struct Lightness {
+    static inline float gray(float r, float g, float b) {
+        return (qMax(qMax(r, g), b) + qMin(qMin(r, g), b)) / 2;
+    }
+};
+
+struct LuminosityBT709 {
+    static inline float gray(float r, float g, float b) {
+        return r * 0.2126 + g * 0.7152 + b * 0.0722;
+    }
+};
+
+struct LuminosityBT601 {
+    static inline float gray(float r, float g, float b) {
+        return r * 0.299 + g * 0.587 + b * 0.114;
+    }
+};
+
+struct Average {
+    static inline float gray(float r, float g, float b) {
+        return (r + g + b) / 3;
+    }
+};
+
+struct Min {
+    static inline float gray(float r, float g, float b) {
+        return qMin(qMin(r, g), b);
+    }
+};
+
+struct Max {
+    static inline float gray(float r, float g, float b) {
+        return qMax(qMax(r, g), b);
+    }
+};
+
+struct Black {
+    static inline float gray(float, float, float) {
+        return 0;
+    }
+};
+
+}
+
+/**
+ * The pixel loops of the desaturate adjustment for an RGBA color space
+ * described by \p Traits. They are shared by the color transformation
+ * and by the desaturate filter, which runs them directly on the spans
+ * of the device.
+ *
+ * The desaturation type is resolved once per call, so that the pixel
+ * loop itself has no branches in it:
+ *
+ *  0: lightness
+ *  1: luminosity BT 709
+ *  2: luminosity BT 601
+ *  3: average
+ *  4: min
+ *  5: max
+ *  anything else: black
+ */
+template <class Traits>
+struct KoDesaturateKernel
+{
+    typedef typename Traits::channels_type channels_type;
+    typedef typename Traits::Pixel Pixel;
+
+    static void desaturatePixels(int type, const channels_type *srcChannels, channels_type *dstChannels, qint32 nPixels)
+    {
+        const Pixel *src = reinterpret_cast<const Pixel*>(srcChannels);
+        Pixel *dst = reinterpret_cast<Pixel*>(dstChannels);
+
+        switch(type) {
+        case 0:
+            desaturateImpl<KoDesaturate::Lightness>(src, dst, nPixels);
+            break;
+        case 1:
+            desaturateImpl<KoDesaturate::LuminosityBT709>(src, dst, nPixels);
+            break;
+        case 2:
+            desaturateImpl<KoDesaturate::LuminosityBT601>(src, dst, nPixels);
+            break;
+        case 3:
+            desaturateImpl<KoDesaturate::Average>(src, dst, nPixels);
+            break;
+        case 4:
+            desaturateImpl<KoDesaturate::Min>(src, dst, nPixels);
+            break;
+        case 5:
+            desaturateImpl<KoDesaturate::Max>(src, dst, nPixels);
+            break;
+        default:
+            desaturateImpl<KoDesaturate::Black>(src, dst, nPixels);
+        }
+    }
+
+private:
+    template<class DesaturateFunc>
+    static inline void desaturateImpl(const Pixel *src, Pixel *dst, qint32 nPixels)
+    {
+        for (qint32 i = 0; i < nPixels; i++) {
+            const float gray =
+                DesaturateFunc::gray(KoColorSpaceMaths<channels_type, float>::scaleToA(src[i].red),
+                                     KoColorSpaceMaths<channels_type, float>::scaleToA(src[i].green),
+                                     KoColorSpaceMaths<channels_type, float>::scaleToA(src[i].blue));
+
+            const channels_type value = KoColorSpaceMaths<float, channels_type>::scaleToA(gray);
+            dst[i].red = value;
+            dst[i].green = value;
+            dst[i].blue = value;
+            dst[i].alpha = src[i].alpha;
+        }
+    }
+};
+
+#endif /* __KO_DESATURATE_KERNEL_H */
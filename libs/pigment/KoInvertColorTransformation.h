@@ -29,6 +29,8 @@
 
 #include "KoColorModelStandardIds.h"
 
+#include <limits>
+
 #include <KoConfig.h>
 #ifdef HAVE_OPENEXR
 #include <half.h>
@@ -167,10 +169,59 @@ public:
     }
 };
 
+/**
+ * Inverts the color channels of a color space whose pixel layout is
+ * known at compile time. The inner loop has no per-channel lookups, so
+ * the compiler is free to vectorize it. The alpha channel is copied
+ * from the source.
+ */
+template<class _CSTrait>
+class KoInvertColorTransformationTraits : public KoColorTransformation {
+public:
+    typedef typename _CSTrait::channels_type channels_type;
+
+    void transform(const quint8 *srcU8, quint8 *dstU8, qint32 nPixels) const override {
+        invertPixels(reinterpret_cast<const channels_type*>(srcU8),
+                     reinterpret_cast<channels_type*>(dstU8),
+                     nPixels);
+    }
+
+    /**
+     * The pixel loop of the transformation. The invert filter calls it
+     * directly for every span of the device.
+     */
+    static inline void invertPixels(const channels_type *src, channels_type *dst, qint32 nPixels) {
+        for (qint32 i = 0; i < nPixels; i++) {
+            for (quint32 ch = 0; ch < _CSTrait::channels_nb; ch++) {
+                dst[ch] = qint32(ch) == _CSTrait::alpha_pos ?
+                    src[ch] : KoColorSpaceMaths<channels_type>::invert(src[ch]);
+            }
+            src += _CSTrait::channels_nb;
+            dst += _CSTrait::channels_nb;
+        }
+    }
+};
 
 class KoInvertColorTransformation
 {
 public:
+  /**
+   * Same as getTransformator(cs), but uses the compile-time layout of
+   * \p _CSTrait for all the color spaces where every non-alpha channel
+   * is a plain color channel
+   */
+  template<class _CSTrait>
+  static KoColorTransformation* getTransformator(const KoColorSpace *cs)
+  {
+      KoID modelId = cs->colorModelId();
+      if (std::numeric_limits<typename _CSTrait::channels_type>::is_integer ||
+          (modelId != LABAColorModelID && modelId != CMYKAColorModelID)) {
+
+          return new KoInvertColorTransformationTraits<_CSTrait>();
+      }
+      return getTransformator(cs);
+  }
+
   static KoColorTransformation* getTransformator(const KoColorSpace *cs)
   {
       KoID id = cs->colorDepthId();
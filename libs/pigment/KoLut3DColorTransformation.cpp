@@ -0,0 +1,314 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "KoLut3DColorTransformation.h"
+
+#include <QVector>
+
+#include <random>
+
+#include "KoBgrColorSpaceTraits.h"
+#include "KoChannelInfo.h"
+#include "KoColorModelStandardIds.h"
+#include "KoColorSpace.h"
+#include "KoColorSpaceMaths.h"
+#include "KoGenericLut3DInterpolator.h"
+#include "KoLut3DInterpolatorFactory.h"
+
+namespace {
+
+/**
+ * The grid sizes tried by the baking, from the coarsest to the finest
+ * one. The coarse tables fit into the CPU caches much better, so they are
+ * used whenever the transformation is smooth enough.
+ */
+const int gridSizes[] = {17, 33, 65};
+
+/**
+ * The maximum interpolation error, in code values of the channels, the
+ * table may have at any of the checked points. It keeps the 8-bit results
+ * within one code value of the exact ones. 16-bit pixels are expected to
+ * be precise, so they get only a few code values and most nonlinear
+ * transformations are evaluated exactly there.
+ */
+const float maximumError8 = 1.0f;
+const float maximumError16 = 4.0f;
+
+}
+
+struct Q_DECL_HIDDEN KoLut3DColorTransformation::Private
+{
+    int gridSize = 0;
+    bool is16Bit = false;
+
+    /// channel value of every grid line and the inverse distance to the next one
+    QVector<int> nodeValues;
+    QVector<float> nodeScales;
+
+    /**
+     * The transformed color channels of every node, four floats per
+     * node. See KoLut3DTable for the layout.
+     */
+    QVector<float> nodes;
+
+    KoLut3DTable lookupTable() const {
+        KoLut3DTable table;
+        table.gridSize = gridSize;
+        table.nodeValues = nodeValues.constData();
+        table.nodeScales = nodeScales.constData();
+        table.nodes = nodes.constData();
+        return table;
+    }
+
+    /**
+     * Bakes \p transformation into a table of \p gridSize nodes per axis
+     * and checks its error against the exact values inside every cell.
+     *
+     * @return null if the table is not precise enough or if \p
+     * transformation touches alpha (\p preservesAlpha is reset then)
+     */
+    template <typename channels_type>
+    static QSharedPointer<Private> bake(const KoColorTransformation *transformation,
+                                        int gridSize, float maximumError,
+                                        bool *preservesAlpha) {
+        typedef KoBgrTraits<channels_type> Traits;
+        const int unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+
+        QSharedPointer<Private> d(new Private);
+        d->gridSize = gridSize;
+        d->is16Bit = sizeof(channels_type) == 2;
+
+        d->nodeValues.resize(gridSize);
+        d->nodeScales.resize(gridSize - 1);
+        for (int i = 0; i < gridSize; i++) {
+            d->nodeValues[i] = qRound(qreal(i) * unitValue / (gridSize - 1));
+        }
+        for (int i = 0; i < gridSize - 1; i++) {
+            d->nodeScales[i] = 1.0f / (d->nodeValues[i + 1] - d->nodeValues[i]);
+        }
+
+        // the nodes are evaluated plane by plane to keep the buffers small
+        const int planeSize = gridSize * gridSize;
+        QVector<channels_type> srcPlane(planeSize * Traits::channels_nb);
+        QVector<channels_type> dstPlane(planeSize * Traits::channels_nb);
+
+        d->nodes.resize(gridSize * planeSize * 4);
+        float *tablePtr = d->nodes.data();
+
+        for (int ix = 0; ix < gridSize; ix++) {
+            channels_type *srcPtr = srcPlane.data();
+            for (int iy = 0; iy < gridSize; iy++) {
+                for (int iz = 0; iz < gridSize; iz++) {
+                    srcPtr[0] = d->nodeValues[ix];
+                    srcPtr[1] = d->nodeValues[iy];
+                    srcPtr[2] = d->nodeValues[iz];
+                    srcPtr[Traits::alpha_pos] = unitValue;
+                    srcPtr += Traits::channels_nb;
+                }
+            }
+
+            // the transformations are usually applied in place and may
+            // leave the channels they don't touch as they are in dst
+            dstPlane = srcPlane;
+            transformation->transform(reinterpret_cast<const quint8*>(srcPlane.constData()),
+                                      reinterpret_cast<quint8*>(dstPlane.data()),
+                                      planeSize);
+
+            const channels_type *dstPtr = dstPlane.constData();
+            for (int i = 0; i < planeSize; i++) {
+                if (dstPtr[Traits::alpha_pos] != unitValue) {
+                    *preservesAlpha = false;
+                    return QSharedPointer<Private>();
+                }
+
+                tablePtr[0] = dstPtr[0];
+                tablePtr[1] = dstPtr[1];
+                tablePtr[2] = dstPtr[2];
+                tablePtr[3] = 0.0f;
+
+                tablePtr += 4;
+                dstPtr += Traits::channels_nb;
+            }
+        }
+
+        /**
+         * Every cell is checked at its center, at the midpoints of six of
+         * its edges (three from either end of the main diagonal, so that
+         * all the edges of the grid are covered) and at a few pseudo-random
+         * points inside. The edges catch the kinks along a single channel,
+         * like a gamma curve near black, the inner points catch the ones
+         * across the channels, like the hue near gray.
+         */
+        const int numRandomSamples = 2;
+        const int samplesPerCell = 7 + numRandomSamples;
+        const int cellPlaneSize = (gridSize - 1) * (gridSize - 1);
+        const int numSamples = cellPlaneSize * samplesPerCell;
+
+        QVector<channels_type> srcSamples(numSamples * Traits::channels_nb);
+        QVector<channels_type> dstSamples;
+
+        // the sequence is fixed, so that the baking is reproducible
+        std::minstd_rand randomGenerator(1);
+
+        auto middleValue = [d] (int i) {
+            return channels_type((d->nodeValues[i] + d->nodeValues[i + 1]) / 2);
+        };
+
+        auto randomValue = [d, &randomGenerator] (int i) {
+            const int span = d->nodeValues[i + 1] - d->nodeValues[i];
+            const int offset = span > 1 ? 1 + int(randomGenerator() % (span - 1)) : 0;
+            return channels_type(d->nodeValues[i] + offset);
+        };
+
+        channels_type *srcPtr = 0;
+
+        auto addSample = [&srcPtr, unitValue] (channels_type x, channels_type y, channels_type z) {
+            srcPtr[0] = x;
+            srcPtr[1] = y;
+            srcPtr[2] = z;
+            srcPtr[Traits::alpha_pos] = unitValue;
+            srcPtr += Traits::channels_nb;
+        };
+
+        const KoLut3DTable table = d->lookupTable();
+        float result[4];
+
+        for (int ix = 0; ix < gridSize - 1; ix++) {
+            srcPtr = srcSamples.data();
+
+            const channels_type x0 = d->nodeValues[ix];
+            const channels_type x1 = d->nodeValues[ix + 1];
+            const channels_type xm = middleValue(ix);
+
+            for (int iy = 0; iy < gridSize - 1; iy++) {
+                const channels_type y0 = d->nodeValues[iy];
+                const channels_type y1 = d->nodeValues[iy + 1];
+                const channels_type ym = middleValue(iy);
+
+                for (int iz = 0; iz < gridSize - 1; iz++) {
+                    const channels_type z0 = d->nodeValues[iz];
+                    const channels_type z1 = d->nodeValues[iz + 1];
+                    const channels_type zm = middleValue(iz);
+
+                    addSample(xm, ym, zm);
+
+                    addSample(xm, y0, z0);
+                    addSample(x0, ym, z0);
+                    addSample(x0, y0, zm);
+
+                    addSample(xm, y1, z1);
+                    addSample(x1, ym, z1);
+                    addSample(x1, y1, zm);
+
+                    for (int i = 0; i < numRandomSamples; i++) {
+                        addSample(randomValue(ix), randomValue(iy), randomValue(iz));
+                    }
+                }
+            }
+
+            dstSamples = srcSamples;
+            transformation->transform(reinterpret_cast<const quint8*>(srcSamples.constData()),
+                                      reinterpret_cast<quint8*>(dstSamples.data()),
+                                      numSamples);
+
+            const channels_type *samplePtr = srcSamples.constData();
+            const channels_type *dstPtr = dstSamples.constData();
+            for (int i = 0; i < numSamples; i++) {
+                KoGenericLut3DInterpolator<channels_type>::interpolate(table, samplePtr, result);
+
+                for (int c = 0; c < 3; c++) {
+                    if (qAbs(result[c] - dstPtr[c]) > maximumError) {
+                        return QSharedPointer<Private>();
+                    }
+                }
+
+                samplePtr += Traits::channels_nb;
+                dstPtr += Traits::channels_nb;
+            }
+        }
+
+        return d;
+    }
+};
+
+KoLut3DColorTransformation::KoLut3DColorTransformation(QSharedPointer<const Private> d)
+    : m_d(d)
+{
+    resetInterpolator(false);
+}
+
+KoLut3DColorTransformation::KoLut3DColorTransformation(const KoLut3DColorTransformation &rhs)
+    : KoColorTransformation(rhs),
+      m_d(rhs.m_d)
+{
+    resetInterpolator(false);
+}
+
+KoLut3DColorTransformation::~KoLut3DColorTransformation()
+{
+}
+
+void KoLut3DColorTransformation::transform(const quint8 *src, quint8 *dst, qint32 nPixels) const
+{
+    m_interpolator->transform(src, dst, nPixels);
+}
+
+void KoLut3DColorTransformation::resetInterpolator(bool forceScalar)
+{
+    m_interpolator.reset(
+        KoLut3DInterpolatorFactory::createInterpolator(m_d->lookupTable(), m_d->is16Bit, forceScalar));
+}
+
+int KoLut3DColorTransformation::gridSize() const
+{
+    return m_d->gridSize;
+}
+
+bool KoLut3DColorTransformation::isColorSpaceSupported(const KoColorSpace *cs)
+{
+    return cs->colorModelId() == RGBAColorModelID &&
+        (cs->colorDepthId() == Integer8BitsColorDepthID ||
+         cs->colorDepthId() == Integer16BitsColorDepthID) &&
+        cs->channelCount() == 4 &&
+        cs->colorChannelCount() == 3 &&
+        cs->channels()[KoBgrU8Traits::alpha_pos]->channelType() == KoChannelInfo::ALPHA;
+}
+
+KoLut3DColorTransformation* KoLut3DColorTransformation::createBakedTransformation(const KoColorSpace *cs, const KoColorTransformation *transformation)
+{
+    if (!transformation || !isColorSpaceSupported(cs)) return 0;
+
+    const bool is16Bit = cs->colorDepthId() == Integer16BitsColorDepthID;
+    bool preservesAlpha = true;
+
+    for (int gridSize : gridSizes) {
+        QSharedPointer<const Private> d =
+            is16Bit ?
+            Private::bake<quint16>(transformation, gridSize, maximumError16, &preservesAlpha) :
+            Private::bake<quint8>(transformation, gridSize, maximumError8, &preservesAlpha);
+
+        if (d) {
+            return new KoLut3DColorTransformation(d);
+        }
+
+        if (!preservesAlpha) break;
+    }
+
+    return 0;
+}
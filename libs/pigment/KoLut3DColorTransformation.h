@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __KO_LUT3D_COLOR_TRANSFORMATION_H
+#define __KO_LUT3D_COLOR_TRANSFORMATION_H
+
+#include "KoColorTransformation.h"
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "kritapigment_export.h"
+
+class KoColorSpace;
+class KoLut3DInterpolator;
+
+/**
+ * A color transformation that replaces a pure RGB -> RGB transformation
+ * with a 3D lookup table. The table is baked by evaluating the original
+ * transformation on a regular grid of the color channel values and the
+ * pixels are transformed with tetrahedral interpolation between the six
+ * grid nodes surrounding them. The alpha channel is passed through as it
+ * is.
+ *
+ * It is meant for the transformations that are expensive to evaluate per
+ * pixel (HSV adjustment, color balance, lightness curves going through
+ * Lab, etc.) and are applied to a lot of pixels, like the adjustment
+ * layers.
+ *
+ * Only integer RGBA color spaces (8 and 16 bits) are supported. The
+ * table is baked with the coarsest grid size (17, 33 or 65 nodes per
+ * axis) whose interpolation error stays under the precision threshold of
+ * the color space. If no grid size is precise enough, or the
+ * transformation changes alpha, createBakedTransformation() returns null
+ * and the original transformation should be used directly.
+ *
+ * The table is immutable and shared between the copies of the
+ * transformation, so copying one for another thread is cheap. The
+ * interpolation itself is done by KoLut3DInterpolator, which has a
+ * vectorized implementation for every architecture supported by Vc.
+ */
+class KRITAPIGMENT_EXPORT KoLut3DColorTransformation : public KoColorTransformation
+{
+public:
+    KoLut3DColorTransformation(const KoLut3DColorTransformation &rhs);
+    ~KoLut3DColorTransformation() override;
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override;
+
+    /**
+     * @return the number of the grid nodes per axis of the baked table
+     */
+    int gridSize() const;
+
+    /**
+     * Recreates the interpolator of the transformation. When \p
+     * forceScalar is true, the scalar implementation is used even if the
+     * CPU supports vector instructions. Used for testing and
+     * benchmarking.
+     */
+    void resetInterpolator(bool forceScalar);
+
+    /**
+     * @return true if the pixels of \p cs can be transformed with a 3D
+     * lookup table
+     */
+    static bool isColorSpaceSupported(const KoColorSpace *cs);
+
+    /**
+     * Bakes \p transformation, working on the pixels of \p cs, into a
+     * lookup table. The ownership of \p transformation is not taken.
+     *
+     * @return the baked transformation or null if \p cs is not supported
+     * or the table cannot reach the precision of the color space
+     */
+    static KoLut3DColorTransformation* createBakedTransformation(const KoColorSpace *cs, const KoColorTransformation *transformation);
+
+private:
+    struct Private;
+    explicit KoLut3DColorTransformation(QSharedPointer<const Private> d);
+
+    QSharedPointer<const Private> m_d;
+    QScopedPointer<KoLut3DInterpolator> m_interpolator;
+};
+
+#endif /* __KO_LUT3D_COLOR_TRANSFORMATION_H */
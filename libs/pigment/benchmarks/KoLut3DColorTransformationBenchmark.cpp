@@ -0,0 +1,217 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "KoLut3DColorTransformationBenchmark.h"
+
+#include <QTest>
+
+#include <KoColorConversions.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceMaths.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorTransformation.h>
+#include <KoLut3DColorTransformation.h>
+
+const int IMG_WIDTH = 4096;
+const int IMG_HEIGHT = 3072;
+
+// the adjustment layers process the image tile by tile
+const int CHUNK_SIZE = 64 * 64;
+
+namespace {
+
+/**
+ * Desaturates and darkens the pixels in HSV, like the HSV adjustment
+ * filter does. The hue is kept, so the transformation is linear between
+ * the planes of the tetrahedra and the coarsest table reproduces it.
+ * The speed of the interpolation doesn't depend on the transformation.
+ */
+template <typename channels_type>
+class HsvAdjustmentTransformation : public KoColorTransformation
+{
+public:
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override {
+        const float unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+
+        const channels_type *srcPixel = reinterpret_cast<const channels_type*>(src);
+        channels_type *dstPixel = reinterpret_cast<channels_type*>(dst);
+
+        for (qint32 i = 0; i < nPixels; i++) {
+            float r = srcPixel[2] / unitValue;
+            float g = srcPixel[1] / unitValue;
+            float b = srcPixel[0] / unitValue;
+
+            float h, s, v;
+            RGBToHSV(r, g, b, &h, &s, &v);
+            HSVToRGB(h, 0.8f * s, 0.9f * v, &r, &g, &b);
+
+            dstPixel[2] = channels_type(qBound(0.0f, r * unitValue + 0.5f, unitValue));
+            dstPixel[1] = channels_type(qBound(0.0f, g * unitValue + 0.5f, unitValue));
+            dstPixel[0] = channels_type(qBound(0.0f, b * unitValue + 0.5f, unitValue));
+            dstPixel[3] = srcPixel[3];
+
+            srcPixel += 4;
+            dstPixel += 4;
+        }
+    }
+};
+
+}
+
+void KoLut3DColorTransformationBenchmark::createRows()
+{
+    QTest::addColumn<bool>("use16Bit");
+
+    QTest::newRow("rgb8") << false;
+    QTest::newRow("rgb16") << true;
+}
+
+void KoLut3DColorTransformationBenchmark::initImage()
+{
+    QFETCH(bool, use16Bit);
+
+    if (use16Bit) {
+        m_colorSpace = KoColorSpaceRegistry::instance()->rgb16();
+        m_exactTransformation.reset(new HsvAdjustmentTransformation<quint16>());
+    } else {
+        m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+        m_exactTransformation.reset(new HsvAdjustmentTransformation<quint8>());
+    }
+
+    m_srcImage.resize(IMG_WIDTH * IMG_HEIGHT * m_colorSpace->pixelSize());
+    m_dstImage.resize(m_srcImage.size());
+
+    qsrand(42);
+    for (int i = 0; i < m_srcImage.size(); i++) {
+        m_srcImage[i] = qrand() & 0xff;
+    }
+}
+
+void KoLut3DColorTransformationBenchmark::processImage(const KoColorTransformation *transformation)
+{
+    const int pixelSize = m_colorSpace->pixelSize();
+    const int numPixels = IMG_WIDTH * IMG_HEIGHT;
+
+    const quint8 *src = m_srcImage.constData();
+    quint8 *dst = m_dstImage.data();
+
+    for (int i = 0; i < numPixels; i += CHUNK_SIZE) {
+        const int offset = i * pixelSize;
+        transformation->transform(src + offset, dst + offset, qMin(CHUNK_SIZE, numPixels - i));
+    }
+}
+
+void KoLut3DColorTransformationBenchmark::cleanup()
+{
+    m_exactTransformation.reset();
+    m_srcImage.clear();
+    m_dstImage.clear();
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkExact_data()
+{
+    createRows();
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkExact()
+{
+    initImage();
+
+    QBENCHMARK {
+        processImage(m_exactTransformation.data());
+    }
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkBake_data()
+{
+    createRows();
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkBake()
+{
+    initImage();
+
+    QBENCHMARK {
+        QScopedPointer<KoLut3DColorTransformation> baked(
+            KoLut3DColorTransformation::createBakedTransformation(m_colorSpace, m_exactTransformation.data()));
+        QVERIFY(baked);
+    }
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkBakedScalar_data()
+{
+    createRows();
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkBakedScalar()
+{
+    initImage();
+
+    QScopedPointer<KoLut3DColorTransformation> baked(
+        KoLut3DColorTransformation::createBakedTransformation(m_colorSpace, m_exactTransformation.data()));
+    QVERIFY(baked);
+
+    baked->resetInterpolator(true);
+
+    QBENCHMARK {
+        processImage(baked.data());
+    }
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkBakedOptimized_data()
+{
+    createRows();
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkBakedOptimized()
+{
+    initImage();
+
+    QScopedPointer<KoLut3DColorTransformation> baked(
+        KoLut3DColorTransformation::createBakedTransformation(m_colorSpace, m_exactTransformation.data()));
+    QVERIFY(baked);
+
+    QBENCHMARK {
+        processImage(baked.data());
+    }
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkPreview_data()
+{
+    createRows();
+}
+
+void KoLut3DColorTransformationBenchmark::benchmarkPreview()
+{
+    initImage();
+
+    /**
+     * Every change of the filter settings bakes a new table, so a
+     * preview update pays for both the baking and the interpolation
+     */
+    QBENCHMARK {
+        QScopedPointer<KoLut3DColorTransformation> baked(
+            KoLut3DColorTransformation::createBakedTransformation(m_colorSpace, m_exactTransformation.data()));
+        QVERIFY(baked);
+
+        processImage(baked.data());
+    }
+}
+
+QTEST_GUILESS_MAIN(KoLut3DColorTransformationBenchmark)
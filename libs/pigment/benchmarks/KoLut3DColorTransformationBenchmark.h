@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KO_LUT3D_COLOR_TRANSFORMATION_BENCHMARK_H_
+#define KO_LUT3D_COLOR_TRANSFORMATION_BENCHMARK_H_
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QVector>
+
+class KoColorSpace;
+class KoColorTransformation;
+
+/**
+ * Measures the preview of a color adjustment on a large image: the exact
+ * per-pixel transformation against the baked lookup table, with the
+ * scalar and the vectorized interpolation. The image is processed in
+ * tile-sized chunks, the way the adjustment layers process it.
+ */
+class KoLut3DColorTransformationBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void cleanup();
+
+    void benchmarkExact_data();
+    void benchmarkExact();
+
+    void benchmarkBake_data();
+    void benchmarkBake();
+
+    void benchmarkBakedScalar_data();
+    void benchmarkBakedScalar();
+
+    void benchmarkBakedOptimized_data();
+    void benchmarkBakedOptimized();
+
+    void benchmarkPreview_data();
+    void benchmarkPreview();
+
+private:
+    void createRows();
+    void initImage();
+    void processImage(const KoColorTransformation *transformation);
+
+private:
+    const KoColorSpace *m_colorSpace = 0;
+    QScopedPointer<KoColorTransformation> m_exactTransformation;
+    QVector<quint8> m_srcImage;
+    QVector<quint8> m_dstImage;
+};
+
+#endif
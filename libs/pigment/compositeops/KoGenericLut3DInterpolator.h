@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KOGENERICLUT3DINTERPOLATOR_H
+#define KOGENERICLUT3DINTERPOLATOR_H
+
+#include "KoLut3DInterpolator.h"
+
+#include "KoBgrColorSpaceTraits.h"
+#include "KoColorSpaceMaths.h"
+
+/**
+ * Reference (scalar) implementation of the 3D lookup table
+ * interpolation. It is used when no vector instructions are available,
+ * for processing the tails of the vectorized loops and for checking the
+ * precision of the tables while baking them.
+ */
+template <typename channels_type>
+class KoGenericLut3DInterpolator : public KoLut3DInterpolator
+{
+    typedef KoBgrTraits<channels_type> Traits;
+
+public:
+    KoGenericLut3DInterpolator(const KoLut3DTable &table)
+        : KoLut3DInterpolator(table)
+    {
+    }
+
+    void transform(const quint8 *src, quint8 *dst, int numPixels) const override {
+        transformPixels(m_table, src, dst, numPixels);
+    }
+
+    /**
+     * Finds the grid cell \p value falls into along one axis and the
+     * position of \p value inside it.
+     */
+    static inline void locate(const KoLut3DTable &table, channels_type value, int &index, float &fraction) {
+        const int unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+        const int gridSize = table.gridSize;
+
+        // the grid lines are rounded to the integer values, so the
+        // estimated cell may be off by one
+        index = int(value) * (gridSize - 1) / unitValue;
+        if (index > gridSize - 2) {
+            index = gridSize - 2;
+        } else if (value >= table.nodeValues[index + 1]) {
+            index++;
+        }
+        if (value < table.nodeValues[index]) {
+            index--;
+        }
+
+        fraction = (int(value) - table.nodeValues[index]) * table.nodeScales[index];
+    }
+
+    /**
+     * Tetrahedral interpolation: the cube of the grid is split into six
+     * tetrahedra by the order of the fractions and the pixel is blended
+     * from the four nodes of the one it falls into.
+     */
+    static inline void interpolate(const KoLut3DTable &table, const channels_type *pixel, float *result) {
+        int ix, iy, iz;
+        float fx, fy, fz;
+        locate(table, pixel[0], ix, fx);
+        locate(table, pixel[1], iy, fy);
+        locate(table, pixel[2], iz, fz);
+
+        const int sz = 4;
+        const int sy = table.gridSize * sz;
+        const int sx = table.gridSize * sy;
+
+        int s1, s2;
+        float f1, f2, f3;
+
+        if (fx >= fy) {
+            if (fy >= fz) {
+                f1 = fx; s1 = sx; f2 = fy; s2 = sy; f3 = fz;
+            } else if (fx >= fz) {
+                f1 = fx; s1 = sx; f2 = fz; s2 = sz; f3 = fy;
+            } else {
+                f1 = fz; s1 = sz; f2 = fx; s2 = sx; f3 = fy;
+            }
+        } else {
+            if (fx >= fz) {
+                f1 = fy; s1 = sy; f2 = fx; s2 = sx; f3 = fz;
+            } else if (fy >= fz) {
+                f1 = fy; s1 = sy; f2 = fz; s2 = sz; f3 = fx;
+            } else {
+                f1 = fz; s1 = sz; f2 = fy; s2 = sy; f3 = fx;
+            }
+        }
+
+        const float *p0 = table.nodes + ix * sx + iy * sy + iz * sz;
+        const float *p1 = p0 + s1;
+        const float *p2 = p1 + s2;
+        const float *p3 = p0 + sx + sy + sz;
+
+        const float w0 = 1.0f - f1;
+        const float w1 = f1 - f2;
+        const float w2 = f2 - f3;
+        const float w3 = f3;
+
+        for (int i = 0; i < 4; i++) {
+            result[i] = w0 * p0[i] + w1 * p1[i] + w2 * p2[i] + w3 * p3[i];
+        }
+    }
+
+    static inline void transformPixels(const KoLut3DTable &table, const quint8 *src, quint8 *dst, int numPixels) {
+        const float unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+
+        const channels_type *srcPixel = reinterpret_cast<const channels_type*>(src);
+        channels_type *dstPixel = reinterpret_cast<channels_type*>(dst);
+
+        float result[4];
+
+        for (int i = 0; i < numPixels; i++) {
+            const channels_type alpha = srcPixel[Traits::alpha_pos];
+            interpolate(table, srcPixel, result);
+
+            for (int c = 0; c < 3; c++) {
+                dstPixel[c] = channels_type(qBound(0.0f, result[c] + 0.5f, unitValue));
+            }
+            dstPixel[Traits::alpha_pos] = alpha;
+
+            srcPixel += Traits::channels_nb;
+            dstPixel += Traits::channels_nb;
+        }
+    }
+};
+
+/**
+ * Creates a scalar interpolator for the pixels described by \p params
+ */
+inline KoLut3DInterpolator* createGenericLut3DInterpolator(const KoLut3DInterpolatorParams &params)
+{
+    if (params.is16Bit) {
+        return new KoGenericLut3DInterpolator<quint16>(params.table);
+    } else {
+        return new KoGenericLut3DInterpolator<quint8>(params.table);
+    }
+}
+
+#endif /* KOGENERICLUT3DINTERPOLATOR_H */
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KOGENERICPIXELDATASCALER_H
+#define KOGENERICPIXELDATASCALER_H
+
+#include "KoOptimizedPixelDataScaler.h"
+#include "KoOptimizedPixelDataScalerFactoryPerArch.h"
+
+#include <KoConfig.h>
+#include "KoColorSpaceMaths.h"
+#include "KoColorModelStandardIds.h"
+
+/**
+ * Reference (scalar) implementation of the pixel data scaler. It is
+ * used as a fallback for the depths that have no vectorized version
+ * (e.g. half float) and for processing the tails of the vectorized
+ * loops.
+ */
+template <typename src_channel_type, typename dst_channel_type>
+class KoGenericPixelDataScaler : public KoOptimizedPixelDataScaler
+{
+public:
+    KoGenericPixelDataScaler(int channelsPerPixel, bool swapRedBlue)
+        : KoOptimizedPixelDataScaler(channelsPerPixel, swapRedBlue)
+    {
+    }
+
+    void convert(const quint8 *src, quint8 *dst, int numPixels) const override {
+        convertValues(reinterpret_cast<const src_channel_type*>(src),
+                      reinterpret_cast<dst_channel_type*>(dst),
+                      numPixels * m_channelsPerPixel,
+                      m_swapRedBlue);
+    }
+
+    /**
+     * Converts \p numValues channel values. When \p swapRedBlue is
+     * true, the data is considered to consist of four-channel pixels.
+     */
+    static inline void convertValues(const src_channel_type *src,
+                                     dst_channel_type *dst,
+                                     int numValues,
+                                     bool swapRedBlue)
+    {
+        typedef KoColorSpaceMaths<src_channel_type, dst_channel_type> Maths;
+
+        if (swapRedBlue) {
+            for (int i = 0; i < numValues; i += 4) {
+                dst[i + 0] = Maths::scaleToA(src[i + 2]);
+                dst[i + 1] = Maths::scaleToA(src[i + 1]);
+                dst[i + 2] = Maths::scaleToA(src[i + 0]);
+                dst[i + 3] = Maths::scaleToA(src[i + 3]);
+            }
+        } else {
+            for (int i = 0; i < numValues; i++) {
+                dst[i] = Maths::scaleToA(src[i]);
+            }
+        }
+    }
+};
+
+namespace KoGenericPixelDataScalerPrivate {
+
+template <typename src_channel_type>
+KoOptimizedPixelDataScaler* createForSource(const KoOptimizedPixelDataScalerParams &params)
+{
+    const int channels = params.channelsPerPixel;
+    const bool swap = params.swapRedBlue;
+
+    if (params.dstDepthId == Integer8BitsColorDepthID.id()) {
+        return new KoGenericPixelDataScaler<src_channel_type, quint8>(channels, swap);
+    } else if (params.dstDepthId == Integer16BitsColorDepthID.id()) {
+        return new KoGenericPixelDataScaler<src_channel_type, quint16>(channels, swap);
+#ifdef HAVE_OPENEXR
+    } else if (params.dstDepthId == Float16BitsColorDepthID.id()) {
+        return new KoGenericPixelDataScaler<src_channel_type, half>(channels, swap);
+#endif
+    } else if (params.dstDepthId == Float32BitsColorDepthID.id()) {
+        return new KoGenericPixelDataScaler<src_channel_type, float>(channels, swap);
+    }
+
+    return 0;
+}
+
+}
+
+/**
+ * Creates a scalar pixel data scaler for the depths passed in \p params
+ * or returns null if any of the depths is not supported.
+ */
+inline KoOptimizedPixelDataScaler* createGenericPixelDataScaler(const KoOptimizedPixelDataScalerParams &params)
+{
+    using namespace KoGenericPixelDataScalerPrivate;
+
+    if (params.srcDepthId == Integer8BitsColorDepthID.id()) {
+        return createForSource<quint8>(params);
+    } else if (params.srcDepthId == Integer16BitsColorDepthID.id()) {
+        return createForSource<quint16>(params);
+#ifdef HAVE_OPENEXR
+    } else if (params.srcDepthId == Float16BitsColorDepthID.id()) {
+        return createForSource<half>(params);
+#endif
+    } else if (params.srcDepthId == Float32BitsColorDepthID.id()) {
+        return createForSource<float>(params);
+    }
+
+    return 0;
+}
+
+#endif /* KOGENERICPIXELDATASCALER_H */
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KOLUT3DINTERPOLATOR_H
+#define KOLUT3DINTERPOLATOR_H
+
+#include <QtGlobal>
+
+/**
+ * A view of a baked 3D lookup table. The table is owned by
+ * KoLut3DColorTransformation, the interpolators only read it.
+ */
+struct KoLut3DTable
+{
+    /// the number of the grid nodes per axis
+    int gridSize;
+
+    /// channel value of every grid line and the inverse distance to the next one
+    const int *nodeValues;
+    const float *nodeScales;
+
+    /**
+     * The transformed color channels of every node, four floats per
+     * node (the fourth one is padding). The strides of the axes are
+     * 4, 4 * gridSize and 4 * gridSize^2 floats.
+     */
+    const float *nodes;
+};
+
+struct KoLut3DInterpolatorParams
+{
+    KoLut3DTable table;
+    bool is16Bit;
+};
+
+/**
+ * An object that transforms RGBA pixels of an integer color space with
+ * tetrahedral interpolation in a 3D lookup table. The first three
+ * channels of a pixel are the coordinates in the table, the alpha
+ * channel is passed through as it is.
+ */
+class KoLut3DInterpolator
+{
+public:
+    KoLut3DInterpolator(const KoLut3DTable &table)
+        : m_table(table)
+    {
+    }
+
+    virtual ~KoLut3DInterpolator() {}
+
+    /**
+     * Transforms \p numPixels pixels from \p src into \p dst. The
+     * buffers may be the same, but must not overlap otherwise.
+     */
+    virtual void transform(const quint8 *src, quint8 *dst, int numPixels) const = 0;
+
+protected:
+    const KoLut3DTable m_table;
+};
+
+#endif /* KOLUT3DINTERPOLATOR_H */
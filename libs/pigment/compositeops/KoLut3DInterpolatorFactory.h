@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KOLUT3DINTERPOLATORFACTORY_H
+#define KOLUT3DINTERPOLATORFACTORY_H
+
+#include "kritapigment_export.h"
+
+struct KoLut3DTable;
+class KoLut3DInterpolator;
+
+/**
+ * Creates the best available implementation of KoLut3DInterpolator for
+ * the current CPU. The vectorized version processes a full SIMD register
+ * of pixels at a time, gathering the table nodes of every pixel, and
+ * leaves the tails to the scalar code.
+ */
+class KRITAPIGMENT_EXPORT KoLut3DInterpolatorFactory
+{
+public:
+    /**
+     * @return a new interpolator reading \p table, which must outlive it.
+     *         The pixels are 16-bit RGBA if \p is16Bit is true and 8-bit
+     *         RGBA otherwise. If \p forceScalar is true, the scalar
+     *         implementation is used regardless of the CPU.
+     */
+    static KoLut3DInterpolator* createInterpolator(const KoLut3DTable &table,
+                                                   bool is16Bit,
+                                                   bool forceScalar = false);
+};
+
+#endif /* KOLUT3DINTERPOLATORFACTORY_H */
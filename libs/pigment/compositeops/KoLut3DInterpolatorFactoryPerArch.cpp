@@ -0,0 +1,255 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#if !defined _MSC_VER
+#pragma GCC diagnostic ignored "-Wundef"
+#endif
+
+#include "KoLut3DInterpolatorFactoryPerArch.h"
+#include "KoGenericLut3DInterpolator.h"
+
+#if defined(__clang__)
+#pragma GCC diagnostic ignored "-Wlocal-type-template-args"
+#endif
+
+/**
+ * Loads the channels of Vc::float_v::size() pixels into separate
+ * integer vectors and stores them back. The structures are templated by
+ * the Vc implementation to make sure the objects compiled for different
+ * architectures never clash during linking.
+ */
+template<Vc::Implementation _impl, typename channels_type>
+struct KoLut3DPixelAccessor;
+
+template<Vc::Implementation _impl>
+struct KoLut3DPixelAccessor<_impl, quint8>
+{
+    using int_v = Vc::SimdArray<int, Vc::float_v::size()>;
+    using uint_v = Vc::SimdArray<unsigned int, Vc::float_v::size()>;
+
+    /**
+     * A BGRA pixel fits into a single 32-bit integer, so the channels are
+     * unpacked with shifts, like KoStreamedMath::fetch_colors_32() does
+     */
+    inline void fetch(const quint8 *src, int_v &c0, int_v &c1, int_v &c2) {
+        m_data.load(reinterpret_cast<const quint32*>(src), Vc::Unaligned);
+
+        const uint_v mask(0xff);
+        c0 = int_v(m_data & mask);
+        c1 = int_v((m_data >> 8) & mask);
+        c2 = int_v((m_data >> 16) & mask);
+    }
+
+    inline void store(quint8 *dst, const int_v &c0, const int_v &c1, const int_v &c2) const {
+        const uint_v alphaMask(0xff000000);
+
+        const uint_v result =
+            uint_v(c0) | (uint_v(c1) << 8) | (uint_v(c2) << 16) | (m_data & alphaMask);
+        result.store(reinterpret_cast<quint32*>(dst), Vc::Unaligned);
+    }
+
+private:
+    uint_v m_data;
+};
+
+template<Vc::Implementation _impl>
+struct KoLut3DPixelAccessor<_impl, quint16>
+{
+    using int_v = Vc::SimdArray<int, Vc::float_v::size()>;
+
+    KoLut3DPixelAccessor()
+        : m_offsets(int_v::IndexesFromZero() * 4)
+    {
+    }
+
+    inline void fetch(const quint16 *src, int_v &c0, int_v &c1, int_v &c2) {
+        c0.gather(src, m_offsets);
+        c1.gather(src + 1, m_offsets);
+        c2.gather(src + 2, m_offsets);
+        m_alpha.gather(src + 3, m_offsets);
+    }
+
+    inline void store(quint16 *dst, const int_v &c0, const int_v &c1, const int_v &c2) const {
+        c0.scatter(dst, m_offsets);
+        c1.scatter(dst + 1, m_offsets);
+        c2.scatter(dst + 2, m_offsets);
+        m_alpha.scatter(dst + 3, m_offsets);
+    }
+
+private:
+    const int_v m_offsets;
+    int_v m_alpha;
+};
+
+/**
+ * The vectorized version of KoGenericLut3DInterpolator. Every pixel of
+ * the vector gets its own tetrahedron, so the selection of the nodes is
+ * done with masks instead of branches and the nodes are gathered from the
+ * table. The arithmetic is done in the same order as in the scalar code.
+ */
+template<Vc::Implementation _impl, typename channels_type>
+class KoOptimizedLut3DInterpolatorImpl : public KoLut3DInterpolator
+{
+    using int_v = Vc::SimdArray<int, Vc::float_v::size()>;
+    typedef KoGenericLut3DInterpolator<channels_type> GenericInterpolator;
+    typedef KoLut3DPixelAccessor<_impl, channels_type> PixelAccessor;
+    typedef KoBgrTraits<channels_type> Traits;
+
+public:
+    KoOptimizedLut3DInterpolatorImpl(const KoLut3DTable &table)
+        : KoLut3DInterpolator(table)
+    {
+    }
+
+    void transform(const quint8 *src, quint8 *dst, int numPixels) const override {
+        const int vectorSize = Vc::float_v::size();
+
+        const channels_type *srcPixel = reinterpret_cast<const channels_type*>(src);
+        channels_type *dstPixel = reinterpret_cast<channels_type*>(dst);
+
+        PixelAccessor accessor;
+        int_v c0, c1, c2;
+
+        int i = 0;
+        for (; i + vectorSize <= numPixels; i += vectorSize) {
+            accessor.fetch(srcPixel, c0, c1, c2);
+            interpolate(c0, c1, c2);
+            accessor.store(dstPixel, c0, c1, c2);
+
+            srcPixel += vectorSize * Traits::channels_nb;
+            dstPixel += vectorSize * Traits::channels_nb;
+        }
+
+        GenericInterpolator::transformPixels(m_table,
+                                             reinterpret_cast<const quint8*>(srcPixel),
+                                             reinterpret_cast<quint8*>(dstPixel),
+                                             numPixels - i);
+    }
+
+private:
+    inline void locate(const int_v &value, int_v &index, Vc::float_v &fraction) const {
+        const int unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+        const int_v lastCell(m_table.gridSize - 2);
+
+        /**
+         * The estimate is done in floats, because there is no vector
+         * integer division. It can be off by one the same way the
+         * integer one is, so the same corrections apply.
+         */
+        const Vc::float_v gridScale(float(m_table.gridSize - 1) / unitValue);
+        index = Vc::simd_cast<int_v>(Vc::simd_cast<Vc::float_v>(value) * gridScale);
+        index = Vc::min(index, lastCell);
+
+        int_v node;
+        node.gather(m_table.nodeValues, index + 1);
+        index(value >= node && index < lastCell) += 1;
+
+        node.gather(m_table.nodeValues, index);
+        index(value < node) -= 1;
+
+        node.gather(m_table.nodeValues, index);
+        Vc::float_v scale;
+        scale.gather(m_table.nodeScales, index);
+
+        fraction = Vc::simd_cast<Vc::float_v>(value - node) * scale;
+    }
+
+    /**
+     * Replaces the channels in \p c0, \p c1 and \p c2 with the
+     * interpolated ones
+     */
+    inline void interpolate(int_v &c0, int_v &c1, int_v &c2) const {
+        int_v ix, iy, iz;
+        Vc::float_v fx, fy, fz;
+        locate(c0, ix, fx);
+        locate(c1, iy, fy);
+        locate(c2, iz, fz);
+
+        const int sz = 4;
+        const int sy = m_table.gridSize * sz;
+        const int sx = m_table.gridSize * sy;
+
+        /**
+         * The tetrahedron goes from the origin of the cell along the
+         * axis with the largest fraction, then along the median one and
+         * ends in the opposite corner. The ties are resolved the same
+         * way the scalar code resolves them.
+         */
+        const Vc::float_m xIsMax = fx >= fy && fx >= fz;
+        const Vc::float_m yIsMax = !xIsMax && fy >= fz;
+        const Vc::float_m zIsMin = fz <= fx && fz <= fy;
+        const Vc::float_m yIsMin = !zIsMin && fy <= fx;
+        const Vc::float_m xIsMin = !zIsMin && !yIsMin;
+
+        const Vc::float_v f1 = Vc::max(fx, Vc::max(fy, fz));
+        const Vc::float_v f3 = Vc::min(fx, Vc::min(fy, fz));
+        const Vc::float_v f2 =
+            Vc::iif(!xIsMax && !xIsMin, fx,
+                    Vc::iif(!yIsMax && !yIsMin, fy, fz));
+
+        // the offsets are far below 2^24, so they are exact in floats
+        const Vc::float_v maxStep =
+            Vc::iif(xIsMax, Vc::float_v(sx),
+                    Vc::iif(yIsMax, Vc::float_v(sy), Vc::float_v(sz)));
+        const Vc::float_v minStep =
+            Vc::iif(zIsMin, Vc::float_v(sz),
+                    Vc::iif(yIsMin, Vc::float_v(sy), Vc::float_v(sx)));
+
+        const int_v p0 = ix * sx + iy * sy + iz * sz;
+        const int_v p1 = p0 + Vc::simd_cast<int_v>(maxStep);
+        const int_v p3 = p0 + (sx + sy + sz);
+        const int_v p2 = p3 - Vc::simd_cast<int_v>(minStep);
+
+        const Vc::float_v w0 = Vc::float_v(1.0f) - f1;
+        const Vc::float_v w1 = f1 - f2;
+        const Vc::float_v w2 = f2 - f3;
+        const Vc::float_v w3 = f3;
+
+        const Vc::float_v zeroValue(Vc::Zero);
+        const Vc::float_v halfValue(0.5f);
+        const Vc::float_v unitValue(float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+
+        int_v *channels[3] = {&c0, &c1, &c2};
+
+        for (int c = 0; c < 3; c++) {
+            const float *nodes = m_table.nodes + c;
+
+            Vc::float_v n0, n1, n2, n3;
+            n0.gather(nodes, p0);
+            n1.gather(nodes, p1);
+            n2.gather(nodes, p2);
+            n3.gather(nodes, p3);
+
+            const Vc::float_v result = w0 * n0 + w1 * n1 + w2 * n2 + w3 * n3;
+            *channels[c] = Vc::simd_cast<int_v>(Vc::min(Vc::max(result + halfValue, zeroValue), unitValue));
+        }
+    }
+};
+
+template<>
+template<>
+KoLut3DInterpolatorFactoryPerArch::ReturnType
+KoLut3DInterpolatorFactoryPerArch::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    if (param.is16Bit) {
+        return new KoOptimizedLut3DInterpolatorImpl<Vc::CurrentImplementation::current(), quint16>(param.table);
+    } else {
+        return new KoOptimizedLut3DInterpolatorImpl<Vc::CurrentImplementation::current(), quint8>(param.table);
+    }
+}
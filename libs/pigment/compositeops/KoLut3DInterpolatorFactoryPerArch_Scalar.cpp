@@ -0,0 +1,30 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "KoLut3DInterpolatorFactoryPerArch.h"
+
+#include "KoGenericLut3DInterpolator.h"
+
+template<>
+template<>
+KoLut3DInterpolatorFactoryPerArch::ReturnType
+KoLut3DInterpolatorFactoryPerArch::create<Vc::ScalarImpl>(ParamType param)
+{
+    return createGenericLut3DInterpolator(param);
+}
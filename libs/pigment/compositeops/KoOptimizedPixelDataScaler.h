@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KOOPTIMIZEDPIXELDATASCALER_H
+#define KOOPTIMIZEDPIXELDATASCALER_H
+
+#include <QtGlobal>
+
+/**
+ * An object that converts pixel data between two bit depths of the
+ * same color model and profile. All the channels, including alpha,
+ * are rescaled with the same rules KoColorSpaceMaths::scaleToA() uses,
+ * so the result is bit-exact with the scalar conversion.
+ *
+ * Integer RGB color spaces store pixels in BGRA order, while floating
+ * point ones use RGBA, so the scaler may optionally swap red and blue
+ * channels of four-channel pixels on the fly.
+ */
+class KoOptimizedPixelDataScaler
+{
+public:
+    KoOptimizedPixelDataScaler(int channelsPerPixel, bool swapRedBlue)
+        : m_channelsPerPixel(channelsPerPixel),
+          m_swapRedBlue(swapRedBlue)
+    {
+    }
+
+    virtual ~KoOptimizedPixelDataScaler() {}
+
+    /**
+     * Converts \p numPixels pixels from \p src into \p dst. The buffers
+     * must not overlap.
+     */
+    virtual void convert(const quint8 *src, quint8 *dst, int numPixels) const = 0;
+
+    int channelsPerPixel() const {
+        return m_channelsPerPixel;
+    }
+
+    bool swapsRedBlue() const {
+        return m_swapRedBlue;
+    }
+
+protected:
+    const int m_channelsPerPixel;
+    const bool m_swapRedBlue;
+};
+
+#endif /* KOOPTIMIZEDPIXELDATASCALER_H */
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "KoOptimizedPixelDataScalerFactoryPerArch.h" // vc.h must come first
+#include "KoOptimizedPixelDataScalerFactory.h"
+
+#include <kis_assert.h>
+
+#if defined(__clang__)
+#pragma GCC diagnostic ignored "-Wundef"
+#endif
+
+
+KoOptimizedPixelDataScaler* KoOptimizedPixelDataScalerFactory::createScaler(const QString &srcDepthId,
+                                                                           const QString &dstDepthId,
+                                                                           int channelsPerPixel,
+                                                                           bool swapRedBlue)
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE(!swapRedBlue || channelsPerPixel == 4, 0);
+
+    if (srcDepthId == dstDepthId) return 0;
+
+    KoOptimizedPixelDataScalerParams params;
+    params.srcDepthId = srcDepthId;
+    params.dstDepthId = dstDepthId;
+    params.channelsPerPixel = channelsPerPixel;
+    params.swapRedBlue = swapRedBlue;
+
+    return createOptimizedClass<KoOptimizedPixelDataScalerFactoryPerArch>(params);
+}
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KOOPTIMIZEDPIXELDATASCALERFACTORY_H
+#define KOOPTIMIZEDPIXELDATASCALERFACTORY_H
+
+#include "kritapigment_export.h"
+
+class QString;
+class KoOptimizedPixelDataScaler;
+
+/**
+ * Creates the best available implementation of KoOptimizedPixelDataScaler
+ * for the current CPU. The vectorized versions exist for U8<->U16 and
+ * U8/U16<->F32 conversions, all the other combinations fall back to the
+ * scalar code.
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerFactory
+{
+public:
+    /**
+     * @return a new scaler converting from \p srcDepthId to \p dstDepthId or
+     *         null if the combination is not supported. \p swapRedBlue
+     *         is allowed for four-channel pixels only.
+     */
+    static KoOptimizedPixelDataScaler* createScaler(const QString &srcDepthId,
+                                                    const QString &dstDepthId,
+                                                    int channelsPerPixel,
+                                                    bool swapRedBlue);
+};
+
+#endif /* KOOPTIMIZEDPIXELDATASCALERFACTORY_H */
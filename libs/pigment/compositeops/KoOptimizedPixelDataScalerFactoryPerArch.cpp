@@ -0,0 +1,272 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#if !defined _MSC_VER
+#pragma GCC diagnostic ignored "-Wundef"
+#endif
+
+#include "KoOptimizedPixelDataScalerFactoryPerArch.h"
+#include "KoGenericPixelDataScaler.h"
+
+#if defined __SSE2__
+#include <emmintrin.h>
+#endif
+
+#if defined(__clang__)
+#pragma GCC diagnostic ignored "-Wlocal-type-template-args"
+#endif
+
+/**
+ * The kernels are templated by the Vc implementation to make sure the
+ * objects compiled for different architectures never clash during linking.
+ *
+ * Every kernel processes the data in 16-byte blocks and returns the number
+ * of channel values it has converted. The rest is handled by the scalar
+ * code. The swapping of red and blue channels is possible only when a
+ * 128-bit register holds exactly one pixel, that is the data is converted
+ * to or from float.
+ */
+template<Vc::Implementation _impl, typename src_channel_type, typename dst_channel_type>
+struct KoPixelDataScalerKernel
+{
+    static inline int process(const src_channel_type *, dst_channel_type *, int, bool) {
+        return 0;
+    }
+};
+
+#if defined __SSE2__
+
+template<Vc::Implementation _impl>
+struct KoPixelDataScalerKernel<_impl, quint8, quint16>
+{
+    static inline int process(const quint8 *src, quint16 *dst, int numValues, bool swapRedBlue) {
+        Q_UNUSED(swapRedBlue);
+
+        int i = 0;
+        for (; i + 16 <= numValues; i += 16) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+            // interleaving a byte with itself is exactly x * 257
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(x, x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(x, x));
+        }
+        return i;
+    }
+};
+
+template<Vc::Implementation _impl>
+struct KoPixelDataScalerKernel<_impl, quint16, quint8>
+{
+    static inline __m128i scaleToU8(__m128i x) {
+        // the same as UINT16_TO_UINT8(): (x - (x >> 8) + 128) >> 8
+        const __m128i offset = _mm_set1_epi16(128);
+        x = _mm_sub_epi16(x, _mm_srli_epi16(x, 8));
+        x = _mm_add_epi16(x, offset);
+        return _mm_srli_epi16(x, 8);
+    }
+
+    static inline int process(const quint16 *src, quint8 *dst, int numValues, bool swapRedBlue) {
+        Q_UNUSED(swapRedBlue);
+
+        int i = 0;
+        for (; i + 16 <= numValues; i += 16) {
+            const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             _mm_packus_epi16(scaleToU8(x0), scaleToU8(x1)));
+        }
+        return i;
+    }
+};
+
+/**
+ * Converts four integer values into floats, the division is used
+ * instead of multiplication to match KoLuts::Uint8ToFloat and
+ * KoLuts::Uint16ToFloat exactly.
+ */
+static inline __m128 scaleInt32ToFloat(__m128i x, __m128 maxValue, bool swapRedBlue) {
+    __m128 value = _mm_div_ps(_mm_cvtepi32_ps(x), maxValue);
+    if (swapRedBlue) {
+        value = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+    }
+    return value;
+}
+
+/**
+ * Converts four floats into clamped integers using the current rounding
+ * mode, which is round-to-nearest-even, the same as float2int() does.
+ */
+static inline __m128i scaleFloatToInt32(__m128 value, __m128 maxValue, bool swapRedBlue) {
+    if (swapRedBlue) {
+        value = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 0, 1, 2));
+    }
+    value = _mm_mul_ps(value, maxValue);
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), maxValue);
+    return _mm_cvtps_epi32(value);
+}
+
+template<Vc::Implementation _impl>
+struct KoPixelDataScalerKernel<_impl, quint8, float>
+{
+    static inline int process(const quint8 *src, float *dst, int numValues, bool swapRedBlue) {
+        const __m128 maxValue = _mm_set1_ps(255.0f);
+        const __m128i zero = _mm_setzero_si128();
+
+        int i = 0;
+        for (; i + 16 <= numValues; i += 16) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            const __m128i lo = _mm_unpacklo_epi8(x, zero);
+            const __m128i hi = _mm_unpackhi_epi8(x, zero);
+
+            _mm_storeu_ps(dst + i, scaleInt32ToFloat(_mm_unpacklo_epi16(lo, zero), maxValue, swapRedBlue));
+            _mm_storeu_ps(dst + i + 4, scaleInt32ToFloat(_mm_unpackhi_epi16(lo, zero), maxValue, swapRedBlue));
+            _mm_storeu_ps(dst + i + 8, scaleInt32ToFloat(_mm_unpacklo_epi16(hi, zero), maxValue, swapRedBlue));
+            _mm_storeu_ps(dst + i + 12, scaleInt32ToFloat(_mm_unpackhi_epi16(hi, zero), maxValue, swapRedBlue));
+        }
+        return i;
+    }
+};
+
+template<Vc::Implementation _impl>
+struct KoPixelDataScalerKernel<_impl, quint16, float>
+{
+    static inline int process(const quint16 *src, float *dst, int numValues, bool swapRedBlue) {
+        const __m128 maxValue = _mm_set1_ps(65535.0f);
+        const __m128i zero = _mm_setzero_si128();
+
+        int i = 0;
+        for (; i + 8 <= numValues; i += 8) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+            _mm_storeu_ps(dst + i, scaleInt32ToFloat(_mm_unpacklo_epi16(x, zero), maxValue, swapRedBlue));
+            _mm_storeu_ps(dst + i + 4, scaleInt32ToFloat(_mm_unpackhi_epi16(x, zero), maxValue, swapRedBlue));
+        }
+        return i;
+    }
+};
+
+template<Vc::Implementation _impl>
+struct KoPixelDataScalerKernel<_impl, float, quint8>
+{
+    static inline int process(const float *src, quint8 *dst, int numValues, bool swapRedBlue) {
+        const __m128 maxValue = _mm_set1_ps(255.0f);
+
+        int i = 0;
+        for (; i + 16 <= numValues; i += 16) {
+            const __m128i x0 = scaleFloatToInt32(_mm_loadu_ps(src + i), maxValue, swapRedBlue);
+            const __m128i x1 = scaleFloatToInt32(_mm_loadu_ps(src + i + 4), maxValue, swapRedBlue);
+            const __m128i x2 = scaleFloatToInt32(_mm_loadu_ps(src + i + 8), maxValue, swapRedBlue);
+            const __m128i x3 = scaleFloatToInt32(_mm_loadu_ps(src + i + 12), maxValue, swapRedBlue);
+
+            // the values are already clamped, so saturation never happens
+            const __m128i lo = _mm_packs_epi32(x0, x1);
+            const __m128i hi = _mm_packs_epi32(x2, x3);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+        }
+        return i;
+    }
+};
+
+template<Vc::Implementation _impl>
+struct KoPixelDataScalerKernel<_impl, float, quint16>
+{
+    static inline int process(const float *src, quint16 *dst, int numValues, bool swapRedBlue) {
+        const __m128 maxValue = _mm_set1_ps(65535.0f);
+
+        /**
+         * SSE2 has no unsigned 32->16 pack, so we shift the values into
+         * the signed range, pack them with saturation (which never
+         * happens) and flip the sign bit back.
+         */
+        const __m128i bias32 = _mm_set1_epi32(32768);
+        const __m128i bias16 = _mm_set1_epi16(-32768);
+
+        int i = 0;
+        for (; i + 8 <= numValues; i += 8) {
+            const __m128i x0 = _mm_sub_epi32(scaleFloatToInt32(_mm_loadu_ps(src + i), maxValue, swapRedBlue), bias32);
+            const __m128i x1 = _mm_sub_epi32(scaleFloatToInt32(_mm_loadu_ps(src + i + 4), maxValue, swapRedBlue), bias32);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             _mm_xor_si128(_mm_packs_epi32(x0, x1), bias16));
+        }
+        return i;
+    }
+};
+
+#endif /* __SSE2__ */
+
+template<Vc::Implementation _impl, typename src_channel_type, typename dst_channel_type>
+class KoOptimizedPixelDataScalerImpl : public KoOptimizedPixelDataScaler
+{
+public:
+    KoOptimizedPixelDataScalerImpl(int channelsPerPixel, bool swapRedBlue)
+        : KoOptimizedPixelDataScaler(channelsPerPixel, swapRedBlue)
+    {
+    }
+
+    void convert(const quint8 *src, quint8 *dst, int numPixels) const override {
+        const src_channel_type *srcPtr = reinterpret_cast<const src_channel_type*>(src);
+        dst_channel_type *dstPtr = reinterpret_cast<dst_channel_type*>(dst);
+        const int numValues = numPixels * m_channelsPerPixel;
+
+        const int numProcessed =
+            KoPixelDataScalerKernel<_impl, src_channel_type, dst_channel_type>::
+                process(srcPtr, dstPtr, numValues, m_swapRedBlue);
+
+        KoGenericPixelDataScaler<src_channel_type, dst_channel_type>::
+            convertValues(srcPtr + numProcessed, dstPtr + numProcessed,
+                          numValues - numProcessed, m_swapRedBlue);
+    }
+};
+
+template<Vc::Implementation _impl>
+KoOptimizedPixelDataScaler* createOptimizedPixelDataScaler(const KoOptimizedPixelDataScalerParams &params)
+{
+    const int channels = params.channelsPerPixel;
+    const bool swap = params.swapRedBlue;
+
+    const QString u8 = Integer8BitsColorDepthID.id();
+    const QString u16 = Integer16BitsColorDepthID.id();
+    const QString f32 = Float32BitsColorDepthID.id();
+
+    if (params.srcDepthId == u8 && params.dstDepthId == u16 && !swap) {
+        return new KoOptimizedPixelDataScalerImpl<_impl, quint8, quint16>(channels, swap);
+    } else if (params.srcDepthId == u16 && params.dstDepthId == u8 && !swap) {
+        return new KoOptimizedPixelDataScalerImpl<_impl, quint16, quint8>(channels, swap);
+    } else if (params.srcDepthId == u8 && params.dstDepthId == f32) {
+        return new KoOptimizedPixelDataScalerImpl<_impl, quint8, float>(channels, swap);
+    } else if (params.srcDepthId == u16 && params.dstDepthId == f32) {
+        return new KoOptimizedPixelDataScalerImpl<_impl, quint16, float>(channels, swap);
+    } else if (params.srcDepthId == f32 && params.dstDepthId == u8) {
+        return new KoOptimizedPixelDataScalerImpl<_impl, float, quint8>(channels, swap);
+    } else if (params.srcDepthId == f32 && params.dstDepthId == u16) {
+        return new KoOptimizedPixelDataScalerImpl<_impl, float, quint16>(channels, swap);
+    }
+
+    return createGenericPixelDataScaler(params);
+}
+
+template<>
+template<>
+KoOptimizedPixelDataScalerFactoryPerArch::ReturnType
+KoOptimizedPixelDataScalerFactoryPerArch::create<Vc::CurrentImplementation::current()>(ParamType param)
+{
+    return createOptimizedPixelDataScaler<Vc::CurrentImplementation::current()>(param);
+}
@@ -0,0 +1,328 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "TestKoLut3DColorTransformation.h"
+
+#include <QTest>
+
+#include <cmath>
+
+#include <KoColorSpace.h>
+#include <KoColorSpaceMaths.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorTransformation.h>
+#include <KoLut3DColorTransformation.h>
+
+namespace {
+
+/**
+ * Applies a function of the normalized BGR values to every pixel,
+ * keeping alpha
+ */
+template <typename channels_type, typename Func>
+struct TestColorTransformation : public KoColorTransformation
+{
+    TestColorTransformation(Func func) : m_func(func) {}
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override {
+        const int unitValue = KoColorSpaceMathsTraits<channels_type>::unitValue;
+
+        const channels_type *srcPixel = reinterpret_cast<const channels_type*>(src);
+        channels_type *dstPixel = reinterpret_cast<channels_type*>(dst);
+
+        for (qint32 i = 0; i < nPixels; i++) {
+            qreal bgr[3];
+            for (int c = 0; c < 3; c++) {
+                bgr[c] = qreal(srcPixel[c]) / unitValue;
+            }
+            m_func(bgr);
+
+            for (int c = 0; c < 3; c++) {
+                dstPixel[c] = channels_type(qBound(0, qRound(bgr[c] * unitValue), unitValue));
+            }
+            dstPixel[3] = srcPixel[3];
+
+            srcPixel += 4;
+            dstPixel += 4;
+        }
+    }
+
+    Func m_func;
+};
+
+template <typename channels_type = quint8, typename Func>
+TestColorTransformation<channels_type, Func>* createTestTransformation(Func func)
+{
+    return new TestColorTransformation<channels_type, Func>(func);
+}
+
+// every channel is darkened by the next one
+void darkenByNextChannel(qreal *bgr)
+{
+    const qreal b = bgr[0];
+    const qreal g = bgr[1];
+    const qreal r = bgr[2];
+    bgr[0] = b * (1.0 - 0.3 * g);
+    bgr[1] = g * (1.0 - 0.3 * r);
+    bgr[2] = r * (1.0 - 0.3 * b);
+}
+
+QVector<quint8> randomPixels(const KoColorSpace *cs, int numPixels)
+{
+    QVector<quint8> pixels(numPixels * cs->pixelSize());
+
+    qsrand(1);
+    for (int i = 0; i < pixels.size(); i++) {
+        pixels[i] = qrand() % 256;
+    }
+
+    return pixels;
+}
+
+template <typename channels_type = quint8>
+int maxDifference(const QVector<quint8> &lhs, const QVector<quint8> &rhs)
+{
+    const channels_type *lhsPtr = reinterpret_cast<const channels_type*>(lhs.constData());
+    const channels_type *rhsPtr = reinterpret_cast<const channels_type*>(rhs.constData());
+    const int size = lhs.size() / sizeof(channels_type);
+
+    int result = 0;
+    for (int i = 0; i < size; i++) {
+        result = qMax(result, qAbs(int(lhsPtr[i]) - int(rhsPtr[i])));
+    }
+    return result;
+}
+
+}
+
+void TestKoLut3DColorTransformation::testLinearTransformation_data()
+{
+    QTest::addColumn<bool>("use16Bit");
+
+    QTest::newRow("rgb8") << false;
+    QTest::newRow("rgb16") << true;
+}
+
+void TestKoLut3DColorTransformation::testLinearTransformation()
+{
+    QFETCH(bool, use16Bit);
+
+    const KoColorSpace *cs =
+        use16Bit ?
+        KoColorSpaceRegistry::instance()->rgb16() :
+        KoColorSpaceRegistry::instance()->rgb8();
+
+    /**
+     * Inversion is linear, so the coarsest table reproduces it exactly
+     */
+    QScopedPointer<KoColorTransformation> exact(cs->createInvertTransformation());
+    QScopedPointer<KoLut3DColorTransformation> baked(
+        KoLut3DColorTransformation::createBakedTransformation(cs, exact.data()));
+
+    QVERIFY(baked);
+    QCOMPARE(baked->gridSize(), 17);
+
+    const int numPixels = 4096;
+    QVector<quint8> src = randomPixels(cs, numPixels);
+
+    // the transformations are applied in place, so dst holds the source pixels
+    QVector<quint8> exactResult = src;
+    QVector<quint8> bakedResult = src;
+
+    exact->transform(src.constData(), exactResult.data(), numPixels);
+    baked->transform(src.constData(), bakedResult.data(), numPixels);
+
+    QCOMPARE(bakedResult, exactResult);
+
+    // the transformation works in place as well
+    baked->transform(src.constData(), src.data(), numPixels);
+    QCOMPARE(src, exactResult);
+}
+
+void TestKoLut3DColorTransformation::testSmoothTransformation()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    QScopedPointer<KoColorTransformation> exact(createTestTransformation(darkenByNextChannel));
+
+    QScopedPointer<KoLut3DColorTransformation> baked(
+        KoLut3DColorTransformation::createBakedTransformation(cs, exact.data()));
+
+    QVERIFY(baked);
+
+    const int numPixels = 65536;
+    const QVector<quint8> src = randomPixels(cs, numPixels);
+    QVector<quint8> exactResult = src;
+    QVector<quint8> bakedResult = src;
+
+    exact->transform(src.constData(), exactResult.data(), numPixels);
+    baked->transform(src.constData(), bakedResult.data(), numPixels);
+
+    QVERIFY(maxDifference(exactResult, bakedResult) <= 1);
+
+    for (int i = 3; i < src.size(); i += 4) {
+        QCOMPARE(bakedResult[i], src[i]);
+    }
+}
+
+void TestKoLut3DColorTransformation::test16BitPrecision()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb16();
+
+    QScopedPointer<KoColorTransformation> exact(createTestTransformation<quint16>(darkenByNextChannel));
+    QScopedPointer<KoLut3DColorTransformation> baked(
+        KoLut3DColorTransformation::createBakedTransformation(cs, exact.data()));
+
+    // only the finest grid reaches the 16-bit precision
+    QVERIFY(baked);
+    QCOMPARE(baked->gridSize(), 65);
+
+    const int numPixels = 65536;
+    const QVector<quint8> src = randomPixels(cs, numPixels);
+    QVector<quint8> exactResult = src;
+    QVector<quint8> bakedResult = src;
+
+    exact->transform(src.constData(), exactResult.data(), numPixels);
+    baked->transform(src.constData(), bakedResult.data(), numPixels);
+
+    QVERIFY(maxDifference<quint16>(exactResult, bakedResult) <= 4);
+
+    // a gamma curve is too steep near black for any grid
+    QScopedPointer<KoColorTransformation> gamma(
+        createTestTransformation<quint16>([] (qreal *bgr) {
+            for (int c = 0; c < 3; c++) {
+                bgr[c] = std::pow(bgr[c], 1.0 / 2.2);
+            }
+        }));
+    QVERIFY(!KoLut3DColorTransformation::createBakedTransformation(cs, gamma.data()));
+}
+
+void TestKoLut3DColorTransformation::testExactFallback()
+{
+    const KoColorSpace *rgb8 = KoColorSpaceRegistry::instance()->rgb8();
+
+    // the threshold cannot be interpolated with any precision
+    QScopedPointer<KoColorTransformation> threshold(
+        createTestTransformation([] (qreal *bgr) {
+            for (int c = 0; c < 3; c++) {
+                bgr[c] = bgr[c] > 0.5 ? 1.0 : 0.0;
+            }
+        }));
+    QVERIFY(!KoLut3DColorTransformation::createBakedTransformation(rgb8, threshold.data()));
+
+    // a transformation that touches alpha is not a pure color one
+    struct AlphaTransformation : public KoColorTransformation {
+        void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override {
+            for (qint32 i = 0; i < nPixels; i++) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = src[3] / 2;
+                src += 4;
+                dst += 4;
+            }
+        }
+    } alphaTransformation;
+    QVERIFY(!KoLut3DColorTransformation::createBakedTransformation(rgb8, &alphaTransformation));
+
+    // only integer RGB color spaces are supported
+    const KoColorSpace *alpha8 = KoColorSpaceRegistry::instance()->alpha8();
+    QScopedPointer<KoColorTransformation> alphaInvert(alpha8->createInvertTransformation());
+    QVERIFY(!KoLut3DColorTransformation::isColorSpaceSupported(alpha8));
+    QVERIFY(!KoLut3DColorTransformation::createBakedTransformation(alpha8, alphaInvert.data()));
+    QVERIFY(KoLut3DColorTransformation::isColorSpaceSupported(rgb8));
+}
+
+void TestKoLut3DColorTransformation::testSharedTable()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+
+    QScopedPointer<KoColorTransformation> exact(cs->createInvertTransformation());
+    QScopedPointer<KoLut3DColorTransformation> baked(
+        KoLut3DColorTransformation::createBakedTransformation(cs, exact.data()));
+    QVERIFY(baked);
+
+    const int numPixels = 1024;
+    const QVector<quint8> src = randomPixels(cs, numPixels);
+    QVector<quint8> bakedResult = src;
+    QVector<quint8> copyResult = src;
+
+    baked->transform(src.constData(), bakedResult.data(), numPixels);
+
+    // the copy outlives the original one
+    QScopedPointer<KoLut3DColorTransformation> copy(new KoLut3DColorTransformation(*baked));
+    baked.reset();
+
+    QCOMPARE(copy->gridSize(), 17);
+    copy->transform(src.constData(), copyResult.data(), numPixels);
+    QCOMPARE(copyResult, bakedResult);
+}
+
+void TestKoLut3DColorTransformation::testScalarImplementation_data()
+{
+    QTest::addColumn<bool>("use16Bit");
+
+    QTest::newRow("rgb8") << false;
+    QTest::newRow("rgb16") << true;
+}
+
+void TestKoLut3DColorTransformation::testScalarImplementation()
+{
+    QFETCH(bool, use16Bit);
+
+    const KoColorSpace *cs =
+        use16Bit ?
+        KoColorSpaceRegistry::instance()->rgb16() :
+        KoColorSpaceRegistry::instance()->rgb8();
+
+    QScopedPointer<KoColorTransformation> exact(
+        use16Bit ?
+        static_cast<KoColorTransformation*>(createTestTransformation<quint16>(darkenByNextChannel)) :
+        static_cast<KoColorTransformation*>(createTestTransformation<quint8>(darkenByNextChannel)));
+
+    QScopedPointer<KoLut3DColorTransformation> baked(
+        KoLut3DColorTransformation::createBakedTransformation(cs, exact.data()));
+    QVERIFY(baked);
+
+    // an odd number of pixels makes sure the tails are processed
+    const int numPixels = 65537;
+    const QVector<quint8> src = randomPixels(cs, numPixels);
+    QVector<quint8> optimizedResult = src;
+    QVector<quint8> scalarResult = src;
+
+    baked->transform(src.constData(), optimizedResult.data(), numPixels);
+
+    baked->resetInterpolator(true);
+    baked->transform(src.constData(), scalarResult.data(), numPixels);
+
+    // the vector code may contract the blending into fused multiply-adds
+    const int difference =
+        use16Bit ?
+        maxDifference<quint16>(optimizedResult, scalarResult) :
+        maxDifference<quint8>(optimizedResult, scalarResult);
+    QVERIFY(difference <= 1);
+
+    const int pixelSize = cs->pixelSize();
+    const int channelSize = pixelSize / 4;
+    for (int i = 3 * channelSize; i < src.size(); i += pixelSize) {
+        QCOMPARE(optimizedResult.mid(i, channelSize), src.mid(i, channelSize));
+    }
+}
+
+QTEST_GUILESS_MAIN(TestKoLut3DColorTransformation)
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "TestKoOptimizedPixelDataScaler.h"
+
+#include <QTest>
+#include <QScopedPointer>
+
+#include <KoConfig.h>
+#include "KoColorModelStandardIds.h"
+#include "compositeops/KoOptimizedPixelDataScaler.h"
+#include "compositeops/KoOptimizedPixelDataScalerFactory.h"
+#include "compositeops/KoGenericPixelDataScaler.h"
+
+namespace {
+
+int channelSize(const QString &depthId)
+{
+    return depthId == Integer8BitsColorDepthID.id() ? 1 :
+           depthId == Integer16BitsColorDepthID.id() ? 2 :
+           depthId == Float16BitsColorDepthID.id() ? 2 : 4;
+}
+
+void fillRandomData(QByteArray &data, const QString &depthId)
+{
+    if (depthId == Float32BitsColorDepthID.id()) {
+        float *ptr = reinterpret_cast<float*>(data.data());
+        const int numValues = data.size() / int(sizeof(float));
+
+        for (int i = 0; i < numValues; i++) {
+            // include some out-of-range values to check clamping
+            ptr[i] = -0.1f + 1.2f * float(qrand()) / RAND_MAX;
+        }
+#ifdef HAVE_OPENEXR
+    } else if (depthId == Float16BitsColorDepthID.id()) {
+        half *ptr = reinterpret_cast<half*>(data.data());
+        const int numValues = data.size() / int(sizeof(half));
+
+        for (int i = 0; i < numValues; i++) {
+            ptr[i] = float(qrand()) / RAND_MAX;
+        }
+#endif
+    } else {
+        for (int i = 0; i < data.size(); i++) {
+            data[i] = char(qrand() & 0xff);
+        }
+    }
+}
+
+}
+
+void TestKoOptimizedPixelDataScaler::testConversion_data()
+{
+    QTest::addColumn<QString>("srcDepthId");
+    QTest::addColumn<QString>("dstDepthId");
+    QTest::addColumn<int>("channelsPerPixel");
+    QTest::addColumn<bool>("swapRedBlue");
+
+    QStringList depths;
+    depths << Integer8BitsColorDepthID.id();
+    depths << Integer16BitsColorDepthID.id();
+#ifdef HAVE_OPENEXR
+    depths << Float16BitsColorDepthID.id();
+#endif
+    depths << Float32BitsColorDepthID.id();
+
+    Q_FOREACH (const QString &src, depths) {
+        Q_FOREACH (const QString &dst, depths) {
+            if (src == dst) continue;
+
+            QTest::newRow(QString("%1-%2-gray").arg(src).arg(dst).toLatin1()) << src << dst << 2 << false;
+            QTest::newRow(QString("%1-%2-rgba").arg(src).arg(dst).toLatin1()) << src << dst << 4 << false;
+            QTest::newRow(QString("%1-%2-rgba-swap").arg(src).arg(dst).toLatin1()) << src << dst << 4 << true;
+        }
+    }
+}
+
+void TestKoOptimizedPixelDataScaler::testConversion()
+{
+    QFETCH(QString, srcDepthId);
+    QFETCH(QString, dstDepthId);
+    QFETCH(int, channelsPerPixel);
+    QFETCH(bool, swapRedBlue);
+
+    // an odd number of pixels makes sure the tails are processed
+    const int numPixels = 1037;
+
+    QByteArray src(numPixels * channelsPerPixel * channelSize(srcDepthId), 0);
+    QByteArray dst(numPixels * channelsPerPixel * channelSize(dstDepthId), 0);
+    QByteArray ref(dst.size(), 0);
+
+    fillRandomData(src, srcDepthId);
+
+    KoOptimizedPixelDataScalerParams params;
+    params.srcDepthId = srcDepthId;
+    params.dstDepthId = dstDepthId;
+    params.channelsPerPixel = channelsPerPixel;
+    params.swapRedBlue = swapRedBlue;
+
+    QScopedPointer<KoOptimizedPixelDataScaler> refScaler(createGenericPixelDataScaler(params));
+    QScopedPointer<KoOptimizedPixelDataScaler> scaler(
+        KoOptimizedPixelDataScalerFactory::createScaler(srcDepthId, dstDepthId,
+                                                        channelsPerPixel, swapRedBlue));
+
+    QVERIFY(refScaler);
+    QVERIFY(scaler);
+
+    refScaler->convert(reinterpret_cast<const quint8*>(src.constData()),
+                       reinterpret_cast<quint8*>(ref.data()), numPixels);
+
+    scaler->convert(reinterpret_cast<const quint8*>(src.constData()),
+                    reinterpret_cast<quint8*>(dst.data()), numPixels);
+
+    QCOMPARE(dst, ref);
+}
+
+void TestKoOptimizedPixelDataScaler::testUnsupportedDepths()
+{
+    QScopedPointer<KoOptimizedPixelDataScaler> scaler;
+
+    scaler.reset(KoOptimizedPixelDataScalerFactory::createScaler(Integer8BitsColorDepthID.id(),
+                                                                 Integer8BitsColorDepthID.id(),
+                                                                 4, false));
+    QVERIFY(!scaler);
+
+    scaler.reset(KoOptimizedPixelDataScalerFactory::createScaler(Integer8BitsColorDepthID.id(),
+                                                                 Float64BitsColorDepthID.id(),
+                                                                 4, false));
+    QVERIFY(!scaler);
+}
+
+QTEST_GUILESS_MAIN(TestKoOptimizedPixelDataScaler)
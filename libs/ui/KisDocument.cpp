@@ -1737,13 +1737,15 @@ bool KisDocument::newImage(const QString& name,
     documentInfo()->setAboutInfo("title", name);
     documentInfo()->setAboutInfo("abstract", description);
 
+    const KoColorSpace *layerColorSpace = KisLayerUtils::newPaintLayerColorSpace(image);
+
     KisLayerSP layer;
     if (bgStyle == KisConfig::RASTER_LAYER || bgStyle == KisConfig::FILL_LAYER) {
         KoColor strippedAlpha = bgColor;
         strippedAlpha.setOpacity(OPACITY_OPAQUE_U8);
 
         if (bgStyle == KisConfig::RASTER_LAYER) {
-            layer = new KisPaintLayer(image.data(), "Background", OPACITY_OPAQUE_U8, cs);;
+            layer = new KisPaintLayer(image.data(), "Background", OPACITY_OPAQUE_U8, layerColorSpace);
             layer->paintDevice()->setDefaultPixel(strippedAlpha);
         } else if (bgStyle == KisConfig::FILL_LAYER) {
             KisFilterConfigurationSP filter_config = KisGeneratorRegistry::instance()->get("color")->defaultConfiguration();
@@ -1760,7 +1762,7 @@ bool KisDocument::newImage(const QString& name,
     }
     else { // KisConfig::CANVAS_COLOR (needs an unlocked starting layer).
         image->setDefaultProjectionColor(bgColor);
-        layer = new KisPaintLayer(image.data(), image->nextLayerName(), OPACITY_OPAQUE_U8, cs);
+        layer = new KisPaintLayer(image.data(), image->nextLayerName(), OPACITY_OPAQUE_U8, layerColorSpace);
     }
 
     Q_CHECK_PTR(layer);
@@ -1770,7 +1772,7 @@ bool KisDocument::newImage(const QString& name,
     setCurrentImage(image);
 
     for(int i = 1; i < numberOfLayers; ++i) {
-        KisPaintLayerSP layer = new KisPaintLayer(image, image->nextLayerName(), OPACITY_OPAQUE_U8, cs);
+        KisPaintLayerSP layer = new KisPaintLayer(image, image->nextLayerName(), OPACITY_OPAQUE_U8, layerColorSpace);
         image->addNode(layer, image->root(), i);
         layer->setDirty(QRect(0, 0, width, height));
     }
@@ -696,6 +696,16 @@ void KisConfig::setUseOpenGLTextureBuffer(bool useBuffer)
     m_cfg.writeEntry("useOpenGLTextureBuffer", useBuffer);
 }
 
+bool KisConfig::useHalfFloatTexturesForFloatImages(bool defaultValue) const
+{
+    return (defaultValue ? false : m_cfg.readEntry("useHalfFloatTexturesForFloatImages", false));
+}
+
+void KisConfig::setUseHalfFloatTexturesForFloatImages(bool value)
+{
+    m_cfg.writeEntry("useHalfFloatTexturesForFloatImages", value);
+}
+
 int KisConfig::openGLTextureSize(bool defaultValue) const
 {
     return (defaultValue ? 256 : m_cfg.readEntry("textureSize", 256));
@@ -186,6 +186,15 @@ public:
     bool useOpenGLTextureBuffer(bool defaultValue = false) const;
     void setUseOpenGLTextureBuffer(bool useBuffer);
 
+    /**
+     * Upload the projection of 32-bit float RGBA images to half float
+     * textures. Halves the texture memory and the upload bandwidth, at
+     * the cost of precision that is not visible on the display anyway.
+     * Ignored when the GPU cannot accept half float pixels.
+     */
+    bool useHalfFloatTexturesForFloatImages(bool defaultValue = false) const;
+    void setUseHalfFloatTexturesForFloatImages(bool value);
+
     bool disableVSync(bool defaultValue = false) const;
     void setDisableVSync(bool disableVSync);
 
@@ -452,6 +452,22 @@ bool KisOpenGLImageTextures::setInternalColorManagementActive(bool value)
 }
 
 namespace {
+/**
+ * Half float pixels can be uploaded only if they can be converted
+ * from the projection with the built-in OpenEXR half type
+ */
+bool hasHalfFloatPixelTransfer(QOpenGLContext *ctx)
+{
+    bool haveBuiltInOpenExr = false;
+#ifdef HAVE_OPENEXR
+    haveBuiltInOpenExr = true;
+#endif
+
+    return haveBuiltInOpenExr &&
+        (KisOpenGL::hasOpenGLES() || KisOpenGL::hasOpenGL3() ||
+         ctx->hasExtension("GL_ARB_half_float_pixel"));
+}
+
 void initializeRGBA16FTextures(QOpenGLContext *ctx, KisGLTexturesInfo &texturesInfo, KoID &destinationColorDepthId)
 {
     if (KisOpenGL::hasOpenGLES() || KisOpenGL::hasOpenGL3()) {
@@ -523,6 +539,17 @@ void KisOpenGLImageTextures::updateTextureFormat()
         if (colorDepthId == Float16BitsColorDepthID) {
             initializeRGBA16FTextures(ctx, m_texturesInfo, destinationColorDepthId);
         }
+        else if (colorDepthId == Float32BitsColorDepthID &&
+                 KisConfig(true).useHalfFloatTexturesForFloatImages() &&
+                 hasHalfFloatPixelTransfer(ctx)) {
+
+            /**
+             * The projection stays in full precision, only the copy
+             * uploaded to the GPU is converted to half float. Without
+             * half float pixel transfer the float textures are used.
+             */
+            initializeRGBA16FTextures(ctx, m_texturesInfo, destinationColorDepthId);
+        }
         else if (colorDepthId == Float32BitsColorDepthID) {
             if (KisOpenGL::hasOpenGLES() || KisOpenGL::hasOpenGL3()) {
                 m_texturesInfo.internalFormat = GL_RGBA32F;
@@ -27,6 +27,9 @@
 #include "kis_resources_snapshot.h"
 #include "kis_image.h"
 #include <brushengine/kis_paint_information.h>
+#include <brushengine/kis_paintop_preset.h>
+#include <brushengine/KisPaintopSettingsIds.h>
+#include <kis_canvas_resource_provider.h>
 
 class FreehandStrokeBenchmarkTester : public utils::StrokeTester
 {
@@ -41,6 +44,10 @@ public:
         m_cpuCoresLimit = value;
     }
 
+    void setUseMaskingBrush(bool value) {
+        m_useMaskingBrush = value;
+    }
+
 protected:
     using utils::StrokeTester::initImage;
     void initImage(KisImageWSP image, KisNodeSP activeNode) override {
@@ -51,6 +58,35 @@ protected:
         }
     }
 
+    using utils::StrokeTester::modifyResourceManager;
+    void modifyResourceManager(KoCanvasResourceProvider *manager,
+                               KisImageWSP image) override
+    {
+        Q_UNUSED(image);
+
+        if (!m_useMaskingBrush) return;
+
+        /**
+         * Use the main brush tip as a masking brush as well, so that
+         * the masking brush renderer and the masking composite op get
+         * exercised on the same amount of pixels as the main brush.
+         */
+        KisPaintOpPresetSP preset =
+            manager->resource(KisCanvasResourceProvider::CurrentPaintOpPreset).value<KisPaintOpPresetSP>();
+        KIS_SAFE_ASSERT_RECOVER_RETURN(preset);
+
+        KisPaintOpSettingsSP settings = preset->settings();
+        settings->setProperty(KisPaintOpUtils::MaskingBrushEnabledTag, true);
+        settings->setProperty(KisPaintOpUtils::MaskingBrushCompositeOpTag, COMPOSITE_MULT);
+        settings->setProperty(KisPaintOpUtils::MaskingBrushUseMasterSizeTag, true);
+        settings->setProperty(KisPaintOpUtils::MaskingBrushMasterSizeCoeffTag, 1.0);
+        settings->setProperty(QString(KisPaintOpUtils::MaskingBrushPresetPrefix) + "brush_definition",
+                              settings->getString("brush_definition"));
+
+        // masking brush works in indirect painting mode only
+        settings->setProperty("PaintOpAction", 2 /* WASH */);
+    }
+
     KisStrokeStrategy* createStroke(KisResourcesSnapshotSP resources,
                                     KisImageWSP image) override {
         Q_UNUSED(image);
@@ -91,11 +127,13 @@ protected:
 
 private:
     int m_cpuCoresLimit = -1;
+    bool m_useMaskingBrush = false;
 };
 
-void benchmarkBrush(const QString &presetName)
+void benchmarkBrush(const QString &presetName, bool useMaskingBrush = false)
 {
     FreehandStrokeBenchmarkTester tester(presetName);
+    tester.setUseMaskingBrush(useMaskingBrush);
 
     for (int i = 1; i <= QThread::idealThreadCount(); i++) {
         tester.setCpuCoresLimit(i);
@@ -152,4 +190,9 @@ void FreehandStrokeBenchmark::testColorsmudgeDefaultTip()
     benchmarkBrush("testing_200px_colorsmudge_default.kpp");
 }
 
+void FreehandStrokeBenchmark::testDefaultTipMasked()
+{
+    benchmarkBrush("testing_1000px_auto_deafult.kpp", true);
+}
+
 QTEST_MAIN(FreehandStrokeBenchmark)
@@ -38,6 +38,8 @@ private Q_SLOTS:
     void testStampTip();
 
     void testColorsmudgeDefaultTip();
+
+    void testDefaultTipMasked();
 };
 
 #endif // FREEHANDSTROKEBENCHMARK_H
@@ -0,0 +1,310 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisStrokeReplayBenchmark.h"
+
+#include <QTest>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+#include <KoColor.h>
+#include <KoColorSpace.h>
+#include <KoCanvasResourceProvider.h>
+
+#include "stroke_testing_utils.h"
+#include "strokes/freehand_stroke.h"
+#include "strokes/KisFreehandStrokeInfo.h"
+#include "KisFreehandStrokeRecording.h"
+#include "kis_canvas_resource_provider.h"
+#include "kis_resources_snapshot.h"
+#include "kis_distance_information.h"
+#include "kis_image.h"
+#include "kis_paint_layer.h"
+#include "kis_paint_device.h"
+#include <brushengine/kis_paintop_registry.h>
+#include <brushengine/kis_paintop_preset.h>
+
+namespace {
+
+struct ReplayStatistics
+{
+    QElapsedTimer timer;
+    int numDabs = 0;
+    qint64 renderingTime = 0;
+    qint64 timeToCanvas = 0;
+    QString checksum;
+};
+
+/**
+ * Fetches the number of painted dabs right before the stroke infos are
+ * destroyed by the base class
+ */
+class ReplayStrokeStrategy : public FreehandStrokeStrategy
+{
+public:
+    ReplayStrokeStrategy(KisResourcesSnapshotSP resources,
+                         QVector<KisFreehandStrokeInfo*> strokeInfos,
+                         ReplayStatistics *stats)
+        : FreehandStrokeStrategy(resources, strokeInfos, kundo2_noi18n("Replay Stroke")),
+          m_strokeInfos(strokeInfos),
+          m_stats(stats)
+    {
+    }
+
+    void finishStrokeCallback() override {
+        m_stats->numDabs = 0;
+        Q_FOREACH (KisFreehandStrokeInfo *info, m_strokeInfos) {
+            m_stats->numDabs += info->dragDistance->currentDabSeqNo();
+        }
+
+        FreehandStrokeStrategy::finishStrokeCallback();
+        m_stats->renderingTime = m_stats->timer.elapsed();
+    }
+
+private:
+    QVector<KisFreehandStrokeInfo*> m_strokeInfos;
+    ReplayStatistics *m_stats;
+};
+
+QString recordingsDir()
+{
+    const QString dir = QString::fromLocal8Bit(qgetenv("KRITA_STROKE_RECORDING_DIR"));
+    return !dir.isEmpty() ? dir : QString(FILES_DATA_DIR) + QDir::separator() + "stroke_recordings";
+}
+
+QString projectionChecksum(KisImageSP image)
+{
+    const QRect rc = image->bounds();
+    KisPaintDeviceSP projection = image->projection();
+
+    QByteArray bytes(rc.width() * rc.height() * projection->pixelSize(), 0);
+    projection->readBytes(reinterpret_cast<quint8*>(bytes.data()), rc);
+
+    return QCryptographicHash::hash(bytes, QCryptographicHash::Md5).toHex();
+}
+
+QString referenceChecksum(const QString &recordingFileName, const QString &presetName)
+{
+    QFile file(recordingFileName + ".md5");
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return QString();
+
+    while (!file.atEnd()) {
+        const QStringList parts = QString::fromUtf8(file.readLine()).trimmed().split(' ', QString::SkipEmptyParts);
+        if (parts.size() == 2 && parts[0] == presetName) {
+            return parts[1];
+        }
+    }
+
+    return QString();
+}
+
+void writeReferenceChecksum(const QString &recordingFileName, const QString &presetName, const QString &checksum)
+{
+    QStringList lines;
+
+    QFile file(recordingFileName + ".md5");
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!file.atEnd()) {
+            const QString line = QString::fromUtf8(file.readLine()).trimmed();
+            if (!line.isEmpty() && line.section(' ', 0, 0) != presetName) {
+                lines << line;
+            }
+        }
+        file.close();
+    }
+
+    lines << QString("%1 %2").arg(presetName).arg(checksum);
+    std::sort(lines.begin(), lines.end());
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        qWarning() << "Failed to write the reference checksum to" << file.fileName();
+        return;
+    }
+
+    Q_FOREACH (const QString &line, lines) {
+        file.write(line.toUtf8() + '\n');
+    }
+}
+
+/**
+ * Replays \p recording with \p preset on a new image and returns the
+ * statistics of the stroke together with the checksum of the projection
+ */
+void replayRecording(const KisFreehandStrokeRecording &recording,
+                     KisPaintOpPresetSP preset,
+                     ReplayStatistics *stats)
+{
+    const QRect imageRect(QPoint(), recording.imageSize());
+    const KoColorSpace *cs = recording.colorSpace();
+
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "stroke replay");
+    KisPaintLayerSP layer = new KisPaintLayer(image, "layer", OPACITY_OPAQUE_U8, cs);
+    image->addNode(layer, image->root());
+
+    layer->paintDevice()->fill(imageRect, recording.bgColor());
+    image->refreshGraphAsync();
+    image->waitForDone();
+
+    QScopedPointer<KoCanvasResourceProvider> manager(
+        utils::createResourceManager(image, layer, QString()));
+
+    QVariant i;
+
+    i.setValue(preset);
+    manager->setResource(KisCanvasResourceProvider::CurrentPaintOpPreset, i);
+
+    i.setValue(recording.fgColor());
+    manager->setResource(KoCanvasResourceProvider::ForegroundColor, i);
+
+    i.setValue(recording.bgColor());
+    manager->setResource(KoCanvasResourceProvider::BackgroundColor, i);
+
+    i.setValue(recording.compositeOpId());
+    manager->setResource(KisCanvasResourceProvider::CurrentCompositeOp, i);
+
+    i.setValue(qreal(recording.opacity()) / OPACITY_OPAQUE_U8);
+    manager->setResource(KisCanvasResourceProvider::Opacity, i);
+
+    KisResourcesSnapshotSP resources =
+        new KisResourcesSnapshot(image, layer, manager.data());
+
+    QVector<KisFreehandStrokeInfo*> strokeInfos;
+    for (int j = 0; j < recording.numStrokeInfos(); j++) {
+        strokeInfos << new KisFreehandStrokeInfo();
+    }
+
+    // the seed of the per-stroke random source is taken from qrand()
+    qsrand(0);
+
+    stats->timer.start();
+
+    KisStrokeId strokeId = image->startStroke(new ReplayStrokeStrategy(resources, strokeInfos, stats));
+
+    Q_FOREACH (const KisFreehandStrokeRecording::Primitive &p, recording.primitives()) {
+        switch (p.type) {
+        case KisFreehandStrokeRecording::Primitive::Point:
+            image->addJob(strokeId, new FreehandStrokeStrategy::Data(p.strokeInfoId, p.pi1));
+            break;
+        case KisFreehandStrokeRecording::Primitive::Line:
+            image->addJob(strokeId, new FreehandStrokeStrategy::Data(p.strokeInfoId, p.pi1, p.pi2));
+            break;
+        case KisFreehandStrokeRecording::Primitive::BezierCurve:
+            image->addJob(strokeId, new FreehandStrokeStrategy::Data(p.strokeInfoId, p.pi1, p.control1, p.control2, p.pi2));
+            break;
+        }
+    }
+
+    image->addJob(strokeId, new FreehandStrokeStrategy::UpdateData(true));
+    image->endStroke(strokeId);
+    image->waitForDone();
+
+    stats->timeToCanvas = stats->timer.elapsed();
+    stats->checksum = projectionChecksum(image);
+}
+
+}
+
+void KisStrokeReplayBenchmark::testReplay_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QString>("paintOpId");
+
+    QDir dir(recordingsDir());
+    const QStringList recordings = dir.entryList(QStringList() << "*.xml", QDir::Files, QDir::Name);
+
+    if (recordings.isEmpty()) {
+        QSKIP("No stroke recordings found");
+    }
+
+    QList<KoID> paintOpIds = KisPaintOpRegistry::instance()->listKeys();
+    std::sort(paintOpIds.begin(), paintOpIds.end(),
+              [] (const KoID &lhs, const KoID &rhs) { return lhs.id() < rhs.id(); });
+
+    Q_FOREACH (const QString &recording, recordings) {
+        const QString fileName = dir.absoluteFilePath(recording);
+
+        QTest::newRow(qPrintable(QString("%1/recorded").arg(recording)))
+            << fileName << QString();
+
+        Q_FOREACH (const KoID &id, paintOpIds) {
+            // the clone brush needs a source point picked on the canvas
+            if (id.id() == "duplicate") continue;
+
+            QTest::newRow(qPrintable(QString("%1/%2").arg(recording).arg(id.id())))
+                << fileName << id.id();
+        }
+    }
+}
+
+void KisStrokeReplayBenchmark::testReplay()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QString, paintOpId);
+
+    KisFreehandStrokeRecording recording;
+    QVERIFY(recording.load(fileName));
+
+    KisPaintOpPresetSP preset = paintOpId.isEmpty() ?
+        recording.preset() :
+        KisPaintOpRegistry::instance()->defaultPreset(KoID(paintOpId, QString()));
+
+    if (!preset) {
+        QSKIP("The preset is not available");
+    }
+
+    const QString presetName = paintOpId.isEmpty() ? QString("recorded") : paintOpId;
+
+    ReplayStatistics stats;
+    replayRecording(recording, preset, &stats);
+
+    const qreal dabsPerSecond = stats.renderingTime > 0 ? 1000.0 * stats.numDabs / stats.renderingTime : 0.0;
+    const QString checksum = stats.checksum;
+
+    qDebug() << qPrintable(QString("Preset: %1 Dabs: %2 Dabs/sec: %3 Rendering: %4 (ms) Time-to-canvas: %5 (ms) Checksum: %6")
+                           .arg(presetName)
+                           .arg(stats.numDabs)
+                           .arg(dabsPerSecond, 0, 'f', 1)
+                           .arg(stats.renderingTime)
+                           .arg(stats.timeToCanvas)
+                           .arg(checksum));
+
+    if (!qgetenv("KRITA_STROKE_REPLAY_UPDATE_CHECKSUMS").isEmpty()) {
+        writeReferenceChecksum(fileName, presetName, checksum);
+        return;
+    }
+
+    const QString expectedChecksum = referenceChecksum(fileName, presetName);
+    if (!expectedChecksum.isEmpty()) {
+        QCOMPARE(checksum, expectedChecksum);
+    } else {
+        qWarning() << "No reference checksum for" << presetName << "in" << fileName + ".md5";
+
+        /**
+         * Without a reference we can at least check that the replay is
+         * deterministic, otherwise the checksum would be useless as a
+         * reference anyway
+         */
+        ReplayStatistics secondRun;
+        replayRecording(recording, preset, &secondRun);
+        QCOMPARE(secondRun.checksum, checksum);
+    }
+}
+
+QTEST_MAIN(KisStrokeReplayBenchmark)
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KISSTROKEREPLAYBENCHMARK_H
+#define KISSTROKEREPLAYBENCHMARK_H
+
+#include <QtTest>
+
+/**
+ * Replays the freehand strokes recorded with KRITA_STROKE_RECORDING_DIR
+ * against the recorded preset and the default preset of every paintop
+ * engine. Reports dabs/sec, stroke rendering time and time-to-canvas and
+ * compares the checksum of the resulting projection with the reference
+ * checksums stored in "<recording>.md5" (if present). Every line of the
+ * file is "<preset> <checksum>", where the preset is either "recorded" or
+ * the id of the paintop. Set KRITA_STROKE_REPLAY_UPDATE_CHECKSUMS to
+ * write the current checksums into the file instead of comparing them.
+ * When there is no reference checksum for a preset, the stroke is
+ * replayed twice and the two projections are compared instead.
+ *
+ * The recordings are searched in the directory set by
+ * KRITA_STROKE_RECORDING_DIR environment variable or in
+ * data/stroke_recordings by default.
+ */
+class KisStrokeReplayBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testReplay_data();
+    void testReplay();
+};
+
+#endif // KISSTROKEREPLAYBENCHMARK_H
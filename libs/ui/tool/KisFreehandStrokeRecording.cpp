@@ -0,0 +1,342 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "KisFreehandStrokeRecording.h"
+
+#include <QDomDocument>
+#include <QDomElement>
+#include <QFile>
+
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorProfile.h>
+#include <KoCompositeOpRegistry.h>
+
+#include "kis_dom_utils.h"
+#include "kis_debug.h"
+#include "kis_image.h"
+#include "kis_resources_snapshot.h"
+
+namespace {
+
+void savePaintInformation(QDomDocument &doc, QDomElement &parent, const KisPaintInformation &pi)
+{
+    QDomElement e = doc.createElement("pi");
+    pi.toXML(doc, e);
+    parent.appendChild(e);
+}
+
+void saveColor(QDomDocument &doc, QDomElement &parent, const QString &tag, const KoColor &color)
+{
+    QDomElement e = doc.createElement(tag);
+    color.toXML(doc, e);
+    parent.appendChild(e);
+}
+
+KoColor loadColor(const QDomElement &parent, const QString &tag, const KoColorSpace *cs)
+{
+    const QDomElement e = parent.firstChildElement(tag);
+    bool ok = false;
+    KoColor color = KoColor::fromXML(e.firstChildElement(), cs->colorDepthId().id(), &ok);
+    if (!ok) {
+        color = KoColor(Qt::black, cs);
+    }
+    color.convertTo(cs);
+    return color;
+}
+
+}
+
+KisFreehandStrokeRecording::KisFreehandStrokeRecording()
+    : m_colorSpace(KoColorSpaceRegistry::instance()->rgb8()),
+      m_fgColor(Qt::black, m_colorSpace),
+      m_bgColor(Qt::white, m_colorSpace),
+      m_opacity(OPACITY_OPAQUE_U8),
+      m_compositeOpId(COMPOSITE_OVER),
+      m_numStrokeInfos(1)
+{
+}
+
+void KisFreehandStrokeRecording::setCanvasState(KisResourcesSnapshot *resources, int numStrokeInfos)
+{
+    // the preset is saved on every toXML() call, which sanitizes the
+    // settings, so keep a private copy of it
+    m_preset = resources->currentPaintOpPreset()->clone();
+
+    KisImageSP image = resources->image();
+    m_imageSize = image->bounds().size();
+    m_colorSpace = image->colorSpace();
+
+    m_fgColor = resources->currentFgColor();
+    m_bgColor = resources->currentBgColor();
+    m_opacity = resources->opacity();
+    m_compositeOpId = resources->compositeOpId();
+    m_numStrokeInfos = numStrokeInfos;
+
+    m_primitives.clear();
+}
+
+void KisFreehandStrokeRecording::addPoint(int strokeInfoId, const KisPaintInformation &pi)
+{
+    Primitive p;
+    p.type = Primitive::Point;
+    p.strokeInfoId = strokeInfoId;
+    p.pi1 = pi;
+    m_primitives.append(p);
+}
+
+void KisFreehandStrokeRecording::addLine(int strokeInfoId, const KisPaintInformation &pi1, const KisPaintInformation &pi2)
+{
+    Primitive p;
+    p.type = Primitive::Line;
+    p.strokeInfoId = strokeInfoId;
+    p.pi1 = pi1;
+    p.pi2 = pi2;
+    m_primitives.append(p);
+}
+
+void KisFreehandStrokeRecording::addBezierCurve(int strokeInfoId,
+                                                const KisPaintInformation &pi1,
+                                                const QPointF &control1,
+                                                const QPointF &control2,
+                                                const KisPaintInformation &pi2)
+{
+    Primitive p;
+    p.type = Primitive::BezierCurve;
+    p.strokeInfoId = strokeInfoId;
+    p.pi1 = pi1;
+    p.pi2 = pi2;
+    p.control1 = control1;
+    p.control2 = control2;
+    m_primitives.append(p);
+}
+
+KisPaintOpPresetSP KisFreehandStrokeRecording::preset() const
+{
+    return m_preset;
+}
+
+void KisFreehandStrokeRecording::setPreset(KisPaintOpPresetSP preset)
+{
+    m_preset = preset;
+}
+
+QSize KisFreehandStrokeRecording::imageSize() const
+{
+    return m_imageSize;
+}
+
+const KoColorSpace *KisFreehandStrokeRecording::colorSpace() const
+{
+    return m_colorSpace;
+}
+
+KoColor KisFreehandStrokeRecording::fgColor() const
+{
+    return m_fgColor;
+}
+
+KoColor KisFreehandStrokeRecording::bgColor() const
+{
+    return m_bgColor;
+}
+
+quint8 KisFreehandStrokeRecording::opacity() const
+{
+    return m_opacity;
+}
+
+QString KisFreehandStrokeRecording::compositeOpId() const
+{
+    return m_compositeOpId;
+}
+
+int KisFreehandStrokeRecording::numStrokeInfos() const
+{
+    return m_numStrokeInfos;
+}
+
+const QVector<KisFreehandStrokeRecording::Primitive> &KisFreehandStrokeRecording::primitives() const
+{
+    return m_primitives;
+}
+
+void KisFreehandStrokeRecording::toXML(QDomDocument &doc, QDomElement &root) const
+{
+    root.setAttribute("version", "1");
+    root.setAttribute("width", KisDomUtils::toString(m_imageSize.width()));
+    root.setAttribute("height", KisDomUtils::toString(m_imageSize.height()));
+    root.setAttribute("colorModelId", m_colorSpace->colorModelId().id());
+    root.setAttribute("colorDepthId", m_colorSpace->colorDepthId().id());
+    root.setAttribute("profile", m_colorSpace->profile() ? m_colorSpace->profile()->name() : QString());
+    root.setAttribute("opacity", KisDomUtils::toString(m_opacity));
+    root.setAttribute("compositeOp", m_compositeOpId);
+    root.setAttribute("numStrokeInfos", KisDomUtils::toString(m_numStrokeInfos));
+
+    saveColor(doc, root, "fgColor", m_fgColor);
+    saveColor(doc, root, "bgColor", m_bgColor);
+
+    if (m_preset) {
+        QDomElement presetElt = doc.createElement("preset");
+        m_preset->toXML(doc, presetElt);
+        root.appendChild(presetElt);
+    }
+
+    QDomElement primitivesElt = doc.createElement("primitives");
+
+    Q_FOREACH (const Primitive &p, m_primitives) {
+        QDomElement e;
+
+        switch (p.type) {
+        case Primitive::Point:
+            e = doc.createElement("point");
+            savePaintInformation(doc, e, p.pi1);
+            break;
+        case Primitive::Line:
+            e = doc.createElement("line");
+            savePaintInformation(doc, e, p.pi1);
+            savePaintInformation(doc, e, p.pi2);
+            break;
+        case Primitive::BezierCurve:
+            e = doc.createElement("bezier");
+            savePaintInformation(doc, e, p.pi1);
+            savePaintInformation(doc, e, p.pi2);
+            KisDomUtils::saveValue(&e, "control1", p.control1);
+            KisDomUtils::saveValue(&e, "control2", p.control2);
+            break;
+        }
+
+        e.setAttribute("strokeInfoId", KisDomUtils::toString(p.strokeInfoId));
+        primitivesElt.appendChild(e);
+    }
+
+    root.appendChild(primitivesElt);
+}
+
+bool KisFreehandStrokeRecording::fromXML(const QDomElement &root)
+{
+    if (root.attribute("version") != "1") {
+        warnKrita << "Unsupported freehand stroke recording version" << root.attribute("version");
+        return false;
+    }
+
+    m_imageSize = QSize(KisDomUtils::toInt(root.attribute("width")),
+                        KisDomUtils::toInt(root.attribute("height")));
+
+    m_colorSpace = KoColorSpaceRegistry::instance()->colorSpace(root.attribute("colorModelId"),
+                                                                root.attribute("colorDepthId"),
+                                                                root.attribute("profile"));
+    if (!m_colorSpace) {
+        warnKrita << "Unknown color space of the freehand stroke recording, falling back to sRGB";
+        m_colorSpace = KoColorSpaceRegistry::instance()->rgb8();
+    }
+
+    m_opacity = KisDomUtils::toInt(root.attribute("opacity", "255"));
+    m_compositeOpId = root.attribute("compositeOp", COMPOSITE_OVER);
+    m_numStrokeInfos = qMax(1, KisDomUtils::toInt(root.attribute("numStrokeInfos", "1")));
+
+    m_fgColor = loadColor(root, "fgColor", m_colorSpace);
+    m_bgColor = loadColor(root, "bgColor", m_colorSpace);
+
+    m_preset.clear();
+
+    const QDomElement presetElt = root.firstChildElement("preset");
+    if (!presetElt.isNull()) {
+        KisPaintOpPresetSP preset = new KisPaintOpPreset();
+        preset->fromXML(presetElt);
+
+        if (!preset->settings()) {
+            warnKrita << "Failed to load the preset of the freehand stroke recording";
+            return false;
+        }
+
+        preset->setValid(true);
+        m_preset = preset;
+    }
+
+    m_primitives.clear();
+
+    QDomElement e = root.firstChildElement("primitives").firstChildElement();
+    for (; !e.isNull(); e = e.nextSiblingElement()) {
+        Primitive p;
+        p.strokeInfoId = KisDomUtils::toInt(e.attribute("strokeInfoId", "0"));
+
+        if (p.strokeInfoId < 0 || p.strokeInfoId >= m_numStrokeInfos) {
+            warnKrita << "Invalid stroke info id in the freehand stroke recording" << p.strokeInfoId;
+            return false;
+        }
+
+        const QDomElement piElt1 = e.firstChildElement("pi");
+        const QDomElement piElt2 = piElt1.nextSiblingElement("pi");
+
+        p.pi1 = KisPaintInformation::fromXML(piElt1);
+
+        if (e.tagName() == "point") {
+            p.type = Primitive::Point;
+        } else if (e.tagName() == "line") {
+            p.type = Primitive::Line;
+            p.pi2 = KisPaintInformation::fromXML(piElt2);
+        } else if (e.tagName() == "bezier") {
+            p.type = Primitive::BezierCurve;
+            p.pi2 = KisPaintInformation::fromXML(piElt2);
+            KisDomUtils::loadValue(e, "control1", &p.control1);
+            KisDomUtils::loadValue(e, "control2", &p.control2);
+        } else {
+            warnKrita << "Unknown primitive in the freehand stroke recording" << e.tagName();
+            return false;
+        }
+
+        m_primitives.append(p);
+    }
+
+    return true;
+}
+
+bool KisFreehandStrokeRecording::save(const QString &fileName) const
+{
+    QDomDocument doc("freehand-stroke");
+    QDomElement root = doc.createElement("freehandStroke");
+    doc.appendChild(root);
+    toXML(doc, root);
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        warnKrita << "Failed to open the freehand stroke recording for writing" << fileName;
+        return false;
+    }
+
+    file.write(doc.toByteArray());
+    return true;
+}
+
+bool KisFreehandStrokeRecording::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        warnKrita << "Failed to open the freehand stroke recording" << fileName;
+        return false;
+    }
+
+    QDomDocument doc;
+    if (!doc.setContent(&file)) {
+        warnKrita << "Failed to parse the freehand stroke recording" << fileName;
+        return false;
+    }
+
+    return fromXML(doc.documentElement());
+}
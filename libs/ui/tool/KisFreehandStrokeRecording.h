@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KISFREEHANDSTROKERECORDING_H
+#define KISFREEHANDSTROKERECORDING_H
+
+#include "kritaui_export.h"
+
+#include <QVector>
+#include <QSize>
+#include <QPointF>
+
+#include <KoColor.h>
+#include <brushengine/kis_paint_information.h>
+#include <brushengine/kis_paintop_preset.h>
+
+class QDomDocument;
+class QDomElement;
+class KisResourcesSnapshot;
+
+
+/**
+ * A serializable record of a single freehand stroke: the preset, the
+ * canvas state the stroke was started with and the stream of painting
+ * primitives (already smoothed by KisToolFreehandHelper) that were sent
+ * to FreehandStrokeStrategy.
+ *
+ * The recording can be replayed headlessly by feeding the primitives
+ * into a new FreehandStrokeStrategy. Together with the deterministic
+ * random sources of the strategy it makes the result of the replay
+ * reproducible.
+ *
+ * KisToolFreehandHelper records the strokes into the directory set by
+ * KRITA_STROKE_RECORDING_DIR environment variable.
+ */
+class KRITAUI_EXPORT KisFreehandStrokeRecording
+{
+public:
+    struct Primitive {
+        enum Type {
+            Point,
+            Line,
+            BezierCurve
+        };
+
+        Type type = Point;
+        int strokeInfoId = 0;
+        KisPaintInformation pi1;
+        KisPaintInformation pi2;
+        QPointF control1;
+        QPointF control2;
+    };
+
+public:
+    KisFreehandStrokeRecording();
+
+    /**
+     * Fetches the preset, colors, opacity, composite op and the
+     * image properties from \p resources
+     */
+    void setCanvasState(KisResourcesSnapshot *resources, int numStrokeInfos);
+
+    void addPoint(int strokeInfoId, const KisPaintInformation &pi);
+    void addLine(int strokeInfoId, const KisPaintInformation &pi1, const KisPaintInformation &pi2);
+    void addBezierCurve(int strokeInfoId,
+                        const KisPaintInformation &pi1,
+                        const QPointF &control1,
+                        const QPointF &control2,
+                        const KisPaintInformation &pi2);
+
+    KisPaintOpPresetSP preset() const;
+    void setPreset(KisPaintOpPresetSP preset);
+
+    QSize imageSize() const;
+    const KoColorSpace* colorSpace() const;
+    KoColor fgColor() const;
+    KoColor bgColor() const;
+    quint8 opacity() const;
+    QString compositeOpId() const;
+    int numStrokeInfos() const;
+
+    const QVector<Primitive>& primitives() const;
+
+    void toXML(QDomDocument &doc, QDomElement &root) const;
+    bool fromXML(const QDomElement &root);
+
+    bool save(const QString &fileName) const;
+    bool load(const QString &fileName);
+
+private:
+    KisPaintOpPresetSP m_preset;
+    QSize m_imageSize;
+    const KoColorSpace *m_colorSpace;
+    KoColor m_fgColor;
+    KoColor m_bgColor;
+    quint8 m_opacity;
+    QString m_compositeOpId;
+    int m_numStrokeInfos;
+
+    QVector<Primitive> m_primitives;
+};
+
+#endif // KISFREEHANDSTROKERECORDING_H
@@ -20,6 +20,8 @@
 
 #include <QTimer>
 #include <QQueue>
+#include <QDir>
+#include <QDateTime>
 
 #include <klocalizedstring.h>
 
@@ -44,6 +46,7 @@
 
 #include "strokes/freehand_stroke.h"
 #include "strokes/KisFreehandStrokeInfo.h"
+#include "KisFreehandStrokeRecording.h"
 
 #include <math.h>
 
@@ -114,7 +117,12 @@ struct KisToolFreehandHelper::Private
     int canvasRotation;
     bool canvasMirroredH;
 
+    // Records the primitives of the current stroke when
+    // KRITA_STROKE_RECORDING_DIR is set
+    QScopedPointer<KisFreehandStrokeRecording> recording;
+
     qreal effectiveSmoothnessDistance() const;
+    void saveRecording();
 };
 
 
@@ -312,6 +320,11 @@ void KisToolFreehandHelper::initPaintImpl(qreal startAngle,
 
     m_d->strokeId = m_d->strokesFacade->startStroke(stroke);
 
+    if (qEnvironmentVariableIsSet("KRITA_STROKE_RECORDING_DIR")) {
+        m_d->recording.reset(new KisFreehandStrokeRecording());
+        m_d->recording->setCanvasState(m_d->resources.data(), m_d->strokeInfos.size());
+    }
+
     m_d->history.clear();
     m_d->distanceHistory.clear();
 
@@ -435,6 +448,18 @@ qreal KisToolFreehandHelper::Private::effectiveSmoothnessDistance() const
     return effectiveSmoothnessDistance;
 }
 
+void KisToolFreehandHelper::Private::saveRecording()
+{
+    if (!recording) return;
+
+    const QDir dir(QString::fromLocal8Bit(qgetenv("KRITA_STROKE_RECORDING_DIR")));
+    const QString fileName =
+        QString("stroke_%1.xml").arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss-zzz"));
+
+    recording->save(dir.absoluteFilePath(fileName));
+    recording.reset();
+}
+
 void KisToolFreehandHelper::paintEvent(KoPointerEvent *event)
 {
     KisPaintInformation info =
@@ -645,6 +670,8 @@ void KisToolFreehandHelper::endPaint()
 
     m_d->strokesFacade->endStroke(m_d->strokeId);
     m_d->strokeId.clear();
+
+    m_d->saveRecording();
 }
 
 void KisToolFreehandHelper::cancelPaint()
@@ -675,6 +702,7 @@ void KisToolFreehandHelper::cancelPaint()
     m_d->strokesFacade->cancelStroke(m_d->strokeId);
     m_d->strokeId.clear();
 
+    m_d->recording.reset();
 }
 
 int KisToolFreehandHelper::elapsedStrokeTime() const
@@ -909,6 +937,10 @@ void KisToolFreehandHelper::paintAt(int strokeInfoId,
     m_d->strokesFacade->addJob(m_d->strokeId,
                                new FreehandStrokeStrategy::Data(strokeInfoId, pi));
 
+    if (m_d->recording) {
+        m_d->recording->addPoint(strokeInfoId, pi);
+    }
+
 }
 
 void KisToolFreehandHelper::paintLine(int strokeInfoId,
@@ -919,6 +951,10 @@ void KisToolFreehandHelper::paintLine(int strokeInfoId,
     m_d->strokesFacade->addJob(m_d->strokeId,
                                new FreehandStrokeStrategy::Data(strokeInfoId, pi1, pi2));
 
+    if (m_d->recording) {
+        m_d->recording->addLine(strokeInfoId, pi1, pi2);
+    }
+
 }
 
 void KisToolFreehandHelper::paintBezierCurve(int strokeInfoId,
@@ -956,6 +992,10 @@ void KisToolFreehandHelper::paintBezierCurve(int strokeInfoId,
                                new FreehandStrokeStrategy::Data(strokeInfoId,
                                                                 pi1, control1, control2, pi2));
 
+    if (m_d->recording) {
+        m_d->recording->addBezierCurve(strokeInfoId, pi1, control1, control2, pi2);
+    }
+
 }
 
 void KisToolFreehandHelper::createPainters(QVector<KisFreehandStrokeInfo*> &strokeInfos,
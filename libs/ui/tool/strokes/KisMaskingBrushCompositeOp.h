@@ -41,24 +41,38 @@ public:
 
         using MaskPixel = KoGrayU8Traits::Pixel;
 
+        /**
+         * The row is processed in two passes: first the mask values are
+         * calculated into a contiguous chunk buffer (the loop has no
+         * stride dependency on the destination, so the compiler can
+         * vectorize it), then the result is applied to the strided alpha
+         * channel of the destination.
+         */
+        const int chunkSize = 256;
+        channels_type maskChunk[chunkSize];
+
         dstRowStart += m_dstAlphaOffset;
 
         for (int y = 0; y < rows; y++) {
-            const quint8 *srcPtr = srcRowStart;
+            const MaskPixel *srcPtr = reinterpret_cast<const MaskPixel*>(srcRowStart);
             quint8 *dstPtr = dstRowStart;
 
-            for (int x = 0; x < columns; x++) {
+            for (int chunkStart = 0; chunkStart < columns; chunkStart += chunkSize) {
+                const int chunkColumns = qMin(chunkSize, columns - chunkStart);
 
-                const MaskPixel *srcDataPtr = reinterpret_cast<const MaskPixel*>(srcPtr);
+                for (int x = 0; x < chunkColumns; x++) {
+                    const quint8 mask = KoColorSpaceMaths<quint8>::multiply(srcPtr[x].gray, srcPtr[x].alpha);
+                    maskChunk[x] = KoColorSpaceMaths<quint8, channels_type>::scaleToA(mask);
+                }
 
-                const quint8 mask = KoColorSpaceMaths<quint8>::multiply(srcDataPtr->gray, srcDataPtr->alpha);
-                const channels_type maskScaled = KoColorSpaceMaths<quint8, channels_type>::scaleToA(mask);
+                for (int x = 0; x < chunkColumns; x++) {
+                    channels_type *dstDataPtr = reinterpret_cast<channels_type*>(dstPtr);
+                    *dstDataPtr = compositeFunc(maskChunk[x], *dstDataPtr);
 
-                channels_type *dstDataPtr = reinterpret_cast<channels_type*>(dstPtr);
-                *dstDataPtr = compositeFunc(maskScaled, *dstDataPtr);
+                    dstPtr += m_dstPixelSize;
+                }
 
-                srcPtr += sizeof(MaskPixel);
-                dstPtr += m_dstPixelSize;
+                srcPtr += chunkColumns;
             }
 
             srcRowStart += srcRowStride;
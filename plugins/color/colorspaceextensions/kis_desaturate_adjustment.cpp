@@ -29,17 +29,12 @@
 #include <KoColorSpace.h>
 #include <KoColorSpaceTraits.h>
 #include <KoColorTransformation.h>
+#include <KoDesaturateKernel.h>
 #include <KoID.h>
 
-#define SCALE_TO_FLOAT( v ) KoColorSpaceMaths< _channel_type_, float>::scaleToA( v )
-#define SCALE_FROM_FLOAT( v  ) KoColorSpaceMaths< float, _channel_type_>::scaleToA( v )
-
 template<typename _channel_type_,typename traits>
 class KisDesaturateAdjustment : public KoColorTransformation
 {
-    typedef traits RGBTrait;
-    typedef typename RGBTrait::Pixel RGBPixel;
-
 public:
     KisDesaturateAdjustment()
     {
@@ -49,63 +44,10 @@ public:
 
     void transform(const quint8 *srcU8, quint8 *dstU8, qint32 nPixels) const override
     {
-        const RGBPixel* src = reinterpret_cast<const RGBPixel*>(srcU8);
-        RGBPixel* dst = reinterpret_cast<RGBPixel*>(dstU8);
-        float r, g, b, gray;
-        while (nPixels > 0) {
-
-            r = SCALE_TO_FLOAT(src->red);
-            g = SCALE_TO_FLOAT(src->green);
-            b = SCALE_TO_FLOAT(src->blue);
-
-            // http://www.tannerhelland.com/3643/grayscale-image-algorithm-vb6/
-            switch(m_type) {
-            case 0: // lightness
-            {
-                gray = (qMax(qMax(r, g), b) + qMin(qMin(r, g), b)) / 2;
-                break;
-            }
-            case 1: // luminosity BT 709
-            {
-                gray = r * 0.2126 + g * 0.7152 + b * 0.0722;
-                break;
-
-            }
-
-            case 2: // luminosity BT 601
-            {
-                gray = r * 0.299 + g * 0.587 + b * 0.114;
-                break;
-
-            }
-            case 3: // average
-            {
-                gray = (r + g + b) / 3;
-                break;
-            }
-            case 4: // min
-            {
-                gray = qMin(qMin(r, g), b);
-                break;
-            }
-            case 5: // min
-            {
-                gray = qMax(qMax(r, g), b);
-                break;
-            }
-
-            default:
-                gray = 0;
-            }
-            dst->red = SCALE_FROM_FLOAT(gray);
-            dst->green = SCALE_FROM_FLOAT(gray);
-            dst->blue = SCALE_FROM_FLOAT(gray);
-            dst->alpha = src->alpha;
-
-            --nPixels;
-            ++src;
-            ++dst;
-        }
+        KoDesaturateKernel<traits>::desaturatePixels(m_type,
+                                                     reinterpret_cast<const _channel_type_*>(srcU8),
+                                                     reinterpret_cast<_channel_type_*>(dstU8),
+                                                     nPixels);
     }
 
     QList<QString> parameters() const override
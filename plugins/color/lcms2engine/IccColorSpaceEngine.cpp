@@ -25,6 +25,7 @@
 #include <klocalizedstring.h>
 
 #include "LcmsColorSpace.h"
+#include "LcmsFastPathColorConversionTransformation.h"
 
 // -- KoLcmsColorConversionTransformation --
 
@@ -254,6 +255,13 @@ KoColorConversionTransformation *IccColorSpaceEngine::createColorTransformation(
     Q_ASSERT(srcColorSpace);
     Q_ASSERT(dstColorSpace);
 
+    KoColorConversionTransformation *fastPathTransformation =
+        createLcmsFastPathTransformation(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags);
+
+    if (fastPathTransformation) {
+        return fastPathTransformation;
+    }
+
     return new KoLcmsColorConversionTransformation(
                 srcColorSpace, computeColorSpaceType(srcColorSpace),
                 dynamic_cast<const IccColorProfile *>(srcColorSpace->profile())->asLcms(), dstColorSpace, computeColorSpaceType(dstColorSpace),
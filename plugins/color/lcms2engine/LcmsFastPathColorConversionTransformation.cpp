@@ -0,0 +1,277 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "LcmsFastPathColorConversionTransformation.h"
+
+#include <QScopedPointer>
+#include <QVector>
+
+#include <KoConfig.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceMaths.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorSpaceTraits.h>
+#include <compositeops/KoOptimizedPixelDataScaler.h>
+#include <compositeops/KoOptimizedPixelDataScalerFactory.h>
+
+#include "colorprofiles/IccColorProfile.h"
+#include "colorprofiles/LcmsColorProfileContainer.h"
+
+#include <kis_assert.h>
+
+namespace {
+
+class LcmsScaleColorConversionTransformation : public KoColorConversionTransformation
+{
+public:
+    LcmsScaleColorConversionTransformation(const KoColorSpace *srcCs,
+                                           const KoColorSpace *dstCs,
+                                           Intent renderingIntent,
+                                           ConversionFlags conversionFlags,
+                                           KoOptimizedPixelDataScaler *scaler)
+        : KoColorConversionTransformation(srcCs, dstCs, renderingIntent, conversionFlags),
+          m_scaler(scaler)
+    {
+    }
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override {
+        m_scaler->convert(src, dst, nPixels);
+    }
+
+private:
+    QScopedPointer<KoOptimizedPixelDataScaler> m_scaler;
+};
+
+/**
+ * Converts integer RGB pixels into a color space with the same primaries
+ * and a different transfer function. Every possible source channel value is
+ * precomputed, so the conversion itself is just three table lookups per
+ * pixel.
+ */
+template <class SrcCSTraits, class DstCSTraits>
+class LcmsToneCurveLutTransformation : public KoColorConversionTransformation
+{
+    typedef typename SrcCSTraits::channels_type src_channel_type;
+    typedef typename DstCSTraits::channels_type dst_channel_type;
+    typedef QVector<dst_channel_type> Lut;
+
+public:
+    LcmsToneCurveLutTransformation(const KoColorSpace *srcCs,
+                                   const KoColorSpace *dstCs,
+                                   Intent renderingIntent,
+                                   ConversionFlags conversionFlags,
+                                   cmsToneCurve * const *srcCurves,
+                                   cmsToneCurve * const *dstCurves)
+        : KoColorConversionTransformation(srcCs, dstCs, renderingIntent, conversionFlags)
+    {
+        for (int i = 0; i < 3; i++) {
+            // profiles usually share the same curve for all the channels
+            if (i > 0 && srcCurves[i] == srcCurves[i - 1] && dstCurves[i] == dstCurves[i - 1]) {
+                m_luts[i] = m_luts[i - 1];
+            } else {
+                m_luts[i] = buildLut(srcCurves[i], dstCurves[i]);
+            }
+        }
+    }
+
+    void transform(const quint8 *src, quint8 *dst, qint32 nPixels) const override {
+        const typename SrcCSTraits::Pixel *srcPixel = reinterpret_cast<const typename SrcCSTraits::Pixel*>(src);
+        typename DstCSTraits::Pixel *dstPixel = reinterpret_cast<typename DstCSTraits::Pixel*>(dst);
+
+        const dst_channel_type *redLut = m_luts[0].constData();
+        const dst_channel_type *greenLut = m_luts[1].constData();
+        const dst_channel_type *blueLut = m_luts[2].constData();
+
+        for (int i = 0; i < nPixels; i++) {
+            dstPixel->red = redLut[srcPixel->red];
+            dstPixel->green = greenLut[srcPixel->green];
+            dstPixel->blue = blueLut[srcPixel->blue];
+            dstPixel->alpha =
+                KoColorSpaceMaths<src_channel_type, dst_channel_type>::scaleToA(srcPixel->alpha);
+
+            srcPixel++;
+            dstPixel++;
+        }
+    }
+
+private:
+    static Lut buildLut(cmsToneCurve *srcCurve, cmsToneCurve *dstCurve) {
+        const int size = int(KoColorSpaceMathsTraits<src_channel_type>::max) + 1;
+        Lut lut(size);
+
+        cmsToneCurve *dstReverseCurve = cmsReverseToneCurve(dstCurve);
+        KIS_SAFE_ASSERT_RECOVER_NOOP(dstReverseCurve);
+
+        for (int i = 0; i < size; i++) {
+            const float value = KoColorSpaceMaths<src_channel_type, float>::scaleToA(src_channel_type(i));
+            float result = cmsEvalToneCurveFloat(srcCurve, value);
+
+            if (dstReverseCurve) {
+                result = cmsEvalToneCurveFloat(dstReverseCurve, result);
+            }
+
+            lut[i] = KoColorSpaceMaths<float, dst_channel_type>::scaleToA(result);
+        }
+
+        if (dstReverseCurve) {
+            cmsFreeToneCurve(dstReverseCurve);
+        }
+
+        return lut;
+    }
+
+private:
+    Lut m_luts[3];
+};
+
+template <class SrcCSTraits>
+KoColorConversionTransformation* createToneCurveLutTransformation(const KoColorSpace *srcColorSpace,
+                                                                  const KoColorSpace *dstColorSpace,
+                                                                  KoColorConversionTransformation::Intent renderingIntent,
+                                                                  KoColorConversionTransformation::ConversionFlags conversionFlags,
+                                                                  cmsToneCurve * const *srcCurves,
+                                                                  cmsToneCurve * const *dstCurves)
+{
+    const KoID dstDepth = dstColorSpace->colorDepthId();
+
+    if (dstDepth == Integer8BitsColorDepthID) {
+        return new LcmsToneCurveLutTransformation<SrcCSTraits, KoBgrU8Traits>(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags, srcCurves, dstCurves);
+    } else if (dstDepth == Integer16BitsColorDepthID) {
+        return new LcmsToneCurveLutTransformation<SrcCSTraits, KoBgrU16Traits>(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags, srcCurves, dstCurves);
+#ifdef HAVE_OPENEXR
+    } else if (dstDepth == Float16BitsColorDepthID) {
+        return new LcmsToneCurveLutTransformation<SrcCSTraits, KoRgbF16Traits>(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags, srcCurves, dstCurves);
+#endif
+    } else if (dstDepth == Float32BitsColorDepthID) {
+        return new LcmsToneCurveLutTransformation<SrcCSTraits, KoRgbF32Traits>(srcColorSpace, dstColorSpace, renderingIntent, conversionFlags, srcCurves, dstCurves);
+    }
+
+    return 0;
+}
+
+bool fuzzyCompareVectors(const QVector<double> &a, const QVector<double> &b)
+{
+    if (a.size() != b.size()) return false;
+
+    for (int i = 0; i < a.size(); i++) {
+        if (qAbs(a[i] - b[i]) > 1e-4) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Reads the RGB tone curves of a matrix-shaper profile that is going to be
+ * used for the specified intent. If the profile contains a CLUT for this
+ * intent, lcms would use it instead of the matrix, so we cannot bypass it.
+ */
+bool fetchMatrixShaperCurves(LcmsColorProfileContainer *profile,
+                             KoColorConversionTransformation::Intent renderingIntent,
+                             int direction,
+                             cmsToneCurve **curves)
+{
+    cmsHPROFILE lcmsProfile = profile->lcmsProfile();
+
+    if (!cmsIsMatrixShaper(lcmsProfile) ||
+        cmsIsCLUT(lcmsProfile, renderingIntent, direction) ||
+        !profile->hasColorants()) {
+
+        return false;
+    }
+
+    curves[0] = static_cast<cmsToneCurve*>(cmsReadTag(lcmsProfile, cmsSigRedTRCTag));
+    curves[1] = static_cast<cmsToneCurve*>(cmsReadTag(lcmsProfile, cmsSigGreenTRCTag));
+    curves[2] = static_cast<cmsToneCurve*>(cmsReadTag(lcmsProfile, cmsSigBlueTRCTag));
+
+    return curves[0] && curves[1] && curves[2];
+}
+
+bool isIntegerDepth(const KoID &depth)
+{
+    return depth == Integer8BitsColorDepthID || depth == Integer16BitsColorDepthID;
+}
+
+}
+
+KoColorConversionTransformation* createLcmsFastPathTransformation(const KoColorSpace *srcColorSpace,
+                                                                  const KoColorSpace *dstColorSpace,
+                                                                  KoColorConversionTransformation::Intent renderingIntent,
+                                                                  KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    if (conversionFlags.testFlag(KoColorConversionTransformation::NoOptimization)) return 0;
+
+    const KoID modelId = srcColorSpace->colorModelId();
+    if (modelId != dstColorSpace->colorModelId()) return 0;
+    if (modelId != RGBAColorModelID && modelId != GrayAColorModelID) return 0;
+
+    const IccColorProfile *srcProfile = dynamic_cast<const IccColorProfile*>(srcColorSpace->profile());
+    const IccColorProfile *dstProfile = dynamic_cast<const IccColorProfile*>(dstColorSpace->profile());
+    if (!srcProfile || !dstProfile) return 0;
+
+    const KoID srcDepth = srcColorSpace->colorDepthId();
+    const KoID dstDepth = dstColorSpace->colorDepthId();
+
+    if (*srcProfile == *dstProfile) {
+        if (srcDepth == dstDepth) return 0;
+
+        // integer RGB color spaces are BGRA, floating point ones are RGBA
+        const bool swapRedBlue =
+            modelId == RGBAColorModelID && isIntegerDepth(srcDepth) != isIntegerDepth(dstDepth);
+
+        KoOptimizedPixelDataScaler *scaler =
+            KoOptimizedPixelDataScalerFactory::createScaler(srcDepth.id(), dstDepth.id(),
+                                                            srcColorSpace->channelCount(),
+                                                            swapRedBlue);
+        if (!scaler) return 0;
+
+        return new LcmsScaleColorConversionTransformation(srcColorSpace, dstColorSpace,
+                                                          renderingIntent, conversionFlags,
+                                                          scaler);
+    }
+
+    if (modelId != RGBAColorModelID || !isIntegerDepth(srcDepth)) return 0;
+
+    LcmsColorProfileContainer *srcLcmsProfile = srcProfile->asLcms();
+    LcmsColorProfileContainer *dstLcmsProfile = dstProfile->asLcms();
+
+    cmsToneCurve *srcCurves[3];
+    cmsToneCurve *dstCurves[3];
+
+    if (!fetchMatrixShaperCurves(srcLcmsProfile, renderingIntent, LCMS_USED_AS_INPUT, srcCurves) ||
+        !fetchMatrixShaperCurves(dstLcmsProfile, renderingIntent, LCMS_USED_AS_OUTPUT, dstCurves)) {
+
+        return 0;
+    }
+
+    if (!fuzzyCompareVectors(srcLcmsProfile->getColorantsXYZ(), dstLcmsProfile->getColorantsXYZ()) ||
+        !fuzzyCompareVectors(srcLcmsProfile->getWhitePointXYZ(), dstLcmsProfile->getWhitePointXYZ())) {
+
+        return 0;
+    }
+
+    if (srcDepth == Integer8BitsColorDepthID) {
+        return createToneCurveLutTransformation<KoBgrU8Traits>(srcColorSpace, dstColorSpace,
+                                                               renderingIntent, conversionFlags,
+                                                               srcCurves, dstCurves);
+    } else {
+        return createToneCurveLutTransformation<KoBgrU16Traits>(srcColorSpace, dstColorSpace,
+                                                                renderingIntent, conversionFlags,
+                                                                srcCurves, dstCurves);
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef LCMSFASTPATHCOLORCONVERSIONTRANSFORMATION_H
+#define LCMSFASTPATHCOLORCONVERSIONTRANSFORMATION_H
+
+#include <KoColorConversionTransformation.h>
+
+/**
+ * Creates a transformation that bypasses lcms for the conversions that
+ * need no real color management:
+ *
+ * 1) The same RGB or gray profile in a different bit depth. The data is
+ *    just rescaled with a (vectorized) KoOptimizedPixelDataScaler.
+ *
+ * 2) Two matrix-shaper RGB profiles with the same colorants and white point,
+ *    but different tone curves, e.g. sRGB <-> linear sRGB. When the source is
+ *    an integer color space, the conversion is done with a per-channel lookup
+ *    table built from the profiles' transfer curves.
+ *
+ * @return a new transformation or null if the fast path is not applicable
+ *         and the conversion should be done by lcms
+ */
+KoColorConversionTransformation* createLcmsFastPathTransformation(const KoColorSpace *srcColorSpace,
+                                                                  const KoColorSpace *dstColorSpace,
+                                                                  KoColorConversionTransformation::Intent renderingIntent,
+                                                                  KoColorConversionTransformation::ConversionFlags conversionFlags);
+
+#endif // LCMSFASTPATHCOLORCONVERSIONTRANSFORMATION_H
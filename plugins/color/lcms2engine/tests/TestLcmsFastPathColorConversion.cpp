@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "TestLcmsFastPathColorConversion.h"
+
+#include <QTest>
+#include "sdk/tests/kistest.h"
+
+#include "kis_debug.h"
+
+#include "KoColorProfile.h"
+#include "KoColorSpace.h"
+#include "KoColorSpaceRegistry.h"
+#include "KoColorModelStandardIds.h"
+#include "KoColorConversionTransformation.h"
+
+namespace {
+
+/**
+ * Converts a random set of pixels with both, the fast path and the real
+ * lcms transformation, and compares the normalized results. The fast path
+ * is disabled by NoOptimization flag.
+ */
+void compareWithLcms(const KoColorSpace *srcCS, const KoColorSpace *dstCS, float tolerance)
+{
+    const int numPixels = 1027;
+
+    QByteArray src(numPixels * srcCS->pixelSize(), 0);
+    QByteArray fastPathDst(numPixels * dstCS->pixelSize(), 0);
+    QByteArray lcmsDst(numPixels * dstCS->pixelSize(), 0);
+
+    QVector<float> channels(srcCS->channelCount());
+    for (int i = 0; i < numPixels; i++) {
+        for (int j = 0; j < channels.size(); j++) {
+            channels[j] = float(qrand()) / RAND_MAX;
+        }
+        srcCS->fromNormalisedChannelsValue(reinterpret_cast<quint8*>(src.data()) + i * srcCS->pixelSize(), channels);
+    }
+
+    const KoColorConversionTransformation::Intent intent =
+        KoColorConversionTransformation::internalRenderingIntent();
+
+    srcCS->convertPixelsTo(reinterpret_cast<const quint8*>(src.constData()),
+                           reinterpret_cast<quint8*>(fastPathDst.data()),
+                           dstCS, numPixels, intent,
+                           KoColorConversionTransformation::internalConversionFlags());
+
+    srcCS->convertPixelsTo(reinterpret_cast<const quint8*>(src.constData()),
+                           reinterpret_cast<quint8*>(lcmsDst.data()),
+                           dstCS, numPixels, intent,
+                           KoColorConversionTransformation::internalConversionFlags() |
+                           KoColorConversionTransformation::NoOptimization);
+
+    QVector<float> fastPathChannels(dstCS->channelCount());
+    QVector<float> lcmsChannels(dstCS->channelCount());
+
+    for (int i = 0; i < numPixels; i++) {
+        dstCS->normalisedChannelsValue(reinterpret_cast<const quint8*>(fastPathDst.constData()) + i * dstCS->pixelSize(), fastPathChannels);
+        dstCS->normalisedChannelsValue(reinterpret_cast<const quint8*>(lcmsDst.constData()) + i * dstCS->pixelSize(), lcmsChannels);
+
+        for (int j = 0; j < fastPathChannels.size(); j++) {
+            if (qAbs(fastPathChannels[j] - lcmsChannels[j]) > tolerance) {
+                qDebug() << "Pixel" << i << "channel" << j
+                         << "fast path" << fastPathChannels[j]
+                         << "lcms" << lcmsChannels[j];
+                QFAIL("Fast path result differs from lcms");
+            }
+        }
+    }
+}
+
+const KoColorSpace* rgbColorSpace(const QString &depthId, const KoColorProfile *profile)
+{
+    return KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), depthId, profile);
+}
+
+}
+
+void TestLcmsFastPathColorConversion::testSameProfileScaling_data()
+{
+    QTest::addColumn<QString>("srcDepthId");
+    QTest::addColumn<QString>("dstDepthId");
+
+    QStringList depths;
+    depths << Integer8BitsColorDepthID.id();
+    depths << Integer16BitsColorDepthID.id();
+#ifdef HAVE_OPENEXR
+    depths << Float16BitsColorDepthID.id();
+#endif
+    depths << Float32BitsColorDepthID.id();
+
+    Q_FOREACH (const QString &src, depths) {
+        Q_FOREACH (const QString &dst, depths) {
+            if (src == dst) continue;
+            QTest::newRow(QString("%1-%2").arg(src).arg(dst).toLatin1()) << src << dst;
+        }
+    }
+}
+
+void TestLcmsFastPathColorConversion::testSameProfileScaling()
+{
+    QFETCH(QString, srcDepthId);
+    QFETCH(QString, dstDepthId);
+
+    const KoColorProfile *profile = KoColorSpaceRegistry::instance()->p709SRGBProfile();
+
+    const bool hasInteger =
+        srcDepthId == Integer8BitsColorDepthID.id() ||
+        dstDepthId == Integer8BitsColorDepthID.id();
+
+    compareWithLcms(rgbColorSpace(srcDepthId, profile),
+                    rgbColorSpace(dstDepthId, profile),
+                    hasInteger ? 1.01 / 255 : 0.001);
+}
+
+void TestLcmsFastPathColorConversion::testToneCurveConversion_data()
+{
+    QTest::addColumn<QString>("srcDepthId");
+    QTest::addColumn<QString>("dstDepthId");
+    QTest::addColumn<bool>("fromLinear");
+
+    QStringList srcDepths;
+    srcDepths << Integer8BitsColorDepthID.id();
+    srcDepths << Integer16BitsColorDepthID.id();
+
+    QStringList dstDepths = srcDepths;
+    dstDepths << Float32BitsColorDepthID.id();
+
+    Q_FOREACH (const QString &src, srcDepths) {
+        Q_FOREACH (const QString &dst, dstDepths) {
+            QTest::newRow(QString("srgb-%1-linear-%2").arg(src).arg(dst).toLatin1()) << src << dst << false;
+            QTest::newRow(QString("linear-%1-srgb-%2").arg(src).arg(dst).toLatin1()) << src << dst << true;
+        }
+    }
+}
+
+void TestLcmsFastPathColorConversion::testToneCurveConversion()
+{
+    QFETCH(QString, srcDepthId);
+    QFETCH(QString, dstDepthId);
+    QFETCH(bool, fromLinear);
+
+    const KoColorProfile *srgbProfile = KoColorSpaceRegistry::instance()->p709SRGBProfile();
+    const KoColorProfile *linearProfile = KoColorSpaceRegistry::instance()->p709G10Profile();
+
+    if (fromLinear) {
+        std::swap(srgbProfile, linearProfile);
+    }
+
+    const bool hasU8 =
+        srcDepthId == Integer8BitsColorDepthID.id() ||
+        dstDepthId == Integer8BitsColorDepthID.id();
+
+    compareWithLcms(rgbColorSpace(srcDepthId, srgbProfile),
+                    rgbColorSpace(dstDepthId, linearProfile),
+                    hasU8 ? 1.01 / 255 : 0.002);
+}
+
+KISTEST_MAIN(TestLcmsFastPathColorConversion)
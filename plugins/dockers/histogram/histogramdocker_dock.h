@@ -42,7 +42,7 @@ public:
     void unsetCanvas() override;
 
 public Q_SLOTS:
-    void startUpdateCanvasProjection();
+    void startUpdateCanvasProjection(const QRect &rc);
     void sigColorSpaceChanged(const KoColorSpace* cs);
     void updateHistogram();
 
@@ -19,7 +19,6 @@
 
 #include <QThread>
 #include <QVector>
-#include <limits>
 #include <algorithm>
 #include <QTime>
 #include <QPainter>
@@ -28,11 +27,13 @@
 #include "KoChannelInfo.h"
 #include "kis_paint_device.h"
 #include "KoColorSpace.h"
-#include "kis_iterator_ng.h"
 #include "kis_canvas2.h"
 
 HistogramDockerWidget::HistogramDockerWidget(QWidget *parent, const char *name, Qt::WindowFlags f)
-    : QLabel(parent, f), m_paintDevice(nullptr), m_smoothHistogram(true)
+    : QLabel(parent, f), m_paintDevice(nullptr), m_smoothHistogram(true),
+      m_cache(new HistogramShardCache()),
+      m_computationRunning(false),
+      m_updatePending(false)
 {
     setObjectName(name);
 }
@@ -52,16 +53,55 @@ void HistogramDockerWidget::setPaintDevice(KisCanvas2* canvas)
         m_bounds = QRect();
         m_histogramData.clear();
     }
+
+    // a new image, the cached shards are of no use anymore
+    m_dirtyRects.clear();
+    if (m_computationRunning) {
+        // the running thread still uses the old cache, let it finish with it
+        m_cache.reset(new HistogramShardCache());
+    } else {
+        m_cache->invalidate();
+    }
+}
+
+void HistogramDockerWidget::addDirtyRect(const QRect &rc)
+{
+    m_dirtyRects.append(rc);
+
+    // don't let the list grow while the docker is hidden
+    if (m_dirtyRects.size() > 256) {
+        QRect boundingRect;
+        Q_FOREACH (const QRect &dirtyRect, m_dirtyRects) {
+            boundingRect |= dirtyRect;
+        }
+        m_dirtyRects.clear();
+        m_dirtyRects.append(boundingRect);
+    }
 }
 
 void HistogramDockerWidget::updateHistogram()
 {
     if (!m_paintDevice.isNull()) {
+        if (m_computationRunning) {
+            // the cache is busy, update it once the current pass is done
+            m_updatePending = true;
+            return;
+        }
+
         KisPaintDeviceSP m_devClone = new KisPaintDevice(m_paintDevice->colorSpace());
 
         m_devClone->makeCloneFrom(m_paintDevice, m_bounds);
 
-        HistogramComputationThread *workerThread = new HistogramComputationThread(m_devClone, m_bounds);
+        if (m_cache->resetIfIncompatible(m_bounds, m_devClone->channelCount())) {
+            m_dirtyRects.clear();
+        }
+
+        m_computationRunning = true;
+        m_updatePending = false;
+
+        HistogramComputationThread *workerThread = new HistogramComputationThread(m_devClone, m_cache, m_dirtyRects);
+        m_dirtyRects.clear();
+
         connect(workerThread, &HistogramComputationThread::resultReady, this, &HistogramDockerWidget::receiveNewHistogram);
         connect(workerThread, &HistogramComputationThread::finished, workerThread, &QObject::deleteLater);
         workerThread->start();
@@ -74,7 +114,12 @@ void HistogramDockerWidget::updateHistogram()
 void HistogramDockerWidget::receiveNewHistogram(HistVector *histogramData)
 {
     m_histogramData = *histogramData;
+    m_computationRunning = false;
     update();
+
+    if (m_updatePending) {
+        updateHistogram();
+    }
 }
 
 void HistogramDockerWidget::paintEvent(QPaintEvent *event)
@@ -156,42 +201,10 @@ void HistogramDockerWidget::paintEvent(QPaintEvent *event)
 
 void HistogramComputationThread::run()
 {
-    const KoColorSpace *cs = m_dev->colorSpace();
-    quint32 channelCount = m_dev->channelCount();
-    quint32 pixelSize = m_dev->pixelSize();
-
-    quint32 imageSize = m_bounds.width() * m_bounds.height();
-    quint32 nSkip = 1 + (imageSize >> 20); //for speed use about 1M pixels for computing histograms
-
-    //allocate space for the histogram data
-    bins.resize((int)channelCount);
-    for (auto &bin : bins) {
-        bin.resize(std::numeric_limits<quint8>::max() + 1);
-    }
-
-    QRect bounds = m_dev->exactBounds();
-    if (bounds.isEmpty())
-        return;
+    m_cache->update(m_dev, m_dirtyRects);
 
-    quint32 toSkip = nSkip;
-
-    KisSequentialConstIterator it(m_dev, m_dev->exactBounds());
-
-    int numConseqPixels = it.nConseqPixels();
-    while (it.nextPixels(numConseqPixels)) {
-
-        numConseqPixels = it.nConseqPixels();
-        const quint8* pixel = it.rawDataConst();
-        for (int k = 0; k < numConseqPixels; ++k) {
-            if (--toSkip == 0) {
-                for (int chan = 0; chan < (int)channelCount; ++chan) {
-                    bins[chan][cs->scaleToU8(pixel, chan)]++;
-                }
-                toSkip = nSkip;
-            }
-            pixel += pixelSize;
-        }
-    }
+    // the cache is owned by the GUI thread, so hand over a copy
+    bins = m_cache->totals();
 
     emit resultReady(&bins);
 }
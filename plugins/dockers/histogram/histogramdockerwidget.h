@@ -23,19 +23,21 @@
 #include <QWidget>
 #include <QLabel>
 #include <QThread>
+#include <QSharedPointer>
 #include "kis_types.h"
 #include <vector>
 
-class KisCanvas2;
+#include "histogramshardcache.h"
 
-typedef std::vector<std::vector<quint32> > HistVector; //Don't use QVector here - it's too slow for this purpose
+class KisCanvas2;
 
 
 class HistogramComputationThread : public QThread
 {
     Q_OBJECT
 public:
-    HistogramComputationThread(KisPaintDeviceSP _dev, const QRect& _bounds) : m_dev(_dev), m_bounds(_bounds)
+    HistogramComputationThread(KisPaintDeviceSP _dev, QSharedPointer<HistogramShardCache> _cache, const QVector<QRect> &_dirtyRects)
+        : m_dev(_dev), m_cache(_cache), m_dirtyRects(_dirtyRects)
     {}
 
     void run() override;
@@ -45,7 +47,8 @@ Q_SIGNALS:
 
 private:
     KisPaintDeviceSP m_dev;
-    QRect m_bounds;
+    QSharedPointer<HistogramShardCache> m_cache;
+    QVector<QRect> m_dirtyRects;
     HistVector bins;
 };
 
@@ -64,11 +67,22 @@ public Q_SLOTS:
     void updateHistogram();
     void receiveNewHistogram(HistVector*);
 
+    /**
+     * Remembers the area of the image that changed since the last
+     * update, only this area is rescanned on the next update
+     */
+    void addDirtyRect(const QRect &rc);
+
 private:
     KisPaintDeviceSP m_paintDevice;
     HistVector m_histogramData;
     QRect m_bounds;
     bool m_smoothHistogram;
+
+    QSharedPointer<HistogramShardCache> m_cache;
+    QVector<QRect> m_dirtyRects;
+    bool m_computationRunning;
+    bool m_updatePending;
 };
 
 #endif // HISTOGRAMDOCKERWIDGET_H
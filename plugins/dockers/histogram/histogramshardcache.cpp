@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "histogramshardcache.h"
+
+#include <QtConcurrentMap>
+#include <cmath>
+#include <limits>
+
+#include "KoColorSpace.h"
+#include "kis_assert.h"
+#include "kis_paint_device.h"
+
+namespace {
+const int numBins = std::numeric_limits<quint8>::max() + 1;
+}
+
+HistogramShardCache::HistogramShardCache()
+    : m_channelCount(0),
+      m_sampleStep(1),
+      m_shardColumns(0),
+      m_shardRows(0)
+{
+}
+
+bool HistogramShardCache::resetIfIncompatible(const QRect &bounds, int channelCount)
+{
+    if (bounds == m_bounds && channelCount == m_channelCount) {
+        return false;
+    }
+
+    m_bounds = bounds;
+    m_channelCount = channelCount;
+
+    // for speed use about 1M pixels for computing histograms
+    const quint64 imageSize = quint64(bounds.width()) * bounds.height();
+    const int nSkip = 1 + (imageSize >> 20);
+    m_sampleStep = qMax(1, qRound(std::sqrt(qreal(nSkip))));
+
+    m_shardColumns = (bounds.width() + shardSize - 1) / shardSize;
+    m_shardRows = (bounds.height() + shardSize - 1) / shardSize;
+
+    m_shards.clear();
+    m_shards.resize(m_shardColumns * m_shardRows);
+
+    m_totals.clear();
+    m_totals.resize(channelCount);
+    for (auto &bin : m_totals) {
+        bin.resize(numBins);
+    }
+
+    invalidate();
+
+    return true;
+}
+
+void HistogramShardCache::invalidate()
+{
+    m_dirtyShards.assign(m_shards.size(), true);
+}
+
+const HistVector& HistogramShardCache::totals() const
+{
+    return m_totals;
+}
+
+void HistogramShardCache::computeShard(KisPaintDeviceSP dev, int index, std::vector<quint16> *bins) const
+{
+    const KoColorSpace *cs = dev->colorSpace();
+    const int pixelSize = cs->pixelSize();
+
+    const QRect shardRect =
+        QRect(m_bounds.x() + (index % m_shardColumns) * shardSize,
+              m_bounds.y() + (index / m_shardColumns) * shardSize,
+              shardSize, shardSize) & m_bounds;
+
+    bins->assign(m_channelCount * numBins, 0);
+
+    QVector<quint8> buffer(shardRect.width() * shardRect.height() * pixelSize);
+    dev->readBytes(buffer.data(), shardRect);
+
+    // shardSize is not necessarily a multiple of the step, so align
+    // the sampling grid to the image origin, not to the shard
+    const int startX = (m_sampleStep - (shardRect.x() - m_bounds.x()) % m_sampleStep) % m_sampleStep;
+    const int startY = (m_sampleStep - (shardRect.y() - m_bounds.y()) % m_sampleStep) % m_sampleStep;
+
+    quint16 *binsPtr = bins->data();
+
+    for (int y = startY; y < shardRect.height(); y += m_sampleStep) {
+        const quint8 *pixel = buffer.constData() + (y * shardRect.width() + startX) * pixelSize;
+
+        for (int x = startX; x < shardRect.width(); x += m_sampleStep) {
+            for (int chan = 0; chan < m_channelCount; ++chan) {
+                binsPtr[chan * numBins + cs->scaleToU8(pixel, chan)]++;
+            }
+            pixel += m_sampleStep * pixelSize;
+        }
+    }
+}
+
+void HistogramShardCache::update(KisPaintDeviceSP dev, const QVector<QRect> &dirtyRects)
+{
+    if (m_shards.empty()) return;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(int(dev->channelCount()) == m_channelCount);
+
+    Q_FOREACH (const QRect &rc, dirtyRects) {
+        const QRect dirtyRect = rc & m_bounds;
+        if (dirtyRect.isEmpty()) continue;
+
+        const int firstColumn = (dirtyRect.left() - m_bounds.x()) / shardSize;
+        const int lastColumn = (dirtyRect.right() - m_bounds.x()) / shardSize;
+        const int firstRow = (dirtyRect.top() - m_bounds.y()) / shardSize;
+        const int lastRow = (dirtyRect.bottom() - m_bounds.y()) / shardSize;
+
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                m_dirtyShards[row * m_shardColumns + column] = true;
+            }
+        }
+    }
+
+    QVector<int> dirtyIndexes;
+    for (int i = 0; i < int(m_dirtyShards.size()); i++) {
+        if (m_dirtyShards[i]) {
+            dirtyIndexes << i;
+        }
+    }
+
+    if (dirtyIndexes.isEmpty()) return;
+
+    // the shards are independent, so they can be scanned in parallel
+    std::vector<std::vector<quint16> > newBins(dirtyIndexes.size());
+    QVector<int> jobs(dirtyIndexes.size());
+    for (int i = 0; i < jobs.size(); i++) {
+        jobs[i] = i;
+    }
+
+    QtConcurrent::blockingMap(jobs, [this, dev, &dirtyIndexes, &newBins] (int job) {
+        computeShard(dev, dirtyIndexes[job], &newBins[job]);
+    });
+
+    // merge: replace the old contribution of every shard with the new one
+    for (int i = 0; i < dirtyIndexes.size(); i++) {
+        std::vector<quint16> &oldShard = m_shards[dirtyIndexes[i]];
+        const std::vector<quint16> &newShard = newBins[i];
+
+        for (int chan = 0; chan < m_channelCount; ++chan) {
+            quint32 *totals = m_totals[chan].data();
+            const quint16 *newValues = newShard.data() + chan * numBins;
+
+            if (!oldShard.empty()) {
+                const quint16 *oldValues = oldShard.data() + chan * numBins;
+                for (int bin = 0; bin < numBins; ++bin) {
+                    totals[bin] += quint32(newValues[bin]) - quint32(oldValues[bin]);
+                }
+            } else {
+                for (int bin = 0; bin < numBins; ++bin) {
+                    totals[bin] += newValues[bin];
+                }
+            }
+        }
+
+        oldShard = newShard;
+        m_dirtyShards[dirtyIndexes[i]] = false;
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef HISTOGRAMSHARDCACHE_H
+#define HISTOGRAMSHARDCACHE_H
+
+#include <QRect>
+#include <QVector>
+#include <vector>
+
+#include "kis_types.h"
+
+typedef std::vector<std::vector<quint32> > HistVector; //Don't use QVector here - it's too slow for this purpose
+
+/**
+ * Keeps the histogram of an image split into square shards, so that
+ * after a stroke only the shards touched by the stroke are rescanned.
+ *
+ * Every shard stores its own 8-bit bins for all the channels. When a
+ * shard is recomputed, its old bins are subtracted from the totals and
+ * the new ones are added back. Dirty shards are scanned in parallel.
+ *
+ * Large images are sampled on a regular grid anchored to the image
+ * origin, so a pixel is either always or never part of the histogram
+ * and incremental updates stay consistent with a full recomputation.
+ */
+class HistogramShardCache
+{
+public:
+    HistogramShardCache();
+
+    /**
+     * Drops all the cached data if \p bounds or \p channelCount differ
+     * from the ones the cache was built for. Returns true if the cache
+     * has been reset and needs a full update.
+     */
+    bool resetIfIncompatible(const QRect &bounds, int channelCount);
+
+    /**
+     * Rescans the shards intersecting \p dirtyRects and updates the
+     * totals. The device is expected not to change while the update
+     * runs, pass a copy of the projection.
+     */
+    void update(KisPaintDeviceSP dev, const QVector<QRect> &dirtyRects);
+
+    /**
+     * Marks every shard as dirty
+     */
+    void invalidate();
+
+    const HistVector& totals() const;
+
+    static const int shardSize = 128;
+
+private:
+    void computeShard(KisPaintDeviceSP dev, int index, std::vector<quint16> *bins) const;
+
+private:
+    QRect m_bounds;
+    int m_channelCount;
+    int m_sampleStep;
+    int m_shardColumns;
+    int m_shardRows;
+
+    /**
+     * Bins of every shard, channelCount * 256 values each. A shard that
+     * has never been computed has an empty vector. 16 bits are enough,
+     * since a shard has at most shardSize * shardSize = 16384 pixels.
+     */
+    std::vector<std::vector<quint16> > m_shards;
+    std::vector<bool> m_dirtyShards;
+    HistVector m_totals;
+};
+
+#endif // HISTOGRAMSHARDCACHE_H
@@ -35,6 +35,7 @@
 #include <KisViewManager.h>
 #include <kis_image.h>
 #include <kis_wavelet_kernel.h>
+#include <KisAtrousWavelet.h>
 #include <kis_action.h>
 #include <KisDocument.h>
 #include <kis_node.h>
@@ -106,7 +107,9 @@ void WaveletDecompose::slotWaveletDecompose()
             KisPaintDeviceSP blur = new KisPaintDevice(*original);
            
             //blur it
-            KisWaveletKernel::applyWavelet(blur, rc, 1 << level, 1 << level, flags, 0);
+            if (!KisAtrousWavelet::applySmoothing(blur, rc, level, flags, 0)) {
+                KisWaveletKernel::applyWavelet(blur, rc, 1 << level, 1 << level, flags, 0);
+            }
        
             //do grain extract blur from original
             KisPainter painter(original);
@@ -26,6 +26,7 @@
 
 #include <kis_convolution_kernel.h>
 #include <kis_convolution_painter.h>
+#include <KisBokehBlur.h>
 
 #include "ui_wdg_lens_blur.h"
 
@@ -108,6 +109,7 @@ QPolygonF KisLensBlurFilter::getIrisPolygon(const KisFilterConfigurationSP confi
     else if (irisShape == "Hexagon (6)") sides = 6;
     else if (irisShape == "Heptagon (7)") sides = 7;
     else if (irisShape == "Octagon (8)") sides = 8;
+    else if (irisShape == "Circle") sides = 64;
     else return QPolygonF();
 
     for (int i = 0; i < sides; ++i) {
@@ -145,6 +147,22 @@ void KisLensBlurFilter::processImpl(KisPaintDeviceSP device,
     }
 
     const int lod = device->defaultBounds()->currentLevelOfDetail();
+
+    /**
+     * Round apertures of large radii are handled by the separable
+     * approximation, which is much faster than the 2D convolution
+     */
+    if (config->getString("irisShape") == "Circle") {
+        KisLodTransformScalar t(lod);
+        const qreal irisRadius = t.scale(qreal(config->getInt("irisRadius", 5)));
+
+        if (irisRadius >= KisBokehBlur::minimalRadius &&
+            KisBokehBlur::applyCircularBlur(device, rect, irisRadius, channelFlags, progressUpdater)) {
+
+            return;
+        }
+    }
+
     QPolygonF transformedIris = getIrisPolygon(config, lod);
     if (transformedIris.isEmpty()) return;
 
@@ -198,8 +216,15 @@ QRect KisLensBlurFilter::changedRect(const QRect & rect, const KisFilterConfigur
     KisLodTransformScalar t(lod);
 
     QVariant value;
-    const int halfWidth = t.scale(_config->getProperty("halfWidth", value) ? value.toUInt() : 5);
-    const int halfHeight = t.scale(_config->getProperty("halfHeight", value) ? value.toUInt() : 5);
+    int halfWidth = t.scale(_config->getProperty("halfWidth", value) ? value.toUInt() : 5);
+    int halfHeight = t.scale(_config->getProperty("halfHeight", value) ? value.toUInt() : 5);
+
+    // the separable bokeh kernel has a slightly wider support than the disk
+    if (_config->getString("irisShape") == "Circle") {
+        const int margin = KisBokehBlur::kernelMargin(t.scale(qreal(_config->getInt("irisRadius", 5))));
+        halfWidth = qMax(halfWidth, margin);
+        halfHeight = qMax(halfHeight, margin);
+    }
 
     return rect.adjusted(-halfWidth, -halfHeight, halfWidth, halfHeight);
 }
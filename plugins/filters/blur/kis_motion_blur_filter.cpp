@@ -26,6 +26,7 @@
 
 #include <kis_convolution_kernel.h>
 #include <kis_convolution_painter.h>
+#include <KisMotionBlur.h>
 
 #include "ui_wdg_motion_blur.h"
 
@@ -96,6 +97,12 @@ void KisMotionBlurFilter::processImpl(KisPaintDeviceSP device,
         channelFlags = QBitArray(device->colorSpace()->channelCount(), true);
     }
 
+    if (KisMotionBlur::applyMotionBlur(device, rect, blurLength, blurAngle, channelFlags, progressUpdater)) {
+        return;
+    }
+
+    // the color space is not supported by the engine, fall back to the convolution
+
     // convert angle to radians
     qreal angleRadians = blurAngle / 360.0 * 2 * M_PI;
 
@@ -144,24 +151,12 @@ QRect KisMotionBlurFilter::neededRect(const QRect & rect, const KisFilterConfigu
     uint blurAngle = _config->getProperty("blurAngle", value) ? value.toUInt() : 0;
     uint blurLength = t.scale(_config->getProperty("blurLength", value) ? value.toUInt() : 5);
 
-    qreal angleRadians = blurAngle / 360.0 * 2 * M_PI;
-    const int halfWidth = ceil(fabs(blurLength / 2.0 * cos(angleRadians)));
-    const int halfHeight = ceil(fabs(blurLength / 2.0 * cos(angleRadians)));
+    const QSize margins = KisMotionBlur::kernelMargins(blurLength, blurAngle);
 
-    return rect.adjusted(-halfWidth * 2, -halfHeight * 2, halfWidth * 2, halfHeight * 2);
+    return rect.adjusted(-margins.width(), -margins.height(), margins.width(), margins.height());
 }
 
 QRect KisMotionBlurFilter::changedRect(const QRect & rect, const KisFilterConfigurationSP _config, int lod) const
 {
-    KisLodTransformScalar t(lod);
-
-    QVariant value;
-    uint blurAngle = _config->getProperty("blurAngle", value) ? value.toUInt() : 0;
-    uint blurLength = t.scale(_config->getProperty("blurLength", value) ? value.toUInt() : 5);
-
-    qreal angleRadians = blurAngle / 360.0 * 2 * M_PI;
-    const int halfWidth = ceil(fabs(blurLength * cos(angleRadians)));
-    const int halfHeight = ceil(fabs(blurLength * cos(angleRadians)));
-
-    return rect.adjusted(-halfWidth * 2, -halfHeight * 2, halfWidth * 2, halfHeight * 2);
+    return neededRect(rect, _config, lod);
 }
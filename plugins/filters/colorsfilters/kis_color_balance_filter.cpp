@@ -58,6 +58,13 @@ KoColorTransformation * KisColorBalanceFilter::createTransformation(const KoColo
     return cs->createColorTransformation("ColorBalance" , params);
 }
 
+bool KisColorBalanceFilter::canBakeTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const
+{
+    Q_UNUSED(cs);
+    Q_UNUSED(config);
+    return true;
+}
+
 KisFilterConfigurationSP KisColorBalanceFilter::factoryConfiguration() const
 {
     KisColorTransformationConfigurationSP config = new KisColorTransformationConfiguration(id().id(), 0);
@@ -48,6 +48,7 @@ public:
 	KisConfigWidget * createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP dev) const override;
 
     KoColorTransformation* createTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const override;
+    bool canBakeTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const override;
 
 	static inline KoID id() {
         return KoID("colorbalance", i18n("Color Balance"));
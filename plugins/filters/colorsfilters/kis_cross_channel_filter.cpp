@@ -291,3 +291,29 @@ KoColorTransformation* KisCrossChannelFilter::createTransformation(const KoColor
 
     return KoCompositeColorTransformation::createOptimizedCompositeTransform(transforms);
 }
+
+bool KisCrossChannelFilter::canBakeTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const
+{
+    const KisCrossChannelFilterConfiguration* configBC =
+        dynamic_cast<const KisCrossChannelFilterConfiguration*>(config.data());
+    if (!configBC) return false;
+
+    const QList<KisCubicCurve> &curves = configBC->curves();
+    const QVector<int> &drivers = configBC->driverChannels();
+
+    const QVector<VirtualChannelInfo> virtualChannels =
+        KisMultiChannelFilter::getVirtualChannels(cs, configBC->transfers().size());
+
+    // the curves driving or adjusting alpha don't fit into a color table
+    for (int i = 0; i < qMin(curves.size(), virtualChannels.size()); i++) {
+        if (curves[i].isConstant(0.5)) continue;
+
+        if (virtualChannels[i].isAlpha() ||
+            virtualChannels[drivers[i]].isAlpha()) {
+
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -48,6 +48,7 @@ public:
     KisFilterConfigurationSP factoryConfiguration() const override;
 
     KoColorTransformation* createTransformation(const KoColorSpace *cs, const KisFilterConfigurationSP config) const override;
+    bool canBakeTransformation(const KoColorSpace *cs, const KisFilterConfigurationSP config) const override;
 
     static inline KoID id() {
         return KoID("crosschannel", i18n("Cross-channel color adjustment"));
@@ -39,6 +39,7 @@
 #include "KoBasicHistogramProducers.h"
 #include <KoColorSpace.h>
 #include <KoColorTransformation.h>
+#include <KoDesaturateKernel.h>
 #include <filter/kis_filter_category_ids.h>
 #include <filter/kis_color_transformation_configuration.h>
 #include <kis_paint_device.h>
@@ -54,6 +55,25 @@
 #include <KoColorSpaceConstants.h>
 #include <KoCompositeOp.h>
 #include <kis_iterator_ng.h>
+#include <KisTileKernel.h>
+
+namespace {
+
+template <class Traits>
+struct DesaturateSpan
+{
+    typedef typename Traits::channels_type channels_type;
+
+    DesaturateSpan(int type) : m_type(type) {}
+
+    void operator() (const channels_type *src, channels_type *dst, int numPixels) const {
+        KoDesaturateKernel<Traits>::desaturatePixels(m_type, src, dst, numPixels);
+    }
+
+    int m_type;
+};
+
+}
 
 KisDesaturateFilter::KisDesaturateFilter()
    : KisColorTransformationFilter(id(), FiltersCategoryAdjustId, i18n("&Desaturate..."))
@@ -82,6 +102,22 @@ KoColorTransformation* KisDesaturateFilter::createTransformation(const KoColorSp
     return  cs->createColorTransformation("desaturate_adjustment", params);
 }
 
+void KisDesaturateFilter::processImpl(KisPaintDeviceSP device,
+                                      const QRect& applyRect,
+                                      const KisFilterConfigurationSP config,
+                                      KoUpdater* progressUpdater) const
+{
+    /**
+     * The RGBA spaces run the same pixel loop as the desaturate
+     * adjustment, but directly on the spans of the device
+     */
+    const int type = config ? config->getInt("type", 0) : 0;
+
+    if (!KisTileKernel::processRgbaSpans<DesaturateSpan>(device, applyRect, progressUpdater, type)) {
+        KisColorTransformationFilter::processImpl(device, applyRect, config, progressUpdater);
+    }
+}
+
 KisFilterConfigurationSP KisDesaturateFilter::factoryConfiguration() const
 {
     KisColorTransformationConfigurationSP config = new KisColorTransformationConfiguration(id().id(), 1);
@@ -42,6 +42,11 @@ public:
 
     KoColorTransformation* createTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const override;
 
+    void processImpl(KisPaintDeviceSP device,
+                     const QRect& applyRect,
+                     const KisFilterConfigurationSP config,
+                     KoUpdater* progressUpdater) const override;
+
     static inline KoID id() {
         return KoID("desaturate", i18n("Desaturate"));
     }
@@ -124,6 +124,13 @@ KoColorTransformation* KisHSVAdjustmentFilter::createTransformation(const KoColo
     return cs->createColorTransformation("hsv_adjustment", params);
 }
 
+bool KisHSVAdjustmentFilter::canBakeTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const
+{
+    Q_UNUSED(cs);
+    Q_UNUSED(config);
+    return true;
+}
+
 KisFilterConfigurationSP KisHSVAdjustmentFilter::factoryConfiguration() const
 {
     KisColorTransformationConfigurationSP config = new KisColorTransformationConfiguration(id().id(), 1);
@@ -316,3 +316,37 @@ KoColorTransformation* KisPerChannelFilter::createTransformation(const KoColorSp
 
     return KoCompositeColorTransformation::createOptimizedCompositeTransform(allTransforms);
 }
+
+bool KisPerChannelFilter::canBakeTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const
+{
+    const KisPerChannelFilterConfiguration* configBC =
+        dynamic_cast<const KisPerChannelFilterConfiguration*>(config.data());
+    if (!configBC) return false;
+
+    const QList<KisCubicCurve> &curves = configBC->curves();
+    const QVector<VirtualChannelInfo> virtualChannels =
+        KisMultiChannelFilter::getVirtualChannels(cs, configBC->transfers().size());
+
+    /**
+     * The real channels are adjusted with 1D lookup tables already, so
+     * the baking pays off only when the HSV curves are used. The alpha
+     * curve must stay untouched.
+     */
+    bool hasHSVCurves = false;
+
+    for (int i = 0; i < qMin(curves.size(), virtualChannels.size()); i++) {
+        if (curves[i].isIdentity()) continue;
+
+        if (virtualChannels[i].isAlpha()) {
+            return false;
+        }
+
+        const VirtualChannelInfo::Type type = virtualChannels[i].type();
+        hasHSVCurves |=
+            type == VirtualChannelInfo::HUE ||
+            type == VirtualChannelInfo::SATURATION ||
+            type == VirtualChannelInfo::LIGHTNESS;
+    }
+
+    return hasHSVCurves;
+}
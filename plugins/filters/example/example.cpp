@@ -37,6 +37,22 @@
 #include <filter/kis_filter_registry.h>
 #include <kis_global.h>
 #include "KoColorModelStandardIds.h"
+#include <KoInvertColorTransformation.h>
+#include <KisTileKernel.h>
+
+namespace {
+
+template <class Traits>
+struct InvertSpan
+{
+    typedef typename Traits::channels_type channels_type;
+
+    void operator() (const channels_type *src, channels_type *dst, int numPixels) const {
+        KoInvertColorTransformationTraits<Traits>::invertPixels(src, dst, numPixels);
+    }
+};
+
+}
 
 K_PLUGIN_FACTORY_WITH_JSON(KritaExampleFactory, "kritaexample.json", registerPlugin<KritaExample>();)
 
@@ -65,6 +81,20 @@ KoColorTransformation* KisFilterInvert::createTransformation(const KoColorSpace*
     return cs->createInvertTransformation();
 }
 
+void KisFilterInvert::processImpl(KisPaintDeviceSP device,
+                                  const QRect& applyRect,
+                                  const KisFilterConfigurationSP config,
+                                  KoUpdater* progressUpdater) const
+{
+    /**
+     * The RGBA spaces run the pixel loop of their invert transformation
+     * directly on the spans of the device
+     */
+    if (!KisTileKernel::processRgbaSpans<InvertSpan>(device, applyRect, progressUpdater)) {
+        KisColorTransformationFilter::processImpl(device, applyRect, config, progressUpdater);
+    }
+}
+
 bool KisFilterInvert::needsTransparentPixels(const KisFilterConfigurationSP config, const KoColorSpace *cs) const
 {
     Q_UNUSED(config);
@@ -41,6 +41,11 @@ public:
 
     KoColorTransformation* createTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const override;
 
+    void processImpl(KisPaintDeviceSP device,
+                     const QRect& applyRect,
+                     const KisFilterConfigurationSP config,
+                     KoUpdater* progressUpdater) const override;
+
     static inline KoID id() {
         return KoID("invert", i18n("Invert"));
     }
@@ -26,6 +26,7 @@
 
 #include <kis_layer.h>
 #include <kis_math_toolbox.h>
+#include <KisAtrousWavelet.h>
 #include <widgets/kis_multi_double_filter_widget.h>
 #include <widgets/kis_multi_integer_filter_widget.h>
 #include <kis_paint_device.h>
@@ -34,48 +35,19 @@
 #include <kis_processing_information.h>
 #include "kis_global.h"
 
-KisWaveletNoiseReduction::KisWaveletNoiseReduction()
-    : KisFilter(id(), FiltersCategoryEnhanceId, i18n("&Wavelet Noise Reducer..."))
-{
-    setSupportsPainting(false);
-    setSupportsThreading(false);
-}
+namespace {
 
-
-KisWaveletNoiseReduction::~KisWaveletNoiseReduction()
-{
-}
-
-KisConfigWidget * KisWaveletNoiseReduction::createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP) const
-{
-    vKisDoubleWidgetParam param;
-    param.push_back(KisDoubleWidgetParam(0.0, 256.0, BEST_WAVELET_THRESHOLD_VALUE, i18n("Threshold"), "threshold"));
-    return new KisMultiDoubleFilterWidget(id().id(), parent, id().id(), param);
-}
-
-KisFilterConfigurationSP KisWaveletNoiseReduction::factoryConfiguration() const
-{
-    KisFilterConfigurationSP config = new KisFilterConfiguration(id().id(), 0);
-    config->setProperty("threshold", BEST_WAVELET_THRESHOLD_VALUE);
-    return config;
-}
-
-void KisWaveletNoiseReduction::processImpl(KisPaintDeviceSP device,
-                                           const QRect& applyRect,
-                                           const KisFilterConfigurationSP _config,
-                                           KoUpdater* progressUpdater
-                                           ) const
+/**
+ * The Haar transform based noise reduction, used for the color spaces
+ * KisAtrousWavelet cannot convert
+ */
+void applyHaarNoiseReduction(KisPaintDeviceSP device,
+                             const QRect& applyRect,
+                             float threshold,
+                             KoUpdater* progressUpdater)
 {
-    Q_ASSERT(device);
-
-    KisFilterConfigurationSP config = _config ? _config : defaultConfiguration();
-    const float threshold = config->getDouble("threshold", BEST_WAVELET_THRESHOLD_VALUE);
-
     KisMathToolbox mathToolbox;
 
-    //     dbgFilters << size <<"" << maxrectsize <<"" << srcTopLeft.x() <<"" << srcTopLeft.y();
-
-    //     dbgFilters <<"Transforming...";
     KisMathToolbox::KisWavelet* buff = 0;
     KisMathToolbox::KisWavelet* wav = 0;
 
@@ -123,3 +95,72 @@ void KisWaveletNoiseReduction::processImpl(KisPaintDeviceSP device,
     delete wav;
     delete buff;
 }
+
+}
+
+KisWaveletNoiseReduction::KisWaveletNoiseReduction()
+    : KisFilter(id(), FiltersCategoryEnhanceId, i18n("&Wavelet Noise Reducer..."))
+{
+    setSupportsPainting(false);
+    setSupportsThreading(false);
+}
+
+
+KisWaveletNoiseReduction::~KisWaveletNoiseReduction()
+{
+}
+
+KisConfigWidget * KisWaveletNoiseReduction::createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP) const
+{
+    vKisDoubleWidgetParam param;
+    param.push_back(KisDoubleWidgetParam(0.0, 256.0, BEST_WAVELET_THRESHOLD_VALUE, i18n("Threshold"), "threshold"));
+    return new KisMultiDoubleFilterWidget(id().id(), parent, id().id(), param);
+}
+
+KisFilterConfigurationSP KisWaveletNoiseReduction::factoryConfiguration() const
+{
+    KisFilterConfigurationSP config = new KisFilterConfiguration(id().id(), 0);
+    config->setProperty("threshold", BEST_WAVELET_THRESHOLD_VALUE);
+    return config;
+}
+
+void KisWaveletNoiseReduction::processImpl(KisPaintDeviceSP device,
+                                           const QRect& applyRect,
+                                           const KisFilterConfigurationSP _config,
+                                           KoUpdater* progressUpdater
+                                           ) const
+{
+    Q_ASSERT(device);
+
+    KisFilterConfigurationSP config = _config ? _config : defaultConfiguration();
+    const float threshold = config->getDouble("threshold", BEST_WAVELET_THRESHOLD_VALUE);
+
+    /**
+     * Only the color channels are processed, the alpha channel is
+     * kept as it is
+     */
+    QBitArray channelFlags = device->colorSpace()->channelFlags(true, false);
+    if (!config->channelFlags().isEmpty()) {
+        channelFlags &= config->channelFlags();
+    }
+
+    if (!KisAtrousWavelet::applyNoiseReduction(device, applyRect, threshold, channelFlags, progressUpdater)) {
+        applyHaarNoiseReduction(device, applyRect, threshold, progressUpdater);
+    }
+}
+
+QRect KisWaveletNoiseReduction::neededRect(const QRect &rect, const KisFilterConfigurationSP config, int lod) const
+{
+    Q_UNUSED(config);
+    Q_UNUSED(lod);
+
+    return kisGrowRect(rect, KisAtrousWavelet::noiseReductionMargin());
+}
+
+QRect KisWaveletNoiseReduction::changedRect(const QRect &rect, const KisFilterConfigurationSP config, int lod) const
+{
+    Q_UNUSED(config);
+    Q_UNUSED(lod);
+
+    return kisGrowRect(rect, KisAtrousWavelet::noiseReductionMargin());
+}
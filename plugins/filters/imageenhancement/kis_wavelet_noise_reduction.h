@@ -45,6 +45,9 @@ public:
                      ) const override;
     KisConfigWidget * createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP dev) const override;
 
+    QRect neededRect(const QRect &rect, const KisFilterConfigurationSP config, int lod) const override;
+    QRect changedRect(const QRect &rect, const KisFilterConfigurationSP config, int lod) const override;
+
     static inline KoID id() {
         return KoID("waveletnoisereducer", i18n("Wavelet Noise Reducer"));
     }
@@ -92,6 +92,15 @@ KoColorTransformation* KisLevelFilter::createTransformation(const KoColorSpace*
     return cs->createBrightnessContrastAdjustment(transfer);
 }
 
+bool KisLevelFilter::canBakeTransformation(const KoColorSpace* cs, const KisFilterConfigurationSP config) const
+{
+    Q_UNUSED(cs);
+    Q_UNUSED(config);
+
+    // the lightness adjustment goes through Lab, so it is worth baking
+    return true;
+}
+
 KisLevelConfigWidget::KisLevelConfigWidget(QWidget * parent, KisPaintDeviceSP dev)
         : KisConfigWidget(parent)
 {
@@ -37,10 +37,12 @@
 #include <kpluginfactory.h>
 
 #include <KoUpdater.h>
+#include <KoColorSpaceRegistry.h>
+#include <KoColorConversionTransformation.h>
+#include <KoBgrColorSpaceTraits.h>
 
 #include <KisDocument.h>
 #include <kis_image.h>
-#include <KisSequentialIteratorProgress.h>
 #include <kis_layer.h>
 #include <filter/kis_filter_registry.h>
 #include <kis_global.h>
@@ -49,6 +51,7 @@
 #include <filter/kis_filter_configuration.h>
 #include <kis_processing_information.h>
 #include <kis_paint_device.h>
+#include <KisSlidingHistogram.h>
 #include "widgets/kis_multi_integer_filter_widget.h"
 
 
@@ -78,116 +81,78 @@ void KisOilPaintFilter::processImpl(KisPaintDeviceSP device,
 
 /* Function to apply the OilPaint effect.
  *
- * data             => The image data in RGBA mode.
- * w                => Width of image.
- * h                => Height of image.
- * BrushSize        => Brush size.
- * Smoothness       => Smooth value.
+ * BrushSize        => Brush size (the radius of the analyzed matrix).
+ * Smoothness       => Smooth value (the number of intensity levels).
  *
- * Theory           => Using MostFrequentColor function we take the main color in
- *                     a matrix and simply write at the original position.
+ * Theory           => Every pixel gets the main color of the matrix around
+ *                     it: the pixels are grouped by their intensity, and the
+ *                     average color of the most frequent intensity is taken.
+ *                     The intensity histograms of the matrices are slid over
+ *                     the image by KisSlidingHistogram, so the cost does not
+ *                     depend on the brush size.
  */
 
 void KisOilPaintFilter::OilPaint(const KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &applyRect,
                                  int BrushSize, int Smoothness, KoUpdater* progressUpdater) const
 {
-    KisSequentialConstIteratorProgress it(src, applyRect, progressUpdater);
-    KisSequentialIterator dstIt(dst, applyRect);
-
-    while (it.nextPixel() && dstIt.nextPixel()) {
-        MostFrequentColor(src, dstIt.rawData(), applyRect, it.x(), it.y(), BrushSize, Smoothness);
-    }
-}
-
-// This method has been ported from Pieter Z. Voloshyn's algorithm code in Digikam.
-
-/* Function to determine the most frequent color in a matrix
- *
- * Bits             => Bits array
- * Width            => Image width
- * Height           => Image height
- * X                => Position horizontal
- * Y                => Position vertical
- * Radius           => Is the radius of the matrix to be analyzed
- * Intensity        => Intensity to calculate
- *
- * Theory           => This function creates a matrix with the analyzed pixel in
- *                     the center of this matrix and find the most frequenty color
- */
-
-void KisOilPaintFilter::MostFrequentColor(KisPaintDeviceSP src, quint8* dst, const QRect& bounds, int X, int Y, int Radius, int Intensity) const
-{
-    uint I;
-
-    double Scale = Intensity / 255.0;
-
-    // Alloc some arrays to be used
-    uchar *IntensityCount = new uchar[(Intensity + 1) * sizeof(uchar)];
-
     const KoColorSpace* cs = src->colorSpace();
+    const double Scale = Smoothness / 255.0;
+
+    /**
+     * The intensity of a pixel is calculated the same way as
+     * KoColorSpace::intensity8() does, but the pixels of a strip are
+     * converted into sRGB with one call instead of locking the color
+     * space for every pixel
+     */
+    const KoColorSpace *rgbCS = KoColorSpaceRegistry::instance()->rgb8();
+    QVector<quint8> rgbPixels;
+
+    auto intensityBins = [cs, rgbCS, Scale, rgbPixels] (const quint8 *pixels, int numPixels, int *bins) mutable {
+        rgbPixels.resize(numPixels * rgbCS->pixelSize());
+        cs->convertPixelsTo(pixels, rgbPixels.data(), rgbCS, numPixels,
+                            KoColorConversionTransformation::internalRenderingIntent(),
+                            KoColorConversionTransformation::internalConversionFlags());
+
+        const KoBgrU8Traits::Pixel *rgbPixel =
+            reinterpret_cast<const KoBgrU8Traits::Pixel*>(rgbPixels.constData());
+
+        for (int i = 0; i < numPixels; i++, rgbPixel++) {
+            const quint8 intensity =
+                static_cast<quint8>(rgbPixel->red * 0.30 + rgbPixel->green * 0.59 + rgbPixel->blue * 0.11);
+            bins[i] = int(intensity * Scale);
+        }
+    };
 
     QVector<float> channel(cs->channelCount());
-    QVector<float>* AverageChannels = new QVector<float>[(Intensity + 1)];
-
-    // Erase the array
-    memset(IntensityCount, 0, (Intensity + 1) * sizeof(uchar));
-
-    int startx = qMax(X - Radius, bounds.left());
-    int starty = qMax(Y - Radius, bounds.top());
-    int width = (2 * Radius) + 1;
-    if ((startx + width - 1) > bounds.right()) width = bounds.right() - startx + 1;
-    Q_ASSERT((startx + width - 1) <= bounds.right());
-    int height = (2 * Radius) + 1;
-    if ((starty + height) > bounds.bottom()) height = bounds.bottom() - starty + 1;
-    Q_ASSERT((starty + height - 1) <= bounds.bottom());
-    KisSequentialConstIterator srcIt(src, QRect(startx, starty, width, height));
-    while (srcIt.nextPixel()) {
 
-        cs->normalisedChannelsValue(srcIt.rawDataConst(), channel);
+    auto mostFrequentColor = [cs, channel] (const KisSlidingHistogram::Window &window, const quint8 *, quint8 *dst) mutable {
+        const int I = window.modeBin();
 
-        I = (uint)(cs->intensity8(srcIt.rawDataConst()) * Scale);
-        IntensityCount[I]++;
+        if (I >= 0) {
+            const int MaxInstance = window.count(I);
+            const double *sums = window.channelSums(I);
 
-        if (IntensityCount[I] == 1) {
-            AverageChannels[I] = channel;
-        } else {
             for (int i = 0; i < channel.size(); i++) {
-                AverageChannels[I][i] += channel[i];
+                channel[i] = sums[i] / MaxInstance;
             }
+            cs->fromNormalisedChannelsValue(dst, channel);
+        } else {
+            memset(dst, 0, cs->pixelSize());
+            cs->setOpacity(dst, OPACITY_OPAQUE_U8, 1);
         }
-    }
-
-    I = 0;
-    int MaxInstance = 0;
-
-    for (int i = 0 ; i <= Intensity ; ++i) {
-        if (IntensityCount[i] > MaxInstance) {
-            I = i;
-            MaxInstance = IntensityCount[i];
-        }
-    }
-
-    if (MaxInstance != 0) {
-        channel = AverageChannels[I];
-        for (int i = 0; i < channel.size(); i++) {
-            channel[i] /= MaxInstance;
-        }
-        cs->fromNormalisedChannelsValue(dst, channel);
-    } else {
-        memset(dst, 0, cs->pixelSize());
-        cs->setOpacity(dst, OPACITY_OPAQUE_U8, 1);
-    }
-
+    };
 
-    delete [] IntensityCount;        // free all the arrays
-    delete [] AverageChannels;
+    KisSlidingHistogram::applyWithBulkBins(src, dst, applyRect, applyRect,
+                                           BrushSize, Smoothness + 1, true,
+                                           intensityBins, mostFrequentColor,
+                                           progressUpdater);
 }
 
 
 KisConfigWidget * KisOilPaintFilter::createConfigurationWidget(QWidget* parent, const KisPaintDeviceSP) const
 {
     vKisIntegerWidgetParam param;
-    param.push_back(KisIntegerWidgetParam(1, 5, 1, i18n("Brush size"), "brushSize"));
+    param.push_back(KisIntegerWidgetParam(1, 50, 1, i18n("Brush size"), "brushSize"));
     param.push_back(KisIntegerWidgetParam(10, 255, 30, i18nc("smooth out the painting strokes the filter creates", "Smooth"), "smooth"));
     KisMultiIntegerFilterWidget * w = new KisMultiIntegerFilterWidget(id().id(),  parent,  id().id(),  param);
     w->setConfiguration(factoryConfiguration());
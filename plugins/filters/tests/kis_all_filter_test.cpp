@@ -23,9 +23,12 @@
 #include "kis_selection.h"
 #include "kis_processing_information.h"
 #include "filter/kis_filter.h"
+#include "filter/kis_color_transformation_filter.h"
 #include "kis_pixel_selection.h"
 #include "kis_transaction.h"
 #include <KoColorSpaceRegistry.h>
+#include <KoColorTransformation.h>
+#include "kis_sequential_iterator.h"
 #include <sdk/tests/qimage_test_util.h>
 #include <sdk/tests/testing_timed_default_bounds.h>
 
@@ -284,5 +287,93 @@ void KisAllFilterTest::testAllFiltersWithSelections()
 }
 
 
+void KisAllFilterTest::testBakedColorTransformations_data()
+{
+    QTest::addColumn<QString>("filterId");
+    QTest::addColumn<bool>("use16Bit");
+
+    QStringList filterIds;
+    filterIds << "colorbalance" << "hsvadjustment" << "levels";
+
+    Q_FOREACH (const QString &filterId, filterIds) {
+        QTest::newRow(QString("%1-rgb8").arg(filterId).toLatin1()) << filterId << false;
+        QTest::newRow(QString("%1-rgb16").arg(filterId).toLatin1()) << filterId << true;
+    }
+}
+
+void KisAllFilterTest::testBakedColorTransformations()
+{
+    QFETCH(QString, filterId);
+    QFETCH(bool, use16Bit);
+
+    const KoColorSpace *cs =
+        use16Bit ?
+        KoColorSpaceRegistry::instance()->rgb16() :
+        KoColorSpaceRegistry::instance()->rgb8();
+
+    KisFilterSP f = KisFilterRegistry::instance()->value(filterId);
+    QVERIFY(f);
+
+    const KisColorTransformationFilter *filter =
+        dynamic_cast<const KisColorTransformationFilter*>(f.data());
+    QVERIFY(filter);
+
+    KisFilterConfigurationSP kfc = f->defaultConfiguration();
+
+    QFile file(QString(FILES_DATA_DIR) + QDir::separator() + f->id() + ".cfg");
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+    kfc->fromXML(in.readAll());
+
+    QVERIFY(filter->canBakeTransformation(cs, kfc));
+
+    QImage qimage(QString(FILES_DATA_DIR) + QDir::separator() + "carrot.png");
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    dev->setDefaultBounds(new TestUtil::TestingTimedDefaultBounds(qimage.rect()));
+    dev->convertFromQImage(qimage, 0, 0, 0);
+
+    KisPaintDeviceSP exactDev = new KisPaintDevice(*dev);
+
+    /**
+     * The filter goes through the transformation cached by the
+     * configuration, which is baked when it is precise enough. The
+     * reference is evaluated exactly, pixel by pixel.
+     */
+    f->process(dev, qimage.rect(), kfc);
+
+    QScopedPointer<KoColorTransformation> exactTransformation(filter->createTransformation(cs, kfc));
+    QVERIFY(exactTransformation);
+
+    KisSequentialIterator it(exactDev, qimage.rect());
+    while (it.nextPixel()) {
+        exactTransformation->transform(it.rawData(), it.rawData(), 1);
+    }
+
+    const int numBytes = qimage.width() * qimage.height() * cs->pixelSize();
+    QVector<quint8> result(numBytes);
+    QVector<quint8> reference(numBytes);
+    dev->readBytes(result.data(), qimage.rect());
+    exactDev->readBytes(reference.data(), qimage.rect());
+
+    int maxDifference = 0;
+
+    if (use16Bit) {
+        const quint16 *resultPtr = reinterpret_cast<const quint16*>(result.constData());
+        const quint16 *referencePtr = reinterpret_cast<const quint16*>(reference.constData());
+        for (int i = 0; i < numBytes / 2; i++) {
+            maxDifference = qMax(maxDifference, qAbs(int(resultPtr[i]) - int(referencePtr[i])));
+        }
+    } else {
+        for (int i = 0; i < numBytes; i++) {
+            maxDifference = qMax(maxDifference, qAbs(int(result[i]) - int(reference[i])));
+        }
+    }
+
+    // a few code values in 16-bit, one code value in 8-bit
+    QVERIFY2(maxDifference <= (use16Bit ? 4 : 1),
+             QString("max difference: %1").arg(maxDifference).toLatin1());
+}
+
 
 QTEST_MAIN(KisAllFilterTest)
@@ -30,6 +30,9 @@ private Q_SLOTS:
     void testAllFilters();
     void testAllFiltersSrcNotIsDev();
     void testAllFiltersWithSelections();
+
+    void testBakedColorTransformations_data();
+    void testBakedColorTransformations();
 };
 
 #endif
@@ -21,6 +21,9 @@
 #include <cmath>
 #include <memory>
 #include <QRect>
+#include <QMutex>
+#include <QThread>
+#include <QtConcurrentMap>
 
 #include <KoColorSpaceRegistry.h>
 #include <KoColor.h>
@@ -342,7 +345,7 @@ KisSpacingInformation KisColorSmudgeOp::paintAt(const KisPaintInformation& info)
 
     // then blit the temporary painting device on the canvas at the current brush position
     // the alpha mask (maskDab) will be used here to only blit the pixels that are in the area (shape) of the brush
-    m_finalPainter->bitBltWithFixedSelection(m_dstDabRect.x(), m_dstDabRect.y(), m_tempDev, m_maskDab, m_dstDabRect.width(), m_dstDabRect.height());
+    blitFinalDab();
     m_finalPainter->renderMirrorMaskSafe(m_dstDabRect, m_tempDev, 0, 0, m_maskDab, !m_dabCache->needSeparateOriginal());
 
     const QVector<QRect> dirtyRects = m_finalPainter->takeDirtyRegion();
@@ -352,6 +355,69 @@ KisSpacingInformation KisColorSmudgeOp::paintAt(const KisPaintInformation& info)
     return spacingInfo;
 }
 
+void KisColorSmudgeOp::blitFinalDab()
+{
+    /**
+     * All the data the dab depends on has already been read into
+     * m_tempDev, so the stripes of the dab are independent from each
+     * other and the read-after-write order between the dabs is kept.
+     *
+     * Mirrored strokes keep the single threaded path: their copies of the
+     * dab may overlap the dab itself and are rendered by the same painter
+     * right after it (see the TODO about the overlay mode above).
+     */
+    const int minPixelsForThreading = 256 * 256;
+    const int stripeHeight = 64; // the height of a tile
+
+    const int numStripes = m_dstDabRect.height() / stripeHeight;
+
+    if (m_dstDabRect.width() * m_dstDabRect.height() < minPixelsForThreading ||
+        numStripes < 2 || QThread::idealThreadCount() < 2 ||
+        m_finalPainter->hasMirroring()) {
+
+        m_finalPainter->bitBltWithFixedSelection(m_dstDabRect.x(), m_dstDabRect.y(), m_tempDev, m_maskDab, m_dstDabRect.width(), m_dstDabRect.height());
+        return;
+    }
+
+    // align the stripes to the tiles of the destination device
+    QVector<QRect> stripes;
+    int top = 0;
+    int nextTop = stripeHeight - (m_dstDabRect.y() % stripeHeight + stripeHeight) % stripeHeight;
+    while (top < m_dstDabRect.height()) {
+        const int bottom = qMin(nextTop, m_dstDabRect.height());
+        stripes << QRect(0, top, m_dstDabRect.width(), bottom - top);
+        top = bottom;
+        nextTop += stripeHeight;
+    }
+
+    QMutex dirtyRectsLock;
+    QVector<QRect> dirtyRects;
+
+    KisPaintDeviceSP dstDevice = m_finalPainter->device();
+    KisSelectionSP selection = m_finalPainter->selection();
+    const KoCompositeOp *compositeOp = m_finalPainter->compositeOp();
+    const quint8 opacity = m_finalPainter->opacity();
+    const QBitArray channelFlags = m_finalPainter->channelFlags();
+
+    QtConcurrent::blockingMap(stripes, [&] (const QRect &stripe) {
+        KisPainter gc(dstDevice, selection);
+        gc.setCompositeOp(compositeOp);
+        gc.setOpacity(opacity);
+        gc.setChannelFlags(channelFlags);
+
+        gc.bitBltWithFixedSelection(m_dstDabRect.x() + stripe.x(), m_dstDabRect.y() + stripe.y(),
+                                    m_tempDev, m_maskDab,
+                                    stripe.x(), stripe.y(),
+                                    stripe.x(), stripe.y(),
+                                    stripe.width(), stripe.height());
+
+        QMutexLocker l(&dirtyRectsLock);
+        dirtyRects += gc.takeDirtyRegion();
+    });
+
+    m_finalPainter->addDirtyRects(dirtyRects);
+}
+
 KisSpacingInformation KisColorSmudgeOp::updateSpacingImpl(const KisPaintInformation &info) const
 {
     const qreal scale = m_sizeOption.apply(info) * KisLodTransform::lodToScale(painter()->device());
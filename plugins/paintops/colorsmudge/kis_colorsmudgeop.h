@@ -61,6 +61,13 @@ private:
 
     inline void getTopLeftAligned(const QPointF &pos, const QPointF &hotSpot, qint32 *x, qint32 *y);
 
+    /**
+     * Blits m_tempDev through m_maskDab onto the canvas at m_dstDabRect.
+     * Big dabs are split into horizontal stripes which are composited
+     * concurrently.
+     */
+    void blitFinalDab();
+
 private:
     bool                      m_firstRun;
     KisImageWSP               m_image;
@@ -37,14 +37,10 @@
 #include <kis_pressure_rate_option.h>
 #include <kis_brush_based_paintop_settings.h>
 
-#include <KisRollingMeanAccumulatorWrapper.h>
-
-#include <QElapsedTimer>
-
 class KisPainter;
 class KisColorSource;
 class KisDabRenderingExecutor;
-struct KisRenderedDab;
+class KisDabRenderingUpdater;
 class KisRunnableStrokeJobData;
 
 class KisBrushOp : public KisBrushBasedPaintOp
@@ -66,17 +62,6 @@ protected:
 
     KisTimingInformation updateTimingImpl(const KisPaintInformation &info) const override;
 
-    struct UpdateSharedState;
-    typedef QSharedPointer<UpdateSharedState> UpdateSharedStateSP;
-
-    void addMirroringJobs(Qt::Orientation direction,
-                          QVector<QRect> &rects,
-                          UpdateSharedStateSP state,
-                          QVector<KisRunnableStrokeJobData*> &jobs);
-
-    UpdateSharedStateSP m_updateSharedState;
-
-
 private:
     KisAirbrushOptionProperties m_airbrushOption;
     KisPressureSizeOption m_sizeOption;
@@ -93,15 +78,7 @@ private:
     KisPaintDeviceSP m_lineCacheDevice;
 
     QScopedPointer<KisDabRenderingExecutor> m_dabExecutor;
-    qreal m_currentUpdatePeriod = 20.0;
-    KisRollingMeanAccumulatorWrapper m_avgSpacing;
-    KisRollingMeanAccumulatorWrapper m_avgNumDabs;
-    KisRollingMeanAccumulatorWrapper m_avgUpdateTimePerDab;
-
-    const int m_idealNumRects;
-
-    const int m_minUpdatePeriod;
-    const int m_maxUpdatePeriod;
+    QScopedPointer<KisDabRenderingUpdater> m_dabUpdater;
 };
 
 #endif // KIS_BRUSHOP_H_
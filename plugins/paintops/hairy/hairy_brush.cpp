@@ -26,6 +26,7 @@
 #include <QVariant>
 #include <QHash>
 #include <QVector>
+#include <QLineF>
 
 #include <kis_types.h>
 #include <kis_random_accessor_ng.h>
@@ -35,6 +36,7 @@
 
 #include <cmath>
 #include <ctime>
+#include <limits>
 
 
 HairyBrush::HairyBrush()
@@ -168,6 +170,20 @@ void HairyBrush::paintLine(KisPaintDeviceSP dab, KisPaintDeviceSP layer, const K
     int bristleCount = m_bristles.size();
     int bristlePathSize;
     qreal threshold = 1.0 - pi2.pressure();
+
+    /**
+     * First pass: place all the bristles. It consumes the random numbers
+     * in the same order as before and finds the area the bristles are
+     * going to touch.
+     */
+    QVector<QLineF> bristleSegments(bristleCount);
+    QVector<bool> bristleIsPainted(bristleCount, false);
+
+    qreal minX = std::numeric_limits<qreal>::max();
+    qreal minY = std::numeric_limits<qreal>::max();
+    qreal maxX = std::numeric_limits<qreal>::lowest();
+    qreal maxY = std::numeric_limits<qreal>::lowest();
+
     for (int i = 0; i < bristleCount; i++) {
 
         if (!m_bristles.at(i)->enabled()) continue;
@@ -208,8 +224,48 @@ void HairyBrush::paintLine(KisPaintDeviceSP dab, KisPaintDeviceSP layer, const K
         fy2 += y2;
 
         if (m_properties->threshold && (bristle->length() < threshold)) continue;
+
+        bristleSegments[i] = QLineF(fx1, fy1, fx2, fy2);
+        bristleIsPainted[i] = true;
+
+        minX = qMin(minX, qMin(fx1, fx2));
+        minY = qMin(minY, qMin(fy1, fy2));
+        maxX = qMax(maxX, qMax(fx1, fx2));
+        maxY = qMax(maxY, qMax(fy1, fy2));
+    }
+
+    const bool hasPaintedBristles = minX <= maxX;
+
+    /**
+     * Particles touch the pixel to the right and below of the sample
+     * point, and int() truncates towards zero for negative coordinates,
+     * so add a margin around the bounds
+     */
+    const QRect bufferRect = hasPaintedBristles ?
+        QRect(QPoint(std::floor(minX) - 2, std::floor(minY) - 2),
+              QPoint(std::ceil(maxX) + 2, std::ceil(maxY) + 2)) : QRect();
+
+    // very fast strokes might cover huge areas, use the accessor for them
+    const int maxBufferPixels = 4096 * 1024;
+    m_useDabBuffer =
+        hasPaintedBristles &&
+        qint64(bufferRect.width()) * bufferRect.height() <= maxBufferPixels;
+
+    if (m_useDabBuffer) {
+        m_dabBufferRect = bufferRect;
+        m_dabBuffer.resize(bufferRect.width() * bufferRect.height() * m_pixelSize);
+        dab->readBytes(m_dabBuffer.data(), m_dabBufferRect);
+    }
+
+    // Second pass: paint the bristles in the same order as the first one
+    for (int i = 0; i < bristleCount; i++) {
+        if (!bristleIsPainted[i]) continue;
+        const QLineF &segment = bristleSegments[i];
+
+        bristle = m_bristles[i];
+
         // paint between first and last dab
-        const QVector<QPointF> bristlePath = m_trajectory.getLinearTrajectory(QPointF(fx1, fy1), QPointF(fx2, fy2), 1.0);
+        const QVector<QPointF> bristlePath = m_trajectory.getLinearTrajectory(segment.p1(), segment.p2(), 1.0);
         bristlePathSize = m_trajectory.size();
 
         memcpy(bristleColor.data(), bristle->color().data() , m_pixelSize);
@@ -239,6 +295,12 @@ void HairyBrush::paintLine(KisPaintDeviceSP dab, KisPaintDeviceSP layer, const K
         }
 
     }
+
+    if (m_useDabBuffer) {
+        dab->writeBytes(m_dabBuffer.constData(), m_dabBufferRect);
+        m_useDabBuffer = false;
+    }
+
     m_dab = 0;
     m_dabAccessor = 0;
 }
@@ -341,25 +403,25 @@ void HairyBrush::paintParticle(QPointF pos, const KoColor& color, qreal weight)
 
     const KoColorSpace * cs = m_dab->colorSpace();
 
-    m_dabAccessor->moveTo(ipx  , ipy);
-    btl = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btl + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), btl, 1);
-
-    m_dabAccessor->moveTo(ipx + 1, ipy);
-    btr =  quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btr + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), btr, 1);
-
-    m_dabAccessor->moveTo(ipx, ipy + 1);
-    bbl = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbl + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), bbl, 1);
-
-    m_dabAccessor->moveTo(ipx + 1, ipy + 1);
-    bbr = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbr + cs->opacityU8(m_dabAccessor->rawData()), OPACITY_OPAQUE_U8));
-    memcpy(m_dabAccessor->rawData(), color.data(), cs->pixelSize());
-    cs->setOpacity(m_dabAccessor->rawData(), bbr, 1);
+    quint8 *pixel = dabPixel(ipx  , ipy);
+    btl = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btl + cs->opacityU8(pixel), OPACITY_OPAQUE_U8));
+    memcpy(pixel, color.data(), cs->pixelSize());
+    cs->setOpacity(pixel, btl, 1);
+
+    pixel = dabPixel(ipx + 1, ipy);
+    btr =  quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btr + cs->opacityU8(pixel), OPACITY_OPAQUE_U8));
+    memcpy(pixel, color.data(), cs->pixelSize());
+    cs->setOpacity(pixel, btr, 1);
+
+    pixel = dabPixel(ipx, ipy + 1);
+    bbl = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbl + cs->opacityU8(pixel), OPACITY_OPAQUE_U8));
+    memcpy(pixel, color.data(), cs->pixelSize());
+    cs->setOpacity(pixel, bbl, 1);
+
+    pixel = dabPixel(ipx + 1, ipy + 1);
+    bbr = quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbr + cs->opacityU8(pixel), OPACITY_OPAQUE_U8));
+    memcpy(pixel, color.data(), cs->pixelSize());
+    cs->setOpacity(pixel, bbr, 1);
 }
 
 void HairyBrush::paintParticle(QPointF pos, const KoColor& color)
@@ -392,17 +454,28 @@ void HairyBrush::paintParticle(QPointF pos, const KoColor& color)
 }
 
 
+inline quint8* HairyBrush::dabPixel(int x, int y)
+{
+    // the pixels outside the buffer (if any) go directly to the dab
+    if (m_useDabBuffer && m_dabBufferRect.contains(x, y)) {
+        return m_dabBuffer.data() +
+            ((y - m_dabBufferRect.y()) * m_dabBufferRect.width() + (x - m_dabBufferRect.x())) * m_pixelSize;
+    }
+
+    m_dabAccessor->moveTo(x, y);
+    return m_dabAccessor->rawData();
+}
+
 inline void HairyBrush::plotPixel(int wx, int wy, const KoColor &color)
 {
-    m_dabAccessor->moveTo(wx, wy);
-    m_compositeOp->composite(m_dabAccessor->rawData(), m_pixelSize, color.data() , m_pixelSize, 0, 0, 1, 1, OPACITY_OPAQUE_U8);
+    m_compositeOp->composite(dabPixel(wx, wy), m_pixelSize, color.data() , m_pixelSize, 0, 0, 1, 1, OPACITY_OPAQUE_U8);
 }
 
 inline void HairyBrush::darkenPixel(int wx, int wy, const KoColor &color)
 {
-    m_dabAccessor->moveTo(wx, wy);
-    if (m_dab->colorSpace()->opacityU8(m_dabAccessor->rawData()) < color.opacityU8()) {
-        memcpy(m_dabAccessor->rawData(), color.data(), m_pixelSize);
+    quint8 *pixel = dabPixel(wx, wy);
+    if (m_dab->colorSpace()->opacityU8(pixel) < color.opacityU8()) {
+        memcpy(pixel, color.data(), m_pixelSize);
     }
 }
 
@@ -112,6 +112,9 @@ private:
 
     void initAndCache();
 
+    /// returns the pointer to the pixel of the dab at (x, y)
+    inline quint8* dabPixel(int x, int y);
+
 private:
     const KisHairyProperties * m_properties;
 
@@ -124,6 +127,15 @@ private:
     // temporary device
     KisPaintDeviceSP m_dab;
     KisRandomAccessorSP m_dabAccessor;
+
+    /**
+     * All the bristles of one paintLine() call are rendered into this
+     * plain buffer, which is written into the dab at once. It saves a
+     * random accessor lookup for every pixel of every bristle.
+     */
+    QVector<quint8> m_dabBuffer;
+    QRect m_dabBufferRect;
+    bool m_useDabBuffer {false};
     const KoCompositeOp * m_compositeOp;
     quint32 m_pixelSize;
 
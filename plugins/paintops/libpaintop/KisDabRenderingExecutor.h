@@ -19,7 +19,7 @@
 #ifndef KISDABRENDERINGEXECUTOR_H
 #define KISDABRENDERINGEXECUTOR_H
 
-#include "kritadefaultpaintops_export.h"
+#include "kritapaintop_export.h"
 
 #include <QScopedPointer>
 
@@ -32,8 +32,16 @@ class KisPressureMirrorOption;
 class KisPrecisionOption;
 class KisRunnableStrokeJobsInterface;
 
-
-class KRITADEFAULTPAINTOPS_EXPORT KisDabRenderingExecutor
+/**
+ * Renders the dabs of a brush-based paintop asynchronously in the stroke's
+ * worker threads. The paintop only provides a factory of its
+ * DabRenderingResources (brush clone, color source, texture, etc.) and
+ * feeds the requests via addDab(). The ready dabs are fetched with
+ * takeReadyDabs() and blitted with KisPainter::bltFixed() in a batch by
+ * KisDabRenderingUpdater. See KisBrushOp and KisTangentNormalPaintOp
+ * for examples.
+ */
+class PAINTOP_EXPORT KisDabRenderingExecutor
 {
 public:
     KisDabRenderingExecutor(const KoColorSpace *cs,
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KISDABRENDERINGUPDATER_H
+#define KISDABRENDERINGUPDATER_H
+
+#include "kritapaintop_export.h"
+
+#include <QScopedPointer>
+#include <QVector>
+#include <utility>
+
+class KisPainter;
+class KisDabRenderingExecutor;
+class KisRunnableStrokeJobData;
+
+/**
+ * Commits the dabs prepared by KisDabRenderingExecutor onto the painter's
+ * device. It implements KisPaintOp::doAsyncronousUpdate() for the paintops
+ * using the executor: the ready dabs are split into non-overlapping rects
+ * that are blitted with KisPainter::bltFixed() in parallel, mirrored and
+ * wrapped if needed. The update period adapts to the measured rendering
+ * time of the dabs.
+ *
+ * The paintop reports the spacing of every dab it adds to the executor
+ * with addDabSpacing() and forwards doAsyncronousUpdate() calls.
+ */
+class PAINTOP_EXPORT KisDabRenderingUpdater
+{
+public:
+    KisDabRenderingUpdater(KisDabRenderingExecutor *executor);
+    ~KisDabRenderingUpdater();
+
+    void addDabSpacing(qreal spacing);
+
+    std::pair<int, bool> doAsyncronousUpdate(KisPainter *painter, QVector<KisRunnableStrokeJobData *> &jobs);
+
+private:
+    KisDabRenderingUpdater(const KisDabRenderingUpdater &rhs) = delete;
+
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISDABRENDERINGUPDATER_H
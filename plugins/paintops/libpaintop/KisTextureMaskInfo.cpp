@@ -105,6 +105,10 @@ QRect KisTextureMaskInfo::maskBounds() const {
     return m_maskBounds;
 }
 
+const quint8 *KisTextureMaskInfo::maskData() const {
+    return m_maskData.constData();
+}
+
 bool KisTextureMaskInfo::fillProperties(const KisPropertiesConfigurationSP setting)
 {
 
@@ -201,6 +205,9 @@ void KisTextureMaskInfo::recalculateMask()
     }
 
     m_maskBounds = QRect(0, 0, width, height);
+
+    m_maskData.resize(width * height);
+    m_mask->readBytes(m_maskData.data(), m_maskBounds);
 }
 
 /**********************************************************************/
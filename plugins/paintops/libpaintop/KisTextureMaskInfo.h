@@ -23,6 +23,7 @@
 #include <kis_paint_device.h>
 #include <QSharedPointer>
 #include <QMutex>
+#include <QVector>
 
 
 #include <boost/operators.hpp>
@@ -50,6 +51,13 @@ public:
 
     QRect maskBounds() const;
 
+    /**
+     * Returns the mask as a plain array of maskBounds().width() x
+     * maskBounds().height() alpha values, which is much faster to
+     * sample than the paint device
+     */
+    const quint8* maskData() const;
+
     bool fillProperties(const KisPropertiesConfigurationSP setting);
 
     void recalculateMask();
@@ -70,6 +78,7 @@ private:
 
     KisPaintDeviceSP m_mask;
     QRect m_maskBounds;
+    QVector<quint8> m_maskData;
 
 };
 
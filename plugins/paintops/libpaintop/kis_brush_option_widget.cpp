@@ -23,7 +23,29 @@
 
 #include "kis_brush_selection_widget.h"
 #include "kis_brush.h"
+#include "kis_auto_brush.h"
+#include <KisQImagePyramidCache.h>
 
+namespace {
+
+/**
+ * Predefined brushes might have huge tips, so their pyramids are
+ * prepared while the user is still choosing where to paint. The strokes
+ * read the brush option on their own, so it is done only when the brush
+ * is changed in the GUI.
+ */
+void prebuildPyramid(KisBrushSP brush)
+{
+    if (brush &&
+        !dynamic_cast<KisAutoBrush*>(brush.data()) &&
+        brush->brushType() != PIPE_MASK &&
+        brush->brushType() != PIPE_IMAGE) {
+
+        KisQImagePyramidCache::instance()->prebuildPyramid(brush);
+    }
+}
+
+}
 
 KisBrushOptionWidget::KisBrushOptionWidget()
     : KisPaintOpOption(KisPaintOpOption::GENERAL, true)
@@ -85,6 +107,7 @@ void KisBrushOptionWidget::readOptionSetting(const KisPropertiesConfigurationSP
     m_brushSelectionWidget->readOptionSetting(setting);
     m_brushOption.readOptionSetting(setting);
     m_brushSelectionWidget->setCurrentBrush(m_brushOption.brush());
+    prebuildPyramid(m_brushOption.brush());
 }
 
 void KisBrushOptionWidget::lodLimitations(KisPaintopLodLimitations *l) const
@@ -96,6 +119,7 @@ void KisBrushOptionWidget::lodLimitations(KisPaintopLodLimitations *l) const
 void KisBrushOptionWidget::brushChanged()
 {
     m_brushOption.setBrush(brush());
+    prebuildPyramid(brush());
     emitSettingChanged();
 }
 
@@ -38,7 +38,6 @@
 #include <kis_multipliers_double_slider_spinbox.h>
 #include <resources/KoPattern.h>
 #include <kis_paint_device.h>
-#include <kis_fill_painter.h>
 #include <kis_painter.h>
 #include <kis_iterator_ng.h>
 #include <kis_fixed_paint_device.h>
@@ -230,44 +229,62 @@ void KisTextureProperties::apply(KisFixedPaintDeviceSP dab, const QPoint &offset
 {
     if (!m_enabled) return;
 
-    KisPaintDeviceSP fillDevice = new KisPaintDevice(KoColorSpaceRegistry::instance()->alpha8());
-    QRect rect = dab->bounds();
-
-    KisPaintDeviceSP mask = m_maskInfo->mask();
+    const QRect rect = dab->bounds();
     const QRect maskBounds = m_maskInfo->maskBounds();
+    const quint8 *maskData = m_maskInfo->maskData();
 
-    KIS_SAFE_ASSERT_RECOVER_RETURN(mask);
+    KIS_SAFE_ASSERT_RECOVER_RETURN(maskData && !maskBounds.isEmpty());
 
-    int x = offset.x() % maskBounds.width() - m_offsetX;
-    int y = offset.y() % maskBounds.height() - m_offsetY;
+    const int maskWidth = maskBounds.width();
+    const int maskHeight = maskBounds.height();
 
+    auto wrapCoordinate = [] (int value, int size) {
+        const int result = value % size;
+        return result >= 0 ? result : result + size;
+    };
 
-    KisFillPainter fillPainter(fillDevice);
-    fillPainter.fillRect(x - 1, y - 1, rect.width() + 2, rect.height() + 2, mask, maskBounds);
-    fillPainter.end();
+    const int x = wrapCoordinate(offset.x() % maskWidth - m_offsetX, maskWidth);
+    const int y = wrapCoordinate(offset.y() % maskHeight - m_offsetY, maskHeight);
 
     qreal pressure = m_strengthOption.apply(info);
+    const KoColorSpace *cs = dab->colorSpace();
+    const int pixelSize = dab->pixelSize();
     quint8 *dabData = dab->data();
 
-    KisHLineIteratorSP iter = fillDevice->createHLineIteratorNG(x, y, rect.width());
+    // one row of the wrapped pattern aligned with the dab
+    QVector<quint8> maskRow(rect.width());
+
     for (int row = 0; row < rect.height(); ++row) {
-        for (int col = 0; col < rect.width(); ++col) {
-            if (m_texturingMode == MULTIPLY) {
-                dab->colorSpace()->multiplyAlpha(dabData, quint8(*iter->oldRawData() * pressure), 1);
+        const quint8 *srcRow = maskData + ((y + row) % maskHeight) * maskWidth;
+
+        int srcX = x;
+        int col = 0;
+        while (col < rect.width()) {
+            const int numPixels = qMin(maskWidth - srcX, rect.width() - col);
+            memcpy(maskRow.data() + col, srcRow + srcX, numPixels);
+            col += numPixels;
+            srcX = 0;
+        }
+
+        if (m_texturingMode == MULTIPLY) {
+            for (int i = 0; i < rect.width(); ++i) {
+                maskRow[i] = quint8(maskRow[i] * pressure);
             }
-            else {
-                int pressureOffset = (1.0 - pressure) * 255;
+            cs->applyAlphaU8Mask(dabData, maskRow.constData(), rect.width());
+            dabData += rect.width() * pixelSize;
+        }
+        else {
+            int pressureOffset = (1.0 - pressure) * 255;
 
-                qint16 maskA = *iter->oldRawData() + pressureOffset;
-                quint8 dabA = dab->colorSpace()->opacityU8(dabData);
+            for (int i = 0; i < rect.width(); ++i) {
+                qint16 maskA = maskRow[i] + pressureOffset;
+                quint8 dabA = cs->opacityU8(dabData);
 
                 dabA = qMax(0, (qint16)dabA - maskA);
-                dab->colorSpace()->setOpacity(dabData, dabA, 1);
-            }
+                cs->setOpacity(dabData, dabA, 1);
 
-            iter->nextPixel();
-            dabData += dab->pixelSize();
+                dabData += pixelSize;
+            }
         }
-        iter->nextRow();
     }
 }
@@ -25,12 +25,15 @@
 #include <KoColor.h>
 
 #include <math.h>
+#include <limits>
 
 const qreal TIME = 0.000030;
 
 ParticleBrush::ParticleBrush()
 {
     m_properties = 0;
+    m_pixelSize = 0;
+    m_useDabBuffer = false;
 }
 
 ParticleBrush::~ParticleBrush()
@@ -55,7 +58,7 @@ void ParticleBrush::setInitialPosition(const QPointF &pos)
 }
 
 
-void ParticleBrush::paintParticle(KisRandomAccessorSP accWrite, const KoColorSpace * cs, const QPointF &pos, const KoColor& color, qreal weight, bool respectOpacity)
+void ParticleBrush::paintParticle(const KoColorSpace * cs, const QPointF &pos, const KoColor& color, qreal weight, bool respectOpacity)
 {
     // opacity top left, right, bottom left, right
     KoColor myColor(color);
@@ -71,29 +74,38 @@ void ParticleBrush::paintParticle(KisRandomAccessorSP accWrite, const KoColorSpa
     quint8 bbl = qRound((1.0 - fx) * (fy)  * opacity * weight);
     quint8 bbr = qRound((fx)  * (fy)  * opacity * weight);
 
-    accWrite->moveTo(ipx  , ipy);
-    myColor.setOpacity(quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btl + cs->opacityU8(accWrite->rawData()), OPACITY_OPAQUE_U8)));
-    memcpy(accWrite->rawData(), myColor.data(), cs->pixelSize());
+    quint8 *pixel = dabPixel(ipx, ipy);
+    myColor.setOpacity(quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btl + cs->opacityU8(pixel), OPACITY_OPAQUE_U8)));
+    memcpy(pixel, myColor.data(), cs->pixelSize());
 
-    accWrite->moveTo(ipx + 1, ipy);
-    myColor.setOpacity(quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btr + cs->opacityU8(accWrite->rawData()), OPACITY_OPAQUE_U8)));
-    memcpy(accWrite->rawData(), myColor.data(), cs->pixelSize());
+    pixel = dabPixel(ipx + 1, ipy);
+    myColor.setOpacity(quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, btr + cs->opacityU8(pixel), OPACITY_OPAQUE_U8)));
+    memcpy(pixel, myColor.data(), cs->pixelSize());
 
-    accWrite->moveTo(ipx, ipy + 1);
-    myColor.setOpacity(quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbl + cs->opacityU8(accWrite->rawData()), OPACITY_OPAQUE_U8)));
-    memcpy(accWrite->rawData(), myColor.data(), cs->pixelSize());
+    pixel = dabPixel(ipx, ipy + 1);
+    myColor.setOpacity(quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbl + cs->opacityU8(pixel), OPACITY_OPAQUE_U8)));
+    memcpy(pixel, myColor.data(), cs->pixelSize());
 
-    accWrite->moveTo(ipx + 1, ipy + 1);
-    myColor.setOpacity(quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbr + cs->opacityU8(accWrite->rawData()), OPACITY_OPAQUE_U8)));
-    memcpy(accWrite->rawData(), myColor.data(), cs->pixelSize());
+    pixel = dabPixel(ipx + 1, ipy + 1);
+    myColor.setOpacity(quint8(qBound<quint16>(OPACITY_TRANSPARENT_U8, bbr + cs->opacityU8(pixel), OPACITY_OPAQUE_U8)));
+    memcpy(pixel, myColor.data(), cs->pixelSize());
 }
 
+inline quint8* ParticleBrush::dabPixel(int x, int y)
+{
+    // the pixels outside the buffer (if any) go directly to the dab
+    if (m_useDabBuffer && m_dabBufferRect.contains(x, y)) {
+        return m_dabBuffer.data() +
+            ((y - m_dabBufferRect.y()) * m_dabBufferRect.width() + (x - m_dabBufferRect.x())) * m_pixelSize;
+    }
 
+    m_dabAccessor->moveTo(x, y);
+    return m_dabAccessor->rawData();
+}
 
 
 void ParticleBrush::draw(KisPaintDeviceSP dab, const KoColor& color, const QPointF &pos)
 {
-    KisRandomAccessorSP accessor = dab->createRandomAccessorNG(qRound(pos.x()), qRound(pos.y()));
     const KoColorSpace * cs = dab->colorSpace();
 
     QRect boundingRect;
@@ -102,6 +114,20 @@ void ParticleBrush::draw(KisPaintDeviceSP dab, const KoColor& color, const QPoin
         boundingRect = dab->defaultBounds()->bounds();
     }
 
+    /**
+     * The particles are moved first and painted afterwards, so that the
+     * whole dab can be accumulated in a local buffer and written to the
+     * device at once. The painting order is kept, so the accumulated
+     * opacity stays exactly the same.
+     */
+    m_paintedPositions.clear();
+    m_paintedPositions.reserve(int(m_properties->iterations) * m_properties->particleCount);
+
+    qreal minX = std::numeric_limits<qreal>::max();
+    qreal minY = std::numeric_limits<qreal>::max();
+    qreal maxX = std::numeric_limits<qreal>::lowest();
+    qreal maxY = std::numeric_limits<qreal>::lowest();
+
     for (int i = 0; i < m_properties->iterations; i++) {
         for (int j = 0; j < m_properties->particleCount; j++) {
             /*
@@ -141,11 +167,49 @@ void ParticleBrush::draw(KisPaintDeviceSP dab, const KoColor& color, const QPoin
             if (boundingRect.isEmpty() ||
                     boundingRect.contains(m_particlePos[j].toPoint())) {
 
-                paintParticle(accessor, cs, m_particlePos[j], color, m_properties->weight, true);
+                const QPointF &particlePos = m_particlePos[j];
+                m_paintedPositions.append(particlePos);
+
+                minX = qMin(minX, particlePos.x());
+                minY = qMin(minY, particlePos.y());
+                maxX = qMax(maxX, particlePos.x());
+                maxY = qMax(maxY, particlePos.y());
             }
 
         }//for j
     }//for i
+
+    if (m_paintedPositions.isEmpty()) return;
+
+    m_pixelSize = cs->pixelSize();
+    m_dabAccessor = dab->createRandomAccessorNG(qRound(pos.x()), qRound(pos.y()));
+
+    // the particle touches the pixel to the right and below of its position
+    const QRect bufferRect(QPoint(std::floor(minX) - 1, std::floor(minY) - 1),
+                           QPoint(std::ceil(maxX) + 1, std::ceil(maxY) + 1));
+
+    // unstable particles might fly far away, use the accessor for them
+    const int maxBufferPixels = 4096 * 1024;
+    m_useDabBuffer =
+        bufferRect.isValid() &&
+        qint64(bufferRect.width()) * bufferRect.height() <= maxBufferPixels;
+
+    if (m_useDabBuffer) {
+        m_dabBufferRect = bufferRect;
+        m_dabBuffer.resize(bufferRect.width() * bufferRect.height() * m_pixelSize);
+        dab->readBytes(m_dabBuffer.data(), m_dabBufferRect);
+    }
+
+    Q_FOREACH (const QPointF &particlePos, m_paintedPositions) {
+        paintParticle(cs, particlePos, color, m_properties->weight, true);
+    }
+
+    if (m_useDabBuffer) {
+        dab->writeBytes(m_dabBuffer.constData(), m_dabBufferRect);
+        m_useDabBuffer = false;
+    }
+
+    m_dabAccessor = 0;
 }
 
 
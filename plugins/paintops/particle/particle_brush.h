@@ -57,12 +57,25 @@ public:
 private:
     /// paints wu particle, similar to spray version but you can turn on respecting opacity of the tool and add weight to opacity
     /// also the particle respects opacity in the destination pixel buffer
-    void paintParticle(KisRandomAccessorSP writeAccessor, const KoColorSpace *cs,const QPointF &pos, const KoColor& color, qreal weight, bool respectOpacity);
+    void paintParticle(const KoColorSpace *cs,const QPointF &pos, const KoColor& color, qreal weight, bool respectOpacity);
+
+    /// returns the pointer to the pixel of the dab at (x, y)
+    inline quint8* dabPixel(int x, int y);
 
     QVector<QPointF> m_particlePos;
     QVector<QPointF> m_particleNextPos;
     QVector<qreal> m_accelaration;
 
+    // positions of the particles painted by the current dab
+    QVector<QPointF> m_paintedPositions;
+
+    // local copy of the area of the dab touched by the particles
+    QVector<quint8> m_dabBuffer;
+    QRect m_dabBufferRect;
+    bool m_useDabBuffer;
+    quint32 m_pixelSize;
+    KisRandomAccessorSP m_dabAccessor;
+
     KisParticleBrushProperties * m_properties;
 };
 
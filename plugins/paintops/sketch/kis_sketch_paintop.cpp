@@ -150,7 +150,7 @@ void KisSketchPaintOp::doPaintLine(const KisPaintInformation &pi1, const KisPain
 
     QPointF prevMouse = pi1.pos();
     QPointF mousePosition = pi2.pos();
-    m_points.append(mousePosition);
+    m_points.addPoint(mousePosition);
 
 
     const qreal lodAdditionalScale = KisLodTransform::lodToScale(painter()->device());
@@ -207,9 +207,21 @@ void KisSketchPaintOp::doPaintLine(const KisPaintInformation &pi1, const KisPain
     QPoint  positionInMask;
     QPointF diff;
 
-    int size = m_points.size();
+    // only the points inside the connection area can be connected
+    QRectF connectionArea;
+    if (m_sketchProperties.simpleMode) {
+        const qreal radius = std::sqrt(thresholdDistance);
+        connectionArea = QRectF(mousePosition - QPointF(radius, radius),
+                                QSizeF(2.0 * radius, 2.0 * radius));
+    }
+    else {
+        connectionArea = m_brushBoundingBox;
+    }
+
+    m_points.query(connectionArea, &m_candidatePoints);
+
     // MAIN LOOP
-    for (int i = 0; i < size; i++) {
+    Q_FOREACH (int i, m_candidatePoints) {
         diff = m_points.at(i) - mousePosition;
         distance = diff.x() * diff.x() + diff.y() * diff.y();
 
@@ -34,6 +34,7 @@
 #include <kis_pressure_rate_option.h>
 #include "kis_linewidth_option.h"
 #include "kis_offset_scale_option.h"
+#include "kis_sketch_point_index.h"
 
 class KisDabCache;
 
@@ -79,7 +80,8 @@ private:
     KisBrushOptionProperties m_brushOption;
     SketchProperties m_sketchProperties;
 
-    QVector<QPointF> m_points;
+    KisSketchPointIndex m_points;
+    QVector<int> m_candidatePoints;
     int m_count;
     KisPainter * m_painter;
     KisBrushSP m_brush;
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#include "kis_sketch_point_index.h"
+
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+
+
+KisSketchPointIndex::KisSketchPointIndex(qreal cellSize)
+    : m_cellSize(cellSize)
+{
+}
+
+void KisSketchPointIndex::clear()
+{
+    m_points.clear();
+    m_cells.clear();
+}
+
+inline QPoint KisSketchPointIndex::cellForPoint(const QPointF &pt) const
+{
+    return QPoint(std::floor(pt.x() / m_cellSize),
+                  std::floor(pt.y() / m_cellSize));
+}
+
+inline quint64 KisSketchPointIndex::cellKey(const QPoint &cell)
+{
+    return (quint64(quint32(cell.x())) << 32) | quint32(cell.y());
+}
+
+void KisSketchPointIndex::addPoint(const QPointF &pt)
+{
+    m_cells[cellKey(cellForPoint(pt))].append(m_points.size());
+    m_points.append(pt);
+}
+
+void KisSketchPointIndex::query(const QRectF &rect, QVector<int> *indices) const
+{
+    indices->clear();
+    if (m_points.isEmpty()) return;
+
+    const QPoint topLeftCell = cellForPoint(rect.topLeft());
+    const QPoint bottomRightCell = cellForPoint(rect.bottomRight());
+
+    const qint64 numQueryCells =
+        qint64(bottomRightCell.x() - topLeftCell.x() + 1) *
+        (bottomRightCell.y() - topLeftCell.y() + 1);
+
+    /**
+     * When the rect covers more cells than there are points, walking
+     * through the cells is slower than just returning everything
+     */
+    if (numQueryCells >= m_points.size() || numQueryCells >= m_cells.size()) {
+        indices->resize(m_points.size());
+        std::iota(indices->begin(), indices->end(), 0);
+        return;
+    }
+
+    for (int y = topLeftCell.y(); y <= bottomRightCell.y(); y++) {
+        for (int x = topLeftCell.x(); x <= bottomRightCell.x(); x++) {
+            auto it = m_cells.constFind(cellKey(QPoint(x, y)));
+            if (it != m_cells.constEnd()) {
+                *indices += *it;
+            }
+        }
+    }
+
+    std::sort(indices->begin(), indices->end());
+}
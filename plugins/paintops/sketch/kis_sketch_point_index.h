@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2026 The Krita Developers
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+#ifndef KIS_SKETCH_POINT_INDEX_H
+#define KIS_SKETCH_POINT_INDEX_H
+
+#include <QHash>
+#include <QPoint>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+/**
+ * A uniform grid over the points of the stroke, used by the sketch
+ * paintop to find the earlier points that can be connected to the
+ * current one without scanning the whole stroke history.
+ *
+ * The points are identified by their index in the history, and the
+ * queries return the indices in the ascending order, that is in the
+ * order the points were added.
+ */
+class KisSketchPointIndex
+{
+public:
+    KisSketchPointIndex(qreal cellSize = 64.0);
+
+    void clear();
+
+    /// adds a point with the index equal to the number of the points added before
+    void addPoint(const QPointF &pt);
+
+    int size() const {
+        return m_points.size();
+    }
+
+    const QPointF& at(int index) const {
+        return m_points.at(index);
+    }
+
+    /**
+     * Fills \p indices with the indices of all the points that might
+     * lie inside \p rect. Some points in the cells touching the border
+     * of \p rect may lie outside of it, so the caller should do its
+     * exact test anyway.
+     */
+    void query(const QRectF &rect, QVector<int> *indices) const;
+
+private:
+    inline QPoint cellForPoint(const QPointF &pt) const;
+    static inline quint64 cellKey(const QPoint &cell);
+
+private:
+    qreal m_cellSize;
+    QVector<QPointF> m_points;
+    QHash<quint64, QVector<int>> m_cells;
+};
+
+#endif // KIS_SKETCH_POINT_INDEX_H
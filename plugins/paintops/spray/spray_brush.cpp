@@ -45,6 +45,7 @@
 
 #include <cmath>
 #include <ctime>
+#include <limits>
 
 #include <QtGlobal>
 
@@ -133,7 +134,6 @@ void SprayBrush::paint(KisPaintDeviceSP dab, KisPaintDeviceSP source,
 
     qreal x = info.pos().x();
     qreal y = info.pos().y();
-    KisRandomAccessorSP accessor = dab->createRandomAccessorNG(qRound(x), qRound(y));
 
     Q_ASSERT(color.colorSpace()->pixelSize() == dab->pixelSize());
     m_inkColor = color;
@@ -291,15 +291,14 @@ void SprayBrush::paint(KisPaintDeviceSP dab, KisPaintDeviceSP source,
             }
             // wu-particle
             case 2: {
-                paintParticle(accessor, m_inkColor, nx + x, ny + y);
+                paintParticle(m_inkColor, nx + x, ny + y);
                 break;
             }
             // pixel
             case 3: {
                 ix = qRound(nx + x);
                 iy = qRound(ny + y);
-                accessor->moveTo(ix, iy);
-                memcpy(accessor->rawData(), m_inkColor.data(), m_dabPixelSize);
+                queuePixel(ix, iy, m_inkColor.data());
                 break;
             }
             case 4: {
@@ -374,13 +373,16 @@ void SprayBrush::paint(KisPaintDeviceSP dab, KisPaintDeviceSP source,
             m_inkColor=color;//reset color//
         }
     }
+
+    flushPendingPixels(dab);
+
     // recover from jittering of color,
     // m_inkColor.opacity is recovered with every paint
 }
 
 
 
-void SprayBrush::paintParticle(KisRandomAccessorSP &writeAccessor, const KoColor &color, qreal rx, qreal ry)
+void SprayBrush::paintParticle(const KoColor &color, qreal rx, qreal ry)
 {
     // opacity top left, right, bottom left, right
     KoColor pcolor(color);
@@ -401,20 +403,74 @@ void SprayBrush::paintParticle(KisRandomAccessorSP &writeAccessor, const KoColor
     // Maybe some kind of compositing using here would be cool
 
     pcolor.setOpacity(btl);
-    writeAccessor->moveTo(ipx  , ipy);
-    memcpy(writeAccessor->rawData(), pcolor.data(), m_dabPixelSize);
+    queuePixel(ipx, ipy, pcolor.data());
 
     pcolor.setOpacity(btr);
-    writeAccessor->moveTo(ipx + 1, ipy);
-    memcpy(writeAccessor->rawData(), pcolor.data(), m_dabPixelSize);
+    queuePixel(ipx + 1, ipy, pcolor.data());
 
     pcolor.setOpacity(bbl);
-    writeAccessor->moveTo(ipx, ipy + 1);
-    memcpy(writeAccessor->rawData(), pcolor.data(), m_dabPixelSize);
+    queuePixel(ipx, ipy + 1, pcolor.data());
 
     pcolor.setOpacity(bbr);
-    writeAccessor->moveTo(ipx + 1, ipy + 1);
-    memcpy(writeAccessor->rawData(), pcolor.data(), m_dabPixelSize);
+    queuePixel(ipx + 1, ipy + 1, pcolor.data());
+}
+
+void SprayBrush::queuePixel(int x, int y, const quint8 *color)
+{
+    m_pendingPixels.append(QPoint(x, y));
+    m_pendingColors.append(reinterpret_cast<const char*>(color), m_dabPixelSize);
+}
+
+void SprayBrush::flushPendingPixels(KisPaintDeviceSP dab)
+{
+    if (m_pendingPixels.isEmpty()) return;
+
+    int minX = std::numeric_limits<int>::max();
+    int minY = std::numeric_limits<int>::max();
+    int maxX = std::numeric_limits<int>::min();
+    int maxY = std::numeric_limits<int>::min();
+
+    Q_FOREACH (const QPoint &pt, m_pendingPixels) {
+        minX = qMin(minX, pt.x());
+        minY = qMin(minY, pt.y());
+        maxX = qMax(maxX, pt.x());
+        maxY = qMax(maxY, pt.y());
+    }
+
+    const QRect bufferRect(QPoint(minX, minY), QPoint(maxX, maxY));
+    const quint8 *color = reinterpret_cast<const quint8*>(m_pendingColors.constData());
+
+    /**
+     * The pixels are written in the order they were generated, so the
+     * later particles still overwrite the earlier ones exactly as if
+     * they were painted directly into the dab
+     */
+    const int maxBufferPixels = 4096 * 1024;
+    if (qint64(bufferRect.width()) * bufferRect.height() <= maxBufferPixels) {
+        QVector<quint8> buffer(bufferRect.width() * bufferRect.height() * m_dabPixelSize);
+        dab->readBytes(buffer.data(), bufferRect);
+
+        Q_FOREACH (const QPoint &pt, m_pendingPixels) {
+            quint8 *dst = buffer.data() +
+                ((pt.y() - bufferRect.y()) * bufferRect.width() + (pt.x() - bufferRect.x())) * m_dabPixelSize;
+            memcpy(dst, color, m_dabPixelSize);
+            color += m_dabPixelSize;
+        }
+
+        dab->writeBytes(buffer.constData(), bufferRect);
+    } else {
+        // sparse sprays with a huge radius, don't allocate the whole area
+        KisRandomAccessorSP accessor = dab->createRandomAccessorNG(minX, minY);
+
+        Q_FOREACH (const QPoint &pt, m_pendingPixels) {
+            accessor->moveTo(pt.x(), pt.y());
+            memcpy(accessor->rawData(), color, m_dabPixelSize);
+            color += m_dabPixelSize;
+        }
+    }
+
+    m_pendingPixels.clear();
+    m_pendingColors.clear();
 }
 
 void SprayBrush::paintCircle(KisPainter* painter, qreal x, qreal y, qreal radius)
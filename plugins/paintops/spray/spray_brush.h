@@ -32,6 +32,8 @@
 
 
 #include <QImage>
+#include <QVector>
+#include <QByteArray>
 #include <kis_brush.h>
 
 class KisPaintInformation;
@@ -73,11 +75,19 @@ private:
     KisBrushSP m_brush;
     KisFixedPaintDeviceSP m_fixedDab;
 
+    // pixel and wu-particle writes of the current dab
+    QVector<QPoint> m_pendingPixels;
+    QByteArray m_pendingColors;
+
 private:
     /// rotation in radians according the settings (gauss distribution, uniform distribution or fixed angle)
     qreal rotationAngle(KisRandomSourceSP randomSource);
     /// Paints Wu Particle
-    void paintParticle(KisRandomAccessorSP &writeAccessor, const KoColor &color, qreal rx, qreal ry);
+    void paintParticle(const KoColor &color, qreal rx, qreal ry);
+    /// queues a raw pixel write into the dab, the writes are committed by flushPendingPixels()
+    void queuePixel(int x, int y, const quint8 *color);
+    /// writes all the queued pixels into the dab at once
+    void flushPendingPixels(KisPaintDeviceSP dab);
     void paintCircle(KisPainter * painter, qreal x, qreal y, qreal radius);
     void paintEllipse(KisPainter * painter, qreal x, qreal y, qreal a, qreal b, qreal angle);
     void paintRectangle(KisPainter * painter, qreal x, qreal y, qreal width, qreal height, qreal angle);
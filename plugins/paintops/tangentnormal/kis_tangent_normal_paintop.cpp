@@ -32,6 +32,10 @@
 #include <kis_image.h>
 #include <kis_lod_transform.h>
 #include <kis_paintop_plugin_utils.h>
+#include <kis_texture_option.h>
+#include <KisDabCacheUtils.h>
+#include <KisDabRenderingExecutor.h>
+#include <KisDabRenderingUpdater.h>
 
 
 KisTangentNormalPaintOp::KisTangentNormalPaintOp(const KisPaintOpSettingsSP settings, KisPainter* painter, KisNodeSP node, KisImageSP image):
@@ -64,8 +68,40 @@ KisTangentNormalPaintOp::KisTangentNormalPaintOp(const KisPaintOpSettingsSP sett
     m_rotationOption.resetAllSensors();
     m_scatterOption.resetAllSensors();
 
-    m_dabCache->setSharpnessPostprocessing(&m_sharpnessOption);
     m_rotationOption.applyFanCornersInfo(this);
+
+    /**
+     * The dabs are rendered in the stroke's worker threads, so
+     * forbid the brushes to do threading internally
+     */
+    m_brush->setThreadingAllowed(false);
+
+    KisBrushSP baseBrush = m_brush;
+    auto resourcesFactory =
+        [baseBrush, settings, painter] () {
+            KisDabCacheUtils::DabRenderingResources *resources =
+                new KisDabCacheUtils::DabRenderingResources();
+            resources->brush = baseBrush->clone();
+
+            resources->sharpnessOption.reset(new KisPressureSharpnessOption());
+            resources->sharpnessOption->readOptionSetting(settings);
+            resources->sharpnessOption->resetAllSensors();
+
+            resources->textureOption.reset(new KisTextureProperties(painter->device()->defaultBounds()->currentLevelOfDetail()));
+            resources->textureOption->fillProperties(settings);
+
+            return resources;
+        };
+
+    m_dabExecutor.reset(
+        new KisDabRenderingExecutor(
+                    painter->device()->compositionSourceColorSpace(),
+                    resourcesFactory,
+                    painter->runnableStrokeJobsInterface(),
+                    &m_mirrorOption,
+                    &m_precisionOption));
+
+    m_dabUpdater.reset(new KisDabRenderingUpdater(m_dabExecutor.data()));
 }
 
 KisTangentNormalPaintOp::~KisTangentNormalPaintOp()
@@ -73,7 +109,7 @@ KisTangentNormalPaintOp::~KisTangentNormalPaintOp()
     //destroy things here//
 }
 
-KisSpacingInformation KisTangentNormalPaintOp::paintAt(const KisPaintInformation& info)
+KoColor KisTangentNormalPaintOp::tangentColor(const KisPaintInformation &info)
 {
     /*
      * For the color, the precision of tilt is only 60x60, and the precision of direction and rotation are 360 and 360*90.
@@ -118,7 +154,11 @@ KisSpacingInformation KisTangentNormalPaintOp::paintAt(const KisPaintInformation
 
     quint8 data[MAX_PIXEL_SIZE];
     rgbColorSpace->fromNormalisedChannelsValue(data, channelValues);
-    KoColor color(data, rgbColorSpace);//Should be default RGB(0.5,0.5,1.0)
+    return KoColor(data, rgbColorSpace);//Should be default RGB(0.5,0.5,1.0)
+}
+
+KisSpacingInformation KisTangentNormalPaintOp::paintAt(const KisPaintInformation& info)
+{
     //draw stuff here, return kisspacinginformation.
     KisBrushSP brush = m_brush;
 
@@ -138,37 +178,32 @@ KisSpacingInformation KisTangentNormalPaintOp::paintAt(const KisPaintInformation
                                   brush->maskWidth(shape, 0, 0, info),
                                   brush->maskHeight(shape, 0, 0, info));
 
-    m_maskDab =
-            m_dabCache->fetchDab(rgbColorSpace, color, cursorPos,
-                                 shape,
-                                 info, m_softnessOption.apply(info),
-                                 &m_dstDabRect);
+    const KoColor color = tangentColor(info);
 
-    if (m_dstDabRect.isEmpty()) return KisSpacingInformation(1.0);
+    m_opacityOption.setFlow(m_flowOption.apply(info));
 
-    QRect dabRect = m_maskDab->bounds();
+    quint8 dabOpacity = OPACITY_OPAQUE_U8;
+    quint8 dabFlow = OPACITY_OPAQUE_U8;
 
-    // sanity check
-    Q_ASSERT(m_dstDabRect.size() == dabRect.size());
-    Q_UNUSED(dabRect);
+    m_opacityOption.apply(info, &dabOpacity, &dabFlow);
 
-    quint8  oldOpacity = painter()->opacity();
-    QString oldCompositeOpId = painter()->compositeOp()->id();
+    KisDabCacheUtils::DabRequestInfo request(color,
+                                             cursorPos,
+                                             shape,
+                                             info,
+                                             m_softnessOption.apply(info));
 
+    m_dabExecutor->addDab(request, qreal(dabOpacity) / 255.0, qreal(dabFlow) / 255.0);
 
-    m_opacityOption.setFlow(m_flowOption.apply(info));
-    m_opacityOption.apply(painter(), info);
-    //paint with the default color? Copied this from color smudge.//
-    //painter()->setCompositeOp(COMPOSITE_COPY);
-    //painter()->fill(0, 0, m_dstDabRect.width(), m_dstDabRect.height(), color);
-    painter()->bltFixed(m_dstDabRect.topLeft(), m_maskDab, m_maskDab->bounds());
-    painter()->renderMirrorMaskSafe(m_dstDabRect, m_maskDab, !m_dabCache->needSeparateOriginal());
+    KisSpacingInformation spacingInfo = computeSpacing(info, scale, rotation);
+    m_dabUpdater->addDabSpacing(spacingInfo.scalarApprox());
 
-    // restore original opacity and composite mode values
-    painter()->setOpacity(oldOpacity);
-    painter()->setCompositeOp(oldCompositeOpId);
+    return spacingInfo;
+}
 
-    return computeSpacing(info, scale, rotation);
+std::pair<int, bool> KisTangentNormalPaintOp::doAsyncronousUpdate(QVector<KisRunnableStrokeJobData*> &jobs)
+{
+    return m_dabUpdater->doAsyncronousUpdate(painter(), jobs);
 }
 
 KisSpacingInformation KisTangentNormalPaintOp::updateSpacingImpl(const KisPaintInformation &info) const
@@ -201,45 +236,7 @@ void KisTangentNormalPaintOp::paintLine(const KisPaintInformation& pi1, const Ki
         }
 
         KisPainter p(m_lineCacheDevice);
-        KoColor currentColor = painter()->paintColor();
-        QString currentSpace = currentColor.colorSpace()->colorModelId().id();
-        const KoColorSpace* rgbColorSpace = KoColorSpaceRegistry::instance()->rgb8();
-        if (currentSpace != "RGBA") {
-            rgbColorSpace = KoColorSpaceRegistry::instance()->rgb8();
-        } else {
-            rgbColorSpace = currentColor.colorSpace();
-        }
-        QVector <float> channelValues(4);
-        qreal r, g, b;
-
-        if (currentColor.colorSpace()->colorDepthId().id()=="F16" || currentColor.colorSpace()->colorDepthId().id()=="F32"){
-            channelValues[0] = 0.5;//red
-            channelValues[1] = 0.5;//green
-            channelValues[2] = 1.0;//blue
-            channelValues[3] = 1.0;//alpha, leave alone.
-
-
-            m_tangentTiltOption.apply(pi2, &r, &g, &b);
-
-            channelValues[0] = r;//red
-            channelValues[1] = g;//green
-            channelValues[2] = b;//blue
-        } else {
-            channelValues[0] = 1.0;//blue
-            channelValues[1] = 0.5;//green
-            channelValues[2] = 0.5;//red
-            channelValues[3] = 1.0;//alpha, leave alone.
-
-            m_tangentTiltOption.apply(pi2, &r, &g, &b);
-
-            channelValues[0] = b;//blue
-            channelValues[1] = g;//green
-            channelValues[2] = r;//red
-        }
-
-        quint8 data[4];
-        rgbColorSpace->fromNormalisedChannelsValue(data, channelValues);
-        KoColor color(data, rgbColorSpace);
+        KoColor color = tangentColor(pi2);
         p.setPaintColor(color);
         p.drawDDALine(pi1.pos(), pi2.pos());
 
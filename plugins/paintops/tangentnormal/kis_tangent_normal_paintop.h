@@ -38,6 +38,10 @@
 
 class KisBrushBasedPaintOpSettings;
 class KisPainter;
+class KoColor;
+class KisDabRenderingExecutor;
+class KisDabRenderingUpdater;
+class KisRunnableStrokeJobData;
 
 class KisTangentNormalPaintOp: public KisBrushBasedPaintOp
 {
@@ -50,6 +54,8 @@ public:
 
     void paintLine(const KisPaintInformation &pi1, const KisPaintInformation &pi2, KisDistanceInformation *currentDistance) override;
 
+    std::pair<int, bool> doAsyncronousUpdate(QVector<KisRunnableStrokeJobData *> &jobs) override;
+
 protected:
     /*paint the dabs*/
     KisSpacingInformation paintAt(const KisPaintInformation& info) override;
@@ -59,6 +65,9 @@ protected:
     KisTimingInformation updateTimingImpl(const KisPaintInformation &info) const override;
 
 private:
+    /* the normal map color encoding the tilt of the stylus */
+    KoColor tangentColor(const KisPaintInformation &info);
+
     KisSpacingInformation computeSpacing(const KisPaintInformation &info, qreal scale,
                                          qreal rotation) const;
 
@@ -76,9 +85,10 @@ private:
     KisPressureSharpnessOption m_sharpnessOption;
     KisPressureFlowOption m_flowOption;
 
-    KisFixedPaintDeviceSP m_maskDab;
     KisPaintDeviceSP m_tempDev;
-    QRect m_dstDabRect;
+
+    QScopedPointer<KisDabRenderingExecutor> m_dabExecutor;
+    QScopedPointer<KisDabRenderingUpdater> m_dabUpdater;
 
     KisPaintDeviceSP m_lineCacheDevice;
 };